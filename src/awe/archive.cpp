@@ -25,4 +25,19 @@ namespace AWE {
 Archive::~Archive() {
 }
 
+Common::ReadStream *Archive::getResourceByIndex(size_t index) const {
+	return getResource(getResourcePath(index));
+}
+
+std::optional<Archive::ResourceRange> Archive::getResourceRange(size_t /*index*/) const {
+	return std::nullopt;
+}
+
+void Archive::prefetch(const ResourceRange &/*range*/) const {
+}
+
+bool Archive::isMemoryBacked() const {
+	return false;
+}
+
 }
@@ -22,6 +22,7 @@
 #define AWE_ARCHIVE_H
 
 #include <vector>
+#include <optional>
 
 #include "src/common/readstream.h"
 
@@ -37,6 +38,14 @@ namespace AWE {
  */
 class Archive : Common::Noncopyable {
 public:
+	/*!
+	 * \brief Location of the data of a resource in the underlying storage
+	 */
+	struct ResourceRange {
+		size_t offset;
+		size_t size;
+	};
+
 	virtual ~Archive();
 
 	/*!
@@ -71,6 +80,47 @@ public:
 	 */
 	[[nodiscard]] virtual Common::ReadStream *getResource(const std::string &rid) const = 0;
 
+	/*!
+	 * Get a resource using its index in the archive. The default
+	 * implementation resolves the path of the resource and looks
+	 * it up again, archives should override it if they can access
+	 * their entries directly.
+	 *
+	 * \param index The index in the archive
+	 * \return The found resource or NULL if the resource
+	 * is not available
+	 */
+	[[nodiscard]] virtual Common::ReadStream *getResourceByIndex(size_t index) const;
+
+	/*!
+	 * Get the location of a resource in the underlying storage of the
+	 * archive. This is used to order and merge reads of multiple
+	 * resources. The default implementation returns nothing, for
+	 * archives which have no meaningful storage order.
+	 *
+	 * \param index The index in the archive
+	 * \return The range of the resource data or nothing
+	 */
+	[[nodiscard]] virtual std::optional<ResourceRange> getResourceRange(size_t index) const;
+
+	/*!
+	 * Hint that a range of the underlying storage, as returned by
+	 * getResourceRange, will be read soon. The default implementation
+	 * does nothing.
+	 *
+	 * \param range The range to load ahead of time
+	 */
+	virtual void prefetch(const ResourceRange &range) const;
+
+	/*!
+	 * Check if the resources of this archive are handed out as views into
+	 * memory, without decompressing or copying them. Such resources are
+	 * not worth caching. The default implementation returns false.
+	 *
+	 * \return If resources are accessed without copying them
+	 */
+	[[nodiscard]] virtual bool isMemoryBacked() const;
+
 	/*!
 	 * Check if a resource given by a path exists.
 	 *
@@ -0,0 +1,243 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bit>
+#include <cstring>
+
+#include "src/common/exception.h"
+#include "src/common/fnv1a.h"
+#include "src/common/lz4.h"
+#include "src/common/memreadstream.h"
+#include "src/common/strutil.h"
+
+#include "src/awe/awepackarchive.h"
+
+namespace AWE {
+
+const uint32_t AWEPackArchive::kMagic = MKTAG('A', 'W', 'E', 'P');
+const uint32_t AWEPackArchive::kVersion = 1;
+
+AWEPackArchive::AWEPackArchive(Common::ReadStream *pack) : _pack(pack), _hasCompressedEntries(false) {
+	if constexpr (std::endian::native != std::endian::little)
+		throw CreateException("OpenAWE pack files are only supported on little endian systems");
+
+	Header header{};
+	if (_pack->readAt(0, &header, sizeof(Header)) != sizeof(Header))
+		throw CreateException("Pack file is too small for its header");
+
+	if (header.magic != kMagic)
+		throw CreateException("Invalid pack magic id, expected 0x{:X}, found 0x{:X}", kMagic, header.magic);
+	if (header.version != kVersion)
+		throw CreateException("Invalid pack version, only {} is supported, found {}", kVersion, header.version);
+
+	if (header.tablesOffset + header.tablesSize > _pack->size())
+		throw CreateException("Pack tables exceed the pack file");
+
+	_memoryBacked = _pack->size() == 0 || !_pack->getView(0, 1).empty();
+
+	std::span<const byte> tables = _pack->getView(header.tablesOffset, header.tablesSize);
+	if (tables.empty() && header.tablesSize > 0) {
+		_tables.resize(header.tablesSize);
+		readPack(header.tablesOffset, _tables.data(), _tables.size());
+		tables = _tables;
+	}
+
+	assignTables(header, tables);
+}
+
+void AWEPackArchive::assignTables(const Header &header, std::span<const byte> tables) {
+	const size_t entriesSize = static_cast<size_t>(header.numEntries) * sizeof(Entry);
+	const size_t indexSize = static_cast<size_t>(header.indexSize) * sizeof(IndexEntry);
+
+	if (entriesSize + indexSize + header.namesSize != tables.size())
+		throw CreateException("Pack table sizes do not match the table data");
+	if (!std::has_single_bit(header.indexSize) || header.indexSize <= header.numEntries)
+		throw CreateException("Invalid pack path index size {}", header.indexSize);
+	if (reinterpret_cast<uintptr_t>(tables.data()) % alignof(Entry) != 0)
+		throw CreateException("Pack tables are not aligned");
+
+	_entries = {reinterpret_cast<const Entry *>(tables.data()), header.numEntries};
+	_index = {reinterpret_cast<const IndexEntry *>(tables.data() + entriesSize), header.indexSize};
+	_names = {reinterpret_cast<const char *>(tables.data() + entriesSize + indexSize), header.namesSize};
+
+	for (const auto &entry : _entries) {
+		if (static_cast<size_t>(entry.nameOffset) + entry.nameSize > _names.size())
+			throw CreateException("Pack entry name exceeds the name table");
+		if (entry.offset + entry.size > header.tablesOffset)
+			throw CreateException("Pack entry data exceeds the data area");
+
+		switch (entry.compression) {
+			case kCompressionNone:
+				if (entry.size != entry.uncompressedSize)
+					throw CreateException("Uncompressed pack entry has mismatching sizes");
+				break;
+			case kCompressionLZ4:
+				_hasCompressedEntries = true;
+				break;
+			default:
+				throw CreateException("Unknown pack entry compression {}", entry.compression);
+		}
+	}
+
+	bool hasFreeSlot = false;
+	for (const auto &indexEntry : _index) {
+		if (indexEntry.entryIndex == kInvalidIndex)
+			hasFreeSlot = true;
+		else if (indexEntry.entryIndex >= _entries.size())
+			throw CreateException("Pack path index references invalid entry {}", indexEntry.entryIndex);
+	}
+
+	// Lookups stop probing at the first free slot, so a full index is corrupt
+	if (!_index.empty() && !hasFreeSlot)
+		throw CreateException("Pack path index has no free slot");
+}
+
+size_t AWEPackArchive::getNumResources() const {
+	return _entries.size();
+}
+
+std::vector<size_t> AWEPackArchive::getDirectoryResources(const std::string &directory) {
+	std::string prefix = Common::toLower(directory);
+	if (!prefix.empty() && prefix.back() != '/')
+		prefix += '/';
+
+	std::vector<size_t> indices;
+	for (size_t i = 0; i < _entries.size(); ++i) {
+		const auto name = getName(_entries[i]);
+		if (name.starts_with(prefix) && name.find('/', prefix.size()) == std::string_view::npos)
+			indices.emplace_back(i);
+	}
+
+	return indices;
+}
+
+std::string AWEPackArchive::getResourcePath(size_t index) const {
+	if (index >= getNumResources())
+		throw CreateException("Index {} exceeds number of entries {}", index, getNumResources());
+
+	return std::string(getName(_entries[index]));
+}
+
+Common::ReadStream *AWEPackArchive::getResource(const std::string &rid) const {
+	const auto index = findResource(rid);
+	if (!index)
+		return nullptr;
+
+	return getResourceByIndex(*index);
+}
+
+Common::ReadStream *AWEPackArchive::getResourceByIndex(size_t index) const {
+	if (index >= getNumResources())
+		return nullptr;
+
+	const Entry &entry = _entries[index];
+
+	std::span<const byte> stored = _pack->getView(entry.offset, entry.size);
+	std::unique_ptr<byte[]> storedData;
+	if (stored.empty() && entry.size > 0) {
+		storedData = std::make_unique<byte[]>(entry.size);
+		readPack(entry.offset, storedData.get(), entry.size);
+		stored = {storedData.get(), entry.size};
+	}
+
+	if (entry.compression == kCompressionNone) {
+		if (storedData)
+			return new Common::MemoryReadStream(storedData.release(), entry.size, true);
+
+		return new Common::MemoryReadStream(stored.data(), stored.size());
+	}
+
+	auto data = std::make_unique<byte[]>(entry.uncompressedSize);
+	Common::decompressLZ4(stored, {data.get(), entry.uncompressedSize});
+	return new Common::MemoryReadStream(data.release(), entry.uncompressedSize, true);
+}
+
+std::optional<Archive::ResourceRange> AWEPackArchive::getResourceRange(size_t index) const {
+	if (index >= getNumResources())
+		return std::nullopt;
+
+	const Entry &entry = _entries[index];
+	return ResourceRange{entry.offset, entry.size};
+}
+
+void AWEPackArchive::prefetch(const ResourceRange &range) const {
+	_pack->prefetch(range.offset, range.size);
+}
+
+bool AWEPackArchive::isMemoryBacked() const {
+	return _memoryBacked && !_hasCompressedEntries;
+}
+
+bool AWEPackArchive::hasResource(const std::string &rid) const {
+	return findResource(rid).has_value();
+}
+
+bool AWEPackArchive::hasDirectory(const std::string &directory) const {
+	std::string prefix = Common::toLower(directory);
+	if (!prefix.empty() && prefix.back() != '/')
+		prefix += '/';
+
+	for (const auto &entry : _entries) {
+		if (getName(entry).starts_with(prefix))
+			return true;
+	}
+
+	return false;
+}
+
+std::optional<size_t> AWEPackArchive::findResource(std::string_view rid) const {
+	if (_index.empty())
+		return {};
+
+	const uint64_t hash = Common::fnv1a64(rid);
+	const size_t mask = _index.size() - 1;
+
+	size_t i = hash & mask;
+	for (size_t probe = 0; probe < _index.size(); ++probe, i = (i + 1) & mask) {
+		const auto &indexEntry = _index[i];
+
+		if (indexEntry.entryIndex == kInvalidIndex)
+			return {};
+
+		if (indexEntry.pathHash == hash && getName(_entries[indexEntry.entryIndex]) == rid)
+			return indexEntry.entryIndex;
+	}
+
+	return {};
+}
+
+std::string_view AWEPackArchive::getName(const Entry &entry) const {
+	return _names.substr(entry.nameOffset, entry.nameSize);
+}
+
+void AWEPackArchive::readPack(size_t offset, byte *data, size_t length) const {
+	size_t readSize;
+	if (_pack->isConcurrent()) {
+		readSize = _pack->readAt(offset, data, length);
+	} else {
+		std::lock_guard<std::mutex> g(_readMutex);
+		readSize = _pack->readAt(offset, data, length);
+	}
+
+	if (readSize != length)
+		throw CreateException("Unexpected end of pack file at offset {}", offset);
+}
+
+} // End of namespace AWE
@@ -0,0 +1,210 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AWE_AWEPACKARCHIVE_H
+#define AWE_AWEPACKARCHIVE_H
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "src/awe/archive.h"
+
+namespace AWE {
+
+/*!
+ * \brief Loader for OpenAWE pack files
+ *
+ * OpenAWE pack files are created by the repack tool from the original
+ * archives of the games. Every resource is stored page aligned either
+ * uncompressed or compressed as a single lz4 block, in the order in which
+ * the resources are usually loaded, so that loading them results in mostly
+ * sequential reads. The tables are stored behind the data in a flat layout
+ * together with a precomputed hash index of the paths, so that they can be
+ * used directly from a memory mapped file without any parsing.
+ *
+ * All values are stored in little endian byte order.
+ */
+class AWEPackArchive : public Archive {
+public:
+	enum Compression : uint32_t {
+		kCompressionNone = 0,
+		kCompressionLZ4 = 1
+	};
+
+	/*
+	 * The following structures are stored as is in the pack file, so they
+	 * have to stay trivially copyable.
+	 */
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t pageSize;
+		uint32_t numEntries;
+		uint64_t tablesOffset;
+		uint64_t tablesSize;
+		uint32_t indexSize;
+		uint32_t namesSize;
+	};
+
+	struct Entry {
+		uint64_t offset;
+		uint64_t size;
+		uint64_t uncompressedSize;
+		uint32_t nameOffset;
+		uint32_t nameSize;
+		uint32_t compression;
+		uint32_t padding;
+	};
+
+	/*!
+	 * Entry of the path index, which maps the FNV-1a hash of the full lower
+	 * case path of a resource to its entry. The number of index entries is a
+	 * power of two and collisions are resolved by linear probing.
+	 */
+	struct IndexEntry {
+		uint64_t pathHash;
+		uint32_t entryIndex;
+		uint32_t padding;
+	};
+
+	static const uint32_t kMagic;
+	static const uint32_t kVersion;
+	static const uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+	/*!
+	 * Load a pack file from the given stream. The stream is stored in the
+	 * archive. If it is backed by memory, like a memory mapped file, the
+	 * tables and uncompressed resources are used directly without copying.
+	 *
+	 * \param pack the stream of the pack file
+	 */
+	explicit AWEPackArchive(Common::ReadStream *pack);
+
+	size_t getNumResources() const override;
+
+	/*!
+	 * Get the indices of all resources directly contained in a directory.
+	 * The pack has no directory tables, so this checks all paths.
+	 *
+	 * \param directory The directory to get the resources for
+	 * \return The indices of the resources in this directory
+	 */
+	std::vector<size_t> getDirectoryResources(const std::string &directory) override;
+
+	std::string getResourcePath(size_t index) const override;
+
+	/*!
+	 * Get a resource by looking up its path in the path index. Uncompressed
+	 * resources of a memory backed pack are views into it and must not
+	 * outlive the archive. This method can be called from multiple threads
+	 * at once.
+	 *
+	 * \param rid The lower case path of the resource
+	 * \return The stream of the resource or a null pointer if it does not exist
+	 */
+	[[nodiscard]] Common::ReadStream *getResource(const std::string &rid) const override;
+
+	/*!
+	 * Get a resource directly by its entry index. The same restrictions as
+	 * for getResource apply to the returned stream.
+	 *
+	 * \param index The index of the entry
+	 * \return The stream of the resource or a null pointer if it does not exist
+	 */
+	[[nodiscard]] Common::ReadStream *getResourceByIndex(size_t index) const override;
+
+	/*!
+	 * Get the range of the stored data of a resource in the pack file
+	 *
+	 * \param index The index of the resource
+	 * \return The offset and stored size of the resource
+	 */
+	[[nodiscard]] std::optional<ResourceRange> getResourceRange(size_t index) const override;
+
+	void prefetch(const ResourceRange &range) const override;
+
+	/*!
+	 * Check if the pack is held in memory and contains no compressed
+	 * resources, so that all resources are handed out as views into it
+	 *
+	 * \return If all resources are views into the pack
+	 */
+	[[nodiscard]] bool isMemoryBacked() const override;
+
+	[[nodiscard]] bool hasResource(const std::string &rid) const override;
+
+	/*!
+	 * Check if any resource is contained in a directory or one of its sub
+	 * directories. The pack has no directory tables, so this checks all paths.
+	 *
+	 * \param directory The directory to check
+	 * \return If the directory exists
+	 */
+	[[nodiscard]] bool hasDirectory(const std::string &directory) const override;
+
+	/*!
+	 * Find the index of a resource using the path index of the pack
+	 *
+	 * \param rid The lower case path of the resource
+	 * \return The index of the resource, if it exists
+	 */
+	[[nodiscard]] std::optional<size_t> findResource(std::string_view rid) const;
+
+private:
+	/*!
+	 * Check the tables of the pack for consistency and point the table views
+	 * of this archive to them
+	 *
+	 * \param header The header of the pack
+	 * \param tables The table data, which has to outlive the archive
+	 */
+	void assignTables(const Header &header, std::span<const byte> tables);
+
+	/*!
+	 * Get the path of an entry from the name table
+	 */
+	std::string_view getName(const Entry &entry) const;
+
+	/*!
+	 * Read stored data of the pack at an absolute offset. If the pack stream
+	 * does not support concurrent reads, the read is serialized.
+	 */
+	void readPack(size_t offset, byte *data, size_t length) const;
+
+	std::unique_ptr<Common::ReadStream> _pack;
+	mutable std::mutex _readMutex;
+
+	bool _memoryBacked;
+	bool _hasCompressedEntries;
+
+	std::vector<byte> _tables;
+
+	std::span<const Entry> _entries;
+	std::span<const IndexEntry> _index;
+	std::string_view _names;
+};
+
+} // End of namespace AWE
+
+#endif //AWE_AWEPACKARCHIVE_H
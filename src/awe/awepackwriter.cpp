@@ -0,0 +1,154 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <bit>
+
+#include "src/common/exception.h"
+#include "src/common/fnv1a.h"
+#include "src/common/lz4.h"
+#include "src/common/strutil.h"
+
+#include "src/awe/awepackwriter.h"
+
+namespace AWE {
+
+AWEPackWriter::AWEPackWriter(const std::string &file, uint32_t pageSize) :
+	_out(file, std::ios::out | std::ios::binary | std::ios::trunc),
+	_file(file),
+	_pageSize(pageSize),
+	_position(0),
+	_finished(false) {
+	if constexpr (std::endian::native != std::endian::little)
+		throw CreateException("OpenAWE pack files can only be written on little endian systems");
+	if (!std::has_single_bit(pageSize) || pageSize < sizeof(AWEPackArchive::Header))
+		throw CreateException("Invalid pack page size {}", pageSize);
+	if (!_out)
+		throw CreateException("Failed to create pack file {}", file);
+
+	// Reserve the first page for the header, which is written when finishing
+	const std::vector<char> headerPage(_pageSize, 0);
+	_out.write(headerPage.data(), static_cast<std::streamsize>(headerPage.size()));
+	_position = _pageSize;
+}
+
+void AWEPackWriter::add(const std::string &path, std::span<const byte> data, bool compress) {
+	if (_finished)
+		throw CreateException("Pack file {} is already finished", _file);
+
+	const std::string name = Common::toLower(path);
+	if (!_paths.emplace(name).second)
+		throw CreateException("Resource {} was already added to the pack", name);
+
+	AWEPackArchive::Entry entry{};
+	entry.nameOffset = static_cast<uint32_t>(_names.size());
+	entry.nameSize = static_cast<uint32_t>(name.size());
+	entry.uncompressedSize = data.size();
+	entry.compression = AWEPackArchive::kCompressionNone;
+
+	std::span<const byte> stored = data;
+	if (compress && !data.empty()) {
+		_compressed.resize(Common::getLZ4CompressBound(data.size()));
+		const size_t compressedSize = Common::compressLZ4(data, _compressed);
+		if (compressedSize > 0 && compressedSize < data.size()) {
+			stored = std::span<const byte>(_compressed).first(compressedSize);
+			entry.compression = AWEPackArchive::kCompressionLZ4;
+		}
+	}
+
+	pad(_pageSize);
+	entry.offset = _position;
+	entry.size = stored.size();
+
+	_out.write(reinterpret_cast<const char *>(stored.data()), static_cast<std::streamsize>(stored.size()));
+	_position += stored.size();
+	if (!_out)
+		throw CreateException("Failed to write resource {} to pack file {}", name, _file);
+
+	_names += name;
+	_entries.emplace_back(entry);
+}
+
+void AWEPackWriter::finish() {
+	if (_finished)
+		return;
+
+	// Keep the index at most half full, so that probe sequences stay short
+	const size_t indexSize = std::bit_ceil(std::max<size_t>(_entries.size() * 2, 2));
+	std::vector<AWEPackArchive::IndexEntry> index(indexSize, {0, AWEPackArchive::kInvalidIndex, 0});
+	for (size_t i = 0; i < _entries.size(); ++i) {
+		const auto &entry = _entries[i];
+		const uint64_t hash = Common::fnv1a64(std::string_view(_names).substr(entry.nameOffset, entry.nameSize));
+
+		size_t slot = hash & (indexSize - 1);
+		while (index[slot].entryIndex != AWEPackArchive::kInvalidIndex)
+			slot = (slot + 1) & (indexSize - 1);
+
+		index[slot].pathHash = hash;
+		index[slot].entryIndex = static_cast<uint32_t>(i);
+	}
+
+	pad(_pageSize);
+
+	AWEPackArchive::Header header{};
+	header.magic = AWEPackArchive::kMagic;
+	header.version = AWEPackArchive::kVersion;
+	header.pageSize = _pageSize;
+	header.numEntries = static_cast<uint32_t>(_entries.size());
+	header.tablesOffset = _position;
+	header.indexSize = static_cast<uint32_t>(indexSize);
+	header.namesSize = static_cast<uint32_t>(_names.size());
+
+	const size_t entriesSize = _entries.size() * sizeof(AWEPackArchive::Entry);
+	const size_t indexBytes = index.size() * sizeof(AWEPackArchive::IndexEntry);
+	header.tablesSize = entriesSize + indexBytes + _names.size();
+
+	_out.write(reinterpret_cast<const char *>(_entries.data()), static_cast<std::streamsize>(entriesSize));
+	_out.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(indexBytes));
+	_out.write(_names.data(), static_cast<std::streamsize>(_names.size()));
+	_position += header.tablesSize;
+
+	_out.seekp(0);
+	_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	_out.close();
+
+	if (!_out)
+		throw CreateException("Failed to write the tables of pack file {}", _file);
+
+	_finished = true;
+}
+
+size_t AWEPackWriter::getSize() const {
+	return _position;
+}
+
+void AWEPackWriter::pad(size_t alignment) {
+	static const char kZeros[256] = {};
+
+	size_t padding = (alignment - _position % alignment) % alignment;
+	while (padding > 0) {
+		const size_t size = std::min(padding, sizeof(kZeros));
+		_out.write(kZeros, static_cast<std::streamsize>(size));
+		_position += size;
+		padding -= size;
+	}
+}
+
+} // End of namespace AWE
@@ -0,0 +1,96 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AWE_AWEPACKWRITER_H
+#define AWE_AWEPACKWRITER_H
+
+#include <fstream>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "src/awe/awepackarchive.h"
+
+namespace AWE {
+
+/*!
+ * \brief Writer for OpenAWE pack files
+ *
+ * This class writes the pack files read by AWEPackArchive. Resources are
+ * written in the order in which they are added, each one starting at a page
+ * boundary. The tables and the path index are written behind the data, when
+ * the pack is finished.
+ */
+class AWEPackWriter : Common::Noncopyable {
+public:
+	/*!
+	 * Create a new pack file
+	 *
+	 * \param file The path of the pack file to create
+	 * \param pageSize The alignment of every resource, has to be a power of two
+	 */
+	explicit AWEPackWriter(const std::string &file, uint32_t pageSize = 4096);
+
+	/*!
+	 * Add a resource to the pack. If compression is requested, the resource
+	 * is compressed as lz4 block and only stored compressed if that makes it
+	 * smaller. Every path can only be added once.
+	 *
+	 * \param path The path of the resource, which is stored in lower case
+	 * \param data The data of the resource
+	 * \param compress If the resource should be compressed
+	 */
+	void add(const std::string &path, std::span<const byte> data, bool compress);
+
+	/*!
+	 * Write the tables and the header and close the pack file. No resources
+	 * can be added afterwards.
+	 */
+	void finish();
+
+	/*!
+	 * Get the number of bytes written to the pack file so far
+	 *
+	 * \return The size of the pack file
+	 */
+	size_t getSize() const;
+
+private:
+	/*!
+	 * Write zeros up to the next multiple of the given alignment
+	 */
+	void pad(size_t alignment);
+
+	std::ofstream _out;
+	const std::string _file;
+	const uint32_t _pageSize;
+	size_t _position;
+	bool _finished;
+
+	std::vector<AWEPackArchive::Entry> _entries;
+	std::string _names;
+	std::unordered_set<std::string> _paths;
+	std::vector<byte> _compressed;
+};
+
+} // End of namespace AWE
+
+#endif //AWE_AWEPACKWRITER_H
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 
 #include <src/common/memreadstream.h>
 #include "src/common/zlib.h"
@@ -44,19 +45,23 @@ size_t BINArchive::getNumResources() const {
 	return _fileEntries.size();
 }
 
+size_t BINArchive::getDataSize() const {
+	return _size;
+}
+
 Common::ReadStream *BINArchive::getResource(const std::string &rid) const {
-	for (const auto &entry : _fileEntries) {
-		if (entry.name == rid) {
-			byte *data = new byte[entry.size];
+	const auto index = _fileIndices.find(rid);
+	if (index == _fileIndices.end())
+		return nullptr;
 
-			_data->seek(entry.offset);
-			_data->read(data, entry.size);
+	const auto &entry = _fileEntries[index->second];
 
-			return new Common::MemoryReadStream(data, entry.size);
-		}
-	}
+	inflateUntil(static_cast<size_t>(entry.offset) + entry.size);
 
-	return nullptr;
+	byte *data = new byte[entry.size];
+	std::memcpy(data, _data.get() + entry.offset, entry.size);
+
+	return new Common::MemoryReadStream(data, entry.size);
 }
 
 void BINArchive::load(Common::ReadStream &bin) {
@@ -67,8 +72,11 @@ void BINArchive::load(Common::ReadStream &bin) {
 	const uint32_t numFiles = bin.readUint32LE();
 
 	_fileEntries.resize(numFiles);
+	_fileIndices.reserve(numFiles);
 	uint32_t offset = 0;
-	for (auto &entry : _fileEntries) {
+	for (size_t i = 0; i < _fileEntries.size(); ++i) {
+		auto &entry = _fileEntries[i];
+
 		const uint32_t nameLength = bin.readUint32LE();
 		entry.name.resize(nameLength);
 		bin.read(entry.name.data(), nameLength);
@@ -77,31 +85,45 @@ void BINArchive::load(Common::ReadStream &bin) {
 		entry.offset = offset;
 
 		offset += entry.size;
+
+		// If names occur multiple times, the first entry is used
+		_fileIndices.emplace(entry.name, i);
 	}
 
 	size_t compressedSize = fileSize - bin.pos();
-	size_t decompressedSize = offset;
 
-	byte *data = new byte[compressedSize];
-	bin.read(data, compressedSize);
+	// The compressed data is kept until everything is inflated, since the source stream might not outlive the archive
+	_compressedData.reset(new byte[compressedSize]);
+	bin.read(_compressedData.get(), compressedSize);
 
-	_data.reset(Common::decompressZLIB(
-			data,
+	_size = offset;
+	_inflatedSize = 0;
+	_data.reset(new byte[_size]);
+	_inflater = std::make_unique<Common::ZLIBInflater>(
+			_compressedData.get(),
 			compressedSize,
-			decompressedSize
-	));
+			_data.get(),
+			_size
+	);
+}
+
+void BINArchive::inflateUntil(size_t offset) const {
+	std::lock_guard<std::mutex> l(_inflateMutex);
+	if (offset <= _inflatedSize)
+		return;
 
-	delete[] data;
+	// Inflate a bit more than needed to not restart inflating for every small entry
+	static constexpr size_t kMinInflateSize = 65536;
+	_inflatedSize = _inflater->inflateUntil(std::max(offset, _inflatedSize + kMinInflateSize));
+
+	if (_inflatedSize == _size) {
+		_inflater.reset();
+		_compressedData.reset();
+	}
 }
 
 bool BINArchive::hasResource(const std::string &rid) const {
-	return std::find_if(
-			_fileEntries.begin(),
-			_fileEntries.end(),
-			[&](auto entry) -> bool {
-				return entry.name == rid;
-			}
-	) != _fileEntries.end();
+	return _fileIndices.contains(rid);
 }
 
 bool BINArchive::hasDirectory(const std::string &directory) const {
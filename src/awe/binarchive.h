@@ -23,10 +23,13 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "archive.h"
 
 #include "src/common/readstream.h"
+#include "src/common/zlib.h"
 
 namespace AWE {
 
@@ -38,6 +41,11 @@ namespace AWE {
  * specifies the size of the file without an offset. The data
  * is stored inside a following chunk which is compressed
  * through zlibs deflate algorithm.
+ *
+ * Since the entries are stored one after another in a single zlib
+ * stream, the data is only inflated as far as it is needed by the
+ * entries requested so far. When everything is inflated, the
+ * compressed data is released.
  */
 class BINArchive : public Archive {
 public:
@@ -56,6 +64,13 @@ public:
 
 	size_t getNumResources() const override;
 
+	/*!
+	 * Get the size of the data of all entries, when it is completely inflated
+	 *
+	 * \return The size of the inflated data in bytes
+	 */
+	size_t getDataSize() const;
+
 	std::vector<size_t> getDirectoryResources(const std::string &directory) override;
 
 	std::string getResourcePath(size_t index) const override;
@@ -65,14 +80,28 @@ public:
 private:
 	void load(Common::ReadStream &bin);
 
+	/*!
+	 * Inflate the archive data at least up to a certain offset
+	 *
+	 * \param offset The offset up to which the data is needed
+	 */
+	void inflateUntil(size_t offset) const;
+
 	struct FileEntry {
 		std::string name;
 		uint32_t size, offset;
 	};
 
 	std::vector<FileEntry> _fileEntries;
+	std::unordered_map<std::string, size_t> _fileIndices;
+
+	size_t _size;
+	std::unique_ptr<byte[]> _data;
 
-	std::unique_ptr<Common::ReadStream> _data;
+	mutable std::mutex _inflateMutex;
+	mutable size_t _inflatedSize;
+	mutable std::unique_ptr<byte[]> _compressedData;
+	mutable std::unique_ptr<Common::ZLIBInflater> _inflater;
 };
 
 } // End of namespace AWE
@@ -120,8 +120,8 @@ void BINMSHFile::load(Common::ReadStream &binmsh) {
 		}
 
 		const uint32_t shaderNameLength = binmsh.readUint32LE();
-		const std::string shaderName = Common::toLower(binmsh.readFixedSizeString(shaderNameLength, true));
-		material.shader = std::regex_replace(shaderName, std::regex("\\.rfx"), "");
+		material.shader = Common::toLower(binmsh.readFixedSizeString(shaderNameLength, true));
+		Common::replaceInPlace(material.shader, ".rfx", "");
 
 		material.properties = binmsh.readUint32LE() | globalProperties;
 		material.blendMode  = BlendMode(binmsh.readUint32LE());
@@ -33,16 +33,10 @@ COLLISIONSFile::COLLISIONSFile(Common::ReadStream &collisions) {
 	uint32_t numIndices = collisions.readUint32LE();
 
 	_positions.resize(numVertices);
-	for (auto &position : _positions) {
-		position.x = collisions.readIEEEFloatLE();
-		position.y = collisions.readIEEEFloatLE();
-		position.z = collisions.readIEEEFloatLE();
-	}
+	collisions.readArrayLE(std::span(_positions));
 
 	_indices.resize(numIndices);
-	for (auto &index : _indices) {
-		index = collisions.readUint16LE();
-	}
+	collisions.readArrayLE(std::span(_indices));
 
 	// TODO: There is more data here
 }
@@ -107,9 +107,7 @@ std::vector<uint32_t> DPFile::getValues(uint32_t offset, unsigned int count) {
 		return values;*/
 
 	_dp->seek(-static_cast<int>(_dataSize) + relativeOffset, Common::ReadStream::END);
-	for (auto &value : values) {
-		value = _dp->readUint32LE();
-	}
+	_dp->readArrayLE(std::span(values));
 
 	return values;
 }
@@ -126,9 +124,7 @@ std::vector<float> DPFile::getFloats(uint32_t offset, unsigned int count) {
 		return values;
 
 	_dp->seek(-static_cast<int>(_dataSize) + relativeOffset, Common::ReadStream::END);
-	for (auto &value : values) {
-		value = _dp->readIEEEFloatLE();
-	}
+	_dp->readArrayLE(std::span(values));
 
 	return values;
 }
@@ -142,10 +138,7 @@ std::vector<glm::vec2> DPFile::getPositions2D(uint32_t offset, unsigned int coun
 		relativeOffset += 4;
 
 	_dp->seek(-static_cast<int>(_dataSize) + relativeOffset, Common::ReadStream::END);
-	for (auto &position : positions) {
-		position.x = _dp->readIEEEFloatLE();
-		position.y = _dp->readIEEEFloatLE();
-	}
+	_dp->readArrayLE(std::span(positions));
 
 	return positions;
 }
@@ -19,9 +19,9 @@
  */
 
 #include <stdexcept>
-#include <regex>
 
 #include "src/common/exception.h"
+#include "src/common/strutil.h"
 
 #include "src/awe/foliagedatafile.h"
 
@@ -39,8 +39,8 @@ FoliageDataFile::FoliageDataFile(Common::ReadStream &foliageData) {
 		foliage = foliageData.readFixedSizeString(pathLength, true);
 
 		// normalize foliage path
-		foliage = std::regex_replace(foliage, std::regex("\\\\"), "/");
-		foliage = std::regex_replace(foliage, std::regex("data/"), "");
+		Common::foldSlashes(foliage);
+		Common::replaceInPlace(foliage, "data/", "");
 	}
 
 	const uint32_t numInstances = foliageData.readUint32LE();
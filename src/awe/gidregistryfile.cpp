@@ -18,7 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <regex>
+#include <string_view>
+#include <charconv>
 
 #include "src/common/strutil.h"
 #include "src/common/endianness.h"
@@ -28,18 +29,32 @@
 namespace AWE {
 
 GIDRegistryFile::GIDRegistryFile(Common::ReadStream &gid) {
-	const std::regex comma(",");
-
 	while (!gid.eos()) {
-		std::string line = gid.readLine();
+		const std::string line = gid.readLine();
+		if (line.empty())
+			continue;
+
+		// Every line consists of the type, the hexadecimal id and the string, separated by commas
+		std::string_view fields[3];
+		size_t numFields = 0;
+		for (const auto field : Common::Tokenizer(line, ',')) {
+			if (numFields == 3)
+				break;
+			fields[numFields++] = field;
+		}
+
+		if (numFields != 3)
+			throw Common::Exception("Invalid gid registry line \"{}\"", line);
 
-		std::vector<std::string> split = Common::split(line, comma);
 		GID newGid;
-		newGid.type = std::stoi(split[0]);
-		newGid.id = std::stoul(Common::toLower(split[1]), nullptr, 16);
+		const auto typeResult = std::from_chars(fields[0].data(), fields[0].data() + fields[0].size(), newGid.type);
+		const auto idResult = std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), newGid.id, 16);
+		if (typeResult.ec != std::errc() || idResult.ec != std::errc())
+			throw Common::Exception("Invalid gid registry line \"{}\"", line);
+
 		newGid.id = Common::swapBytes(newGid.id);
 
-		_strings[newGid] = split[2];
+		_strings[newGid] = fields[2];
 	}
 }
 
@@ -301,9 +301,7 @@ std::vector<uint32_t> HavokFile::readUint32Array(Common::ReadStream &binhkx, Hav
 		return data;
 
 	binhkx.seek(array.offset);
-	for (auto &date : data) {
-		date = binhkx.readUint32LE();
-	}
+	binhkx.readArrayLE(std::span(data));
 
 	return data;
 }
@@ -315,9 +313,7 @@ std::vector<int16_t> HavokFile::readSint16Array(Common::ReadStream &binhkx, Havo
 		return data;
 
 	binhkx.seek(array.offset);
-	for (auto &date : data) {
-		date = binhkx.readUint32LE();
-	}
+	binhkx.readArrayLE(std::span(data));
 
 	return data;
 }
@@ -819,6 +815,7 @@ HavokFile::hkaAnimation HavokFile::readHkaSplineCompressedAnimation(Common::Read
 				}
 
 				std::vector<glm::vec3> positionControlPoints;
+				positionControlPoints.reserve(numItems + 1);
 				for (int i = 0; i <= numItems; ++i) {
 					glm::vec3 position(0);
 					switch (positionQuantizationType) {
@@ -858,10 +855,9 @@ HavokFile::hkaAnimation HavokFile::readHkaSplineCompressedAnimation(Common::Read
 					positionControlPoints.emplace_back(position);
 				}
 
-				Common::NURBS<glm::vec3> nurbs(positionControlPoints, knots, degree);
-				for (unsigned int i = 0; i < numBlockFrames; ++i) {
-					track.positions.emplace_back(nurbs.interpolate(i));
-				}
+				Common::NURBS<glm::vec3> nurbs(std::move(positionControlPoints), std::move(knots), degree);
+				track.positions.resize(numBlockFrames);
+				nurbs.interpolate(0, track.positions);
 
 				if ((dataStream->pos() - begin) % 4 != 0)
 					dataStream->skip(4 - (dataStream->pos() - begin) % 4);
@@ -887,6 +883,7 @@ HavokFile::hkaAnimation HavokFile::readHkaSplineCompressedAnimation(Common::Read
 				}
 
 				std::vector<glm::quat> rotationControlPoints;
+				rotationControlPoints.reserve(numItems + 1);
 				for (int i = 0; i <= numItems; ++i) {
 					glm::quat rotation;
 
@@ -901,10 +898,9 @@ HavokFile::hkaAnimation HavokFile::readHkaSplineCompressedAnimation(Common::Read
 					rotationControlPoints.emplace_back(rotation);
 				}
 
-				Common::NURBS<glm::quat> nurbs(rotationControlPoints, knots, degree);
-				for (unsigned int i = 0; i < numBlockFrames; ++i) {
-					track.rotations.emplace_back(nurbs.interpolate(i));
-				}
+				Common::NURBS<glm::quat> nurbs(std::move(rotationControlPoints), std::move(knots), degree);
+				track.rotations.resize(numBlockFrames);
+				nurbs.interpolate(0, track.rotations);
 			} else if (rotationTypeStatic) {
 				glm::quat rotation;
 				switch (rotationQuantizationType) {
@@ -1436,31 +1432,24 @@ HavokFile::readHkpMeshSubpartStorage(Common::ReadStream &binhkx, uint32_t sectio
 
 	meshSubpartStorage.vertices.resize(verticesArray.count);
 	binhkx.seek(verticesArray.offset);
-	for (auto &vertex: meshSubpartStorage.vertices)
-		vertex = binhkx.read<glm::vec4>();
+	binhkx.readArrayLE(std::span(meshSubpartStorage.vertices));
 
 	if (indices8Array.offset != 0xFFFFFFFF) {
 		binhkx.seek(indices8Array.offset);
 		meshSubpartStorage.indices8.resize(indices8Array.count);
-		for (auto &index: meshSubpartStorage.indices8) {
-			index = binhkx.readByte();
-		}
+		binhkx.readArrayLE(std::span(meshSubpartStorage.indices8));
 	}
 
 	if (indices16Array.offset != 0xFFFFFFFF) {
 		binhkx.seek(indices16Array.offset);
 		meshSubpartStorage.indices16.resize(indices16Array.count);
-		for (auto &index: meshSubpartStorage.indices16) {
-			index = binhkx.readUint16LE();
-		}
+		binhkx.readArrayLE(std::span(meshSubpartStorage.indices16));
 	}
 
 	if (indices32Array.offset != 0xFFFFFFFF) {
 		binhkx.seek(indices32Array.offset);
 		meshSubpartStorage.indices32.resize(indices32Array.count);
-		for (auto &index: meshSubpartStorage.indices32) {
-			index = binhkx.readUint32LE();
-		}
+		binhkx.readArrayLE(std::span(meshSubpartStorage.indices32));
 	}
 
 	return meshSubpartStorage;
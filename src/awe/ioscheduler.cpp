@@ -0,0 +1,185 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "src/common/readfile.h"
+#include "src/common/exception.h"
+#include "src/common/profiler.h"
+
+#include "src/awe/ioscheduler.h"
+
+namespace AWE {
+
+/*!
+ * Ranges in the same archive which are separated by less than this gap are
+ * merged into one prefetch, since reading the gap is cheaper than an
+ * additional seek.
+ */
+static constexpr size_t kMaxMergeGap = 64 * 1024;
+
+IOScheduler::IOScheduler() : _finished(false) {
+	_thread = std::thread(&IOScheduler::run, this);
+
+#if OS_LINUX
+	pthread_setname_np(_thread.native_handle(), "IO Thread");
+#endif
+}
+
+IOScheduler::~IOScheduler() {
+	{
+		std::lock_guard<std::mutex> l(_requestAccess);
+		_finished = true;
+	}
+	_requestCond.notify_all();
+
+	if (_thread.joinable())
+		_thread.join();
+}
+
+std::future<std::unique_ptr<Common::ReadStream>> IOScheduler::request(const Archive *archive, size_t index, int priority) {
+	if (!archive)
+		throw CreateException("Invalid archive given");
+
+	return addRequest(Request{priority, archive, index, "", std::nullopt, {}});
+}
+
+std::future<std::unique_ptr<Common::ReadStream>> IOScheduler::request(const std::string &file, int priority) {
+	return addRequest(Request{priority, nullptr, 0, file, std::nullopt, {}});
+}
+
+size_t IOScheduler::getNumPendingRequests() const {
+	std::lock_guard<std::mutex> l(_requestAccess);
+	return _requests.size();
+}
+
+std::future<std::unique_ptr<Common::ReadStream>> IOScheduler::addRequest(Request request) {
+	auto future = request.promise.get_future();
+
+	{
+		std::lock_guard<std::mutex> l(_requestAccess);
+		_requests.emplace_back(std::move(request));
+	}
+	_requestCond.notify_one();
+
+	return future;
+}
+
+void IOScheduler::run() {
+	PROFILE_THREAD_NAME("IO Thread");
+
+	while (true) {
+		std::vector<Request> batch;
+
+		{
+			std::unique_lock<std::mutex> l(_requestAccess);
+			_requestCond.wait(l, [&]{ return _finished || !_requests.empty(); });
+
+			if (_finished)
+				return;
+
+			// Take all requests of the highest priority, the rest waits for the next round
+			const int priority = std::max_element(_requests.begin(), _requests.end(), [](const Request &a, const Request &b) {
+				return a.priority < b.priority;
+			})->priority;
+
+			const auto lowerPriority = std::stable_partition(_requests.begin(), _requests.end(), [&](const Request &r) {
+				return r.priority == priority;
+			});
+
+			batch.insert(batch.end(), std::make_move_iterator(_requests.begin()), std::make_move_iterator(lowerPriority));
+			_requests.erase(_requests.begin(), lowerPriority);
+		}
+
+		process(batch);
+	}
+}
+
+void IOScheduler::process(std::vector<Request> &requests) {
+	PROFILE_ZONE("Process IO Requests");
+	PROFILE_COUNTER("IO Requests", requests.size());
+
+	for (auto &request : requests) {
+		if (!request.archive)
+			continue;
+
+		try {
+			request.range = request.archive->getResourceRange(request.index);
+		} catch (...) {
+			request.promise.set_exception(std::current_exception());
+			request.failed = true;
+		}
+	}
+
+	// Group the requests by archive and order them by their offset, loose files come last ordered by their path
+	std::stable_sort(requests.begin(), requests.end(), [](const Request &a, const Request &b) {
+		if (a.archive != b.archive) {
+			if (!a.archive || !b.archive)
+				return a.archive != nullptr;
+			return a.archive < b.archive;
+		}
+
+		if (!a.archive)
+			return a.file < b.file;
+
+		if (a.range && b.range)
+			return a.range->offset < b.range->offset;
+
+		return a.range.has_value() && !b.range.has_value();
+	});
+
+	// Merge close ranges and prefetch them, before any resource is created
+	const Archive *archive = nullptr;
+	std::optional<Archive::ResourceRange> merged;
+	for (const auto &request : requests) {
+		if (!request.range)
+			continue;
+
+		if (merged && archive == request.archive && request.range->offset <= merged->offset + merged->size + kMaxMergeGap) {
+			merged->size = std::max(merged->size, request.range->offset + request.range->size - merged->offset);
+			continue;
+		}
+
+		if (merged)
+			archive->prefetch(*merged);
+
+		archive = request.archive;
+		merged = request.range;
+	}
+
+	if (merged)
+		archive->prefetch(*merged);
+
+	for (auto &request : requests) {
+		if (request.failed)
+			continue;
+
+		try {
+			if (request.archive)
+				request.promise.set_value(std::unique_ptr<Common::ReadStream>(request.archive->getResourceByIndex(request.index)));
+			else
+				request.promise.set_value(std::make_unique<Common::ReadFile>(request.file));
+		} catch (...) {
+			request.promise.set_exception(std::current_exception());
+		}
+	}
+}
+
+} // End of namespace AWE
@@ -0,0 +1,105 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AWE_IOSCHEDULER_H
+#define AWE_IOSCHEDULER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+
+#include "src/common/types.h"
+#include "src/common/readstream.h"
+
+#include "src/awe/archive.h"
+
+namespace AWE {
+
+/*!
+ * \brief Scheduler for asynchronous resource requests
+ *
+ * Requests are served by a dedicated io thread. Each time the thread wakes
+ * up, it takes all outstanding requests of the highest priority, groups them
+ * by their archive and orders them by their offset in the archive, so that
+ * archives are read front to back instead of in the order the requests came
+ * in. Ranges which lie close to each other are merged and prefetched as one
+ * before the resources are created, which gives the operating system a
+ * chance to read them ahead with few large reads. Requests of lower priority
+ * are only served, when no request of a higher priority is waiting.
+ */
+class IOScheduler : Common::Noncopyable {
+public:
+	IOScheduler();
+	~IOScheduler();
+
+	/*!
+	 * Request a resource from an archive
+	 * \param archive The archive containing the resource
+	 * \param index The index of the resource in the archive
+	 * \param priority The priority of the request, higher priorities are served first
+	 * \return A future containing the resource or nullptr if it could not be found
+	 */
+	std::future<std::unique_ptr<Common::ReadStream>> request(const Archive *archive, size_t index, int priority = 0);
+
+	/*!
+	 * Request a loose file from the file system
+	 * \param file The path of the file
+	 * \param priority The priority of the request, higher priorities are served first
+	 * \return A future containing the file stream
+	 */
+	std::future<std::unique_ptr<Common::ReadStream>> request(const std::string &file, int priority = 0);
+
+	/*!
+	 * Get the number of requests not yet taken by the io thread
+	 * \return The number of waiting requests
+	 */
+	size_t getNumPendingRequests() const;
+
+private:
+	struct Request {
+		int priority;
+		const Archive *archive;
+		size_t index;
+		std::string file;
+		std::optional<Archive::ResourceRange> range;
+		std::promise<std::unique_ptr<Common::ReadStream>> promise;
+		bool failed{false};
+	};
+
+	std::future<std::unique_ptr<Common::ReadStream>> addRequest(Request request);
+
+	void run();
+	static void process(std::vector<Request> &requests);
+
+	bool _finished;
+	mutable std::mutex _requestAccess;
+	std::condition_variable _requestCond;
+	std::vector<Request> _requests;
+	std::thread _thread;
+};
+
+} // End of namespace AWE
+
+#endif // AWE_IOSCHEDULER_H
@@ -43,7 +43,9 @@ AWE::OBJFile::OBJFile(Common::ReadStream *obj) : _obj(obj) {
 		obj->skip(4); // CRC32 Hash for these files
 	}
 
-	_name = Common::toLower(std::regex_replace(strings[0], std::regex("\\.rfx"), ""));
+	_name = strings[0];
+	Common::replaceInPlace(_name, ".rfx", "");
+	Common::toLowerInPlace(_name);
 
 	uint32_t numPrograms = obj->readUint32LE();
 	_programs.resize(numPrograms);
@@ -19,7 +19,6 @@
  */
 
 #include <vector>
-#include <regex>
 
 #include "src/awe/path.h"
 #include "src/awe/types.h"
@@ -50,8 +49,10 @@ PACKMETAFile::PACKMETAFile(Common::ReadStream &packmeta) {
 		item.name = AWE::getNormalizedPath(packmeta.readNullTerminatedString());
 	}
 
-	for (auto &item: fileEntries) {
-		item.offset = packmeta.readUint32LE();
+	std::vector<uint32_t> fileOffsets(numElements);
+	packmeta.readArrayLE(std::span(fileOffsets));
+	for (size_t i = 0; i < numElements; ++i) {
+		fileEntries[i].offset = fileOffsets[i];
 	}
 
 	uint32_t ridCount = packmeta.readUint32LE();
@@ -59,12 +60,12 @@ PACKMETAFile::PACKMETAFile(Common::ReadStream &packmeta) {
 	std::vector<RIDEntry> ridEntries;
 	ridEntries.resize(ridCount);
 
-	for (auto &entry: ridEntries) {
-		entry.rid = packmeta.readUint32BE();
-	}
-
-	for (auto &entry: ridEntries) {
-		entry.offset = packmeta.readUint32LE();
+	std::vector<uint32_t> rids(ridCount), ridOffsets(ridCount);
+	packmeta.readArrayBE(std::span(rids));
+	packmeta.readArrayLE(std::span(ridOffsets));
+	for (size_t i = 0; i < ridCount; ++i) {
+		ridEntries[i].rid = rids[i];
+		ridEntries[i].offset = ridOffsets[i];
 	}
 
 	for (const auto &entry: fileEntries) {
@@ -25,12 +25,13 @@
 namespace AWE {
 
 std::string getNormalizedPath(const std::string &path) {
-	std::string lower = Common::toLower(path);
-	if (Common::startsWith(lower, "runtimedata\\pc")) 
-		lower = Common::replace(lower, "runtimedata\\pc", "d:");
-	lower = Common::replace(lower, "\\", "/");
-	if (Common::startsWith(lower, "d:/data/")) 
-		lower = Common::replace(lower, "d:/data/", "");
+	std::string lower = path;
+	Common::toLowerInPlace(lower);
+	if (lower.starts_with("runtimedata\\pc"))
+		Common::replaceInPlace(lower, "runtimedata\\pc", "d:");
+	Common::foldSlashes(lower);
+	if (lower.starts_with("d:/data/"))
+		Common::replaceInPlace(lower, "d:/data/", "");
 	return lower;
 }
 
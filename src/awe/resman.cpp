@@ -21,58 +21,196 @@
 #include <memory>
 #include <iostream>
 #include <filesystem>
+#include <chrono>
+#include <numeric>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
 
 #include "src/common/readfile.h"
+#include "src/common/memreadstream.h"
+#include "src/common/threadpool.h"
+#include "src/common/mappedfile.h"
+#include "src/common/profiler.h"
+#include "src/common/strutil.h"
 
 #include "resman.h"
 #include "src/awe/path.h"
+#include "src/awe/awepackarchive.h"
+#include "src/awe/binarchive.h"
 #include "src/awe/rmdparchive.h"
 #include "src/awe/streamedresourcefile.h"
 
 namespace AWE {
 
+/*!
+ * Get the key of a loose file or directory relative to a search path. Paths
+ * are normalized the same way when scanning and when looking them up, so
+ * that for example "./a//b" and "/a/b" find the file "a/b".
+ */
+static std::string getLooseFileKey(const std::string &path) {
+	std::string key = std::filesystem::path(path).lexically_normal().generic_string();
+
+#if OS_WINDOWS
+	// The file system is case insensitive on windows
+	Common::toLowerInPlace(key);
+#endif
+
+	const auto begin = key.find_first_not_of('/');
+	if (begin == std::string::npos || key.substr(begin) == ".")
+		return "";
+
+	const auto end = key.find_last_not_of('/');
+	return key.substr(begin, end - begin + 1);
+}
+
+/*!
+ * Load multiple files in parallel and log how long it took compared to the
+ * accumulated time of loading every single file
+ */
+template<typename T, typename Input, typename Load>
+static std::vector<T> loadParallel(const std::vector<Input> &inputs, const std::string &name, Load load) {
+	std::vector<T> results(inputs.size());
+	std::vector<std::chrono::steady_clock::duration> durations(inputs.size());
+
+	const auto start = std::chrono::steady_clock::now();
+	Threads.parallelFor(inputs.size(), [&](size_t index) {
+		const auto loadStart = std::chrono::steady_clock::now();
+		results[index] = load(inputs[index]);
+		durations[index] = std::chrono::steady_clock::now() - loadStart;
+	});
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	const std::chrono::duration<double, std::milli> accumulated = std::accumulate(
+		durations.begin(),
+		durations.end(),
+		std::chrono::steady_clock::duration::zero()
+	);
+
+	spdlog::info(
+		"Indexed {} {} in {:.1f}ms, {:.1f}ms accumulated ({:.1f}x speedup)",
+		inputs.size(),
+		name,
+		elapsed.count(),
+		accumulated.count(),
+		elapsed.count() > 0.0 ? accumulated.count() / elapsed.count() : 1.0
+	);
+
+	return results;
+}
+
 void RessourceManager::indexPackmeta(const std::string &packmetaFile) {
+	addMeta(loadPackmeta(packmetaFile));
+}
+
+void RessourceManager::indexPackmetas(const std::vector<std::string> &packmetaFiles) {
+	auto metas = loadParallel<std::unique_ptr<RIDProvider>>(
+		packmetaFiles,
+		"packmeta files",
+		[this](const std::string &file) { return loadPackmeta(file); }
+	);
+
+	for (auto &meta : metas)
+		addMeta(std::move(meta));
+}
+
+void RessourceManager::indexStreamedResource(const std::string &resourcedbFile) {
+	addMeta(loadStreamedResource(resourcedbFile));
+}
+
+void RessourceManager::indexStreamedResources(const std::vector<std::string> &resourcedbFiles) {
+	auto metas = loadParallel<std::unique_ptr<RIDProvider>>(
+		resourcedbFiles,
+		"streamed resource files",
+		[this](const std::string &file) { return loadStreamedResource(file); }
+	);
+
+	for (auto &meta : metas)
+		addMeta(std::move(meta));
+}
+
+void RessourceManager::indexArchive(const std::string &binFile, const std::string &rmdpFile) {
+	addArchive(loadArchive(binFile, rmdpFile, _verifyArchives));
+}
+
+void RessourceManager::indexArchive(const std::string &packFile) {
+	addArchive(std::make_unique<AWEPackArchive>(new Common::MappedFile(packFile)));
+}
+
+void RessourceManager::indexArchives(const std::vector<std::pair<std::string, std::string>> &archiveFiles) {
+	const bool verify = _verifyArchives;
+	auto archives = loadParallel<std::unique_ptr<Archive>>(
+		archiveFiles,
+		"archives",
+		[verify](const std::pair<std::string, std::string> &files) {
+			return loadArchive(files.first, files.second, verify);
+		}
+	);
+
+	for (auto &archive : archives)
+		addArchive(std::move(archive));
+}
+
+std::unique_ptr<RIDProvider> RessourceManager::loadPackmeta(const std::string &packmetaFile) {
 	std::unique_ptr<Common::ReadStream> packmeta;
 	packmeta.reset(getResource(packmetaFile));
 
 	if (!packmeta)
 		throw std::runtime_error("Invalid packmeta file");
 
-	_meta.emplace_back();
-	_meta.back() = std::make_unique<PACKMETAFile>(*packmeta);
+	return std::make_unique<PACKMETAFile>(*packmeta);
 }
 
-void RessourceManager::indexStreamedResource(const std::string &resourcedbFile) {
+std::unique_ptr<RIDProvider> RessourceManager::loadStreamedResource(const std::string &resourcedbFile) {
 	std::unique_ptr<Common::ReadStream> resourcedb;
 	resourcedb.reset(getResource(resourcedbFile));
 
-	_meta.emplace_back();
-	_meta.back() = std::make_unique<StreamedResourceFile>(*resourcedb);
+	if (!resourcedb)
+		throw std::runtime_error("Invalid streamed resource file");
+
+	return std::make_unique<StreamedResourceFile>(*resourcedb);
 }
 
-void RessourceManager::indexArchive(const std::string &binFile, const std::string &rmdpFile) {
-	Common::ReadFile *bin, *rmdp;
-	bin = new Common::ReadFile(binFile);
-	rmdp = new Common::ReadFile(rmdpFile);
-	_archives.emplace_back();
-	_archives.back() = std::make_unique<RMDPArchive>(bin, rmdp);
+std::unique_ptr<Archive> RessourceManager::loadArchive(const std::string &binFile, const std::string &rmdpFile, bool verify) {
+	// Map the archives into memory, so that uncompressed resources can be handed out without copying them
+	Common::MappedFile *bin, *rmdp;
+	bin = new Common::MappedFile(binFile);
+	rmdp = new Common::MappedFile(rmdpFile);
+	auto archive = std::make_unique<RMDPArchive>(bin, rmdp);
+	archive->setVerifyData(verify);
+	return archive;
+}
+
+void RessourceManager::addMeta(std::unique_ptr<RIDProvider> meta) {
+	std::unique_lock<std::shared_mutex> l(_indexAccess);
+	_meta.emplace_back(std::move(meta));
+}
+
+void RessourceManager::addArchive(std::unique_ptr<Archive> archive) {
+	std::unique_lock<std::shared_mutex> l(_indexAccess);
+
+	// Resources of earlier indexed archives take precedence
+	for (size_t i = 0; i < archive->getNumResources(); ++i)
+		_resources.emplace(Common::toLower(archive->getResourcePath(i)), ResourceEntry{archive.get(), i});
+
+	_archives.emplace_back(std::move(archive));
 }
 
 bool RessourceManager::hasResource(const std::string &path) {
-	if (std::filesystem::is_regular_file(_rootPath + "/" + path))
-		return true;
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
 
-	const auto fullPath = _pathPrefix + AWE::getNormalizedPath(path);
-	for (const auto &archive : _archives) {
-		if (archive->hasResource(fullPath))
-			return true;
-	}
+	if (_looseFiles.contains(getLooseFileKey(path)))
+		return true;
 
-	return false;
+	return _resources.contains(_pathPrefix + AWE::getNormalizedPath(path));
 }
 
 bool RessourceManager::hasDirectory(const std::string &path) {
-	if (std::filesystem::is_directory(_rootPath + "/" + path))
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
+
+	if (_looseDirectories.contains(getLooseFileKey(path)))
 		return true;
 
 	const auto fullPath = _pathPrefix + AWE::getNormalizedPath(path);
@@ -85,6 +223,8 @@ bool RessourceManager::hasDirectory(const std::string &path) {
 }
 
 std::string RessourceManager::getResourcePath(rid_t rid) {
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
+
 	for (const auto &meta : _meta) {
 		const std::string path = meta->getNameByRid(rid);
 
@@ -97,6 +237,8 @@ std::string RessourceManager::getResourcePath(rid_t rid) {
 }
 
 std::vector<std::string> RessourceManager::getDirectoryResources(const std::string &path) {
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
+
 	std::vector<std::string> paths;
 	const auto fullPath = _pathPrefix + AWE::getNormalizedPath(path);
 	for (auto &archive : _archives) {
@@ -110,34 +252,342 @@ std::vector<std::string> RessourceManager::getDirectoryResources(const std::stri
 }
 
 Common::ReadStream *RessourceManager::getResource(const std::string &path) {
-	if (std::filesystem::is_regular_file(_rootPath + "/" + path))
-		return new Common::ReadFile(_rootPath + "/" + path);
+	PROFILE_ZONE("Get Resource");
 
-	for (const auto &dirPath: _paths) {
-		const auto fullPath = std::format("{}/{}", dirPath, path);
-		if (std::filesystem::is_regular_file(fullPath))
-			return new Common::ReadFile(fullPath);
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
+
+	const auto looseFile = _looseFiles.find(getLooseFileKey(path));
+	if (looseFile != _looseFiles.end()) {
+		if (_recording)
+			recordAccess(path, looseFile->second);
+		return new Common::ReadFile(looseFile->second);
 	}
 
-	const auto fullPath = _pathPrefix + AWE::getNormalizedPath(path);
-	for (auto &archive : _archives) {
-		Common::ReadStream *stream = archive->getResource(fullPath);
-		if (stream != nullptr)
-			return stream;
+	const auto resource = _resources.find(_pathPrefix + AWE::getNormalizedPath(path));
+	if (resource == _resources.end())
+		return nullptr;
+
+	const ResourceEntry entry = resource->second;
+
+	if (_recording)
+		recordAccess(path, entry);
+
+	if (_cache.isEnabled() && !entry.archive->isMemoryBacked()) {
+		const std::string key = resource->first;
+		l.unlock();
+		return getCachedResource(key, entry);
 	}
-	return nullptr;
+
+	l.unlock();
+
+	return entry.archive->getResourceByIndex(entry.index);
+}
+
+Common::ReadStream *RessourceManager::getCachedResource(const std::string &key, const ResourceEntry &entry) {
+	auto cached = _cache.find(key);
+	if (!cached) {
+		PROFILE_ZONE("Cache Resource");
+
+		std::unique_ptr<Common::ReadStream> stream(entry.archive->getResourceByIndex(entry.index));
+		if (!stream)
+			return nullptr;
+
+		cached = _cache.insert(key, *stream);
+	}
+
+	return new Common::MemoryReadStream(cached->data, cached->size);
 }
 
 Common::ReadStream *RessourceManager::getResource(rid_t rid) {
-	for (const auto &meta : _meta) {
-		const std::string path = meta->getNameByRid(rid);
+	const std::string path = getResourcePath(rid);
+	if (path.empty())
+		return nullptr;
 
-		if (path.empty())
-			continue;
+	return getResource(path);
+}
+
+std::future<std::unique_ptr<Common::ReadStream>> RessourceManager::getResourceAsync(const std::string &path, int priority) {
+	// The io thread is only started, once the first asynchronous request is made
+	std::call_once(_ioSchedulerInit, [this]{ _ioScheduler = std::make_unique<IOScheduler>(); });
+
+	std::shared_lock<std::shared_mutex> l(_indexAccess);
+
+	const auto looseFile = _looseFiles.find(getLooseFileKey(path));
+	if (looseFile != _looseFiles.end()) {
+		if (_recording)
+			recordAccess(path, looseFile->second);
+		return _ioScheduler->request(looseFile->second, priority);
+	}
+
+	const auto resource = _resources.find(_pathPrefix + AWE::getNormalizedPath(path));
+	if (resource == _resources.end()) {
+		std::promise<std::unique_ptr<Common::ReadStream>> notFound;
+		notFound.set_value(nullptr);
+		return notFound.get_future();
+	}
+
+	if (_recording)
+		recordAccess(path, resource->second);
 
-		return getResource(path);
+	if (_cache.isEnabled() && !resource->second.archive->isMemoryBacked()) {
+		const auto cached = _cache.find(resource->first);
+		if (cached) {
+			std::promise<std::unique_ptr<Common::ReadStream>> hit;
+			hit.set_value(std::make_unique<Common::MemoryReadStream>(cached->data, cached->size));
+			return hit.get_future();
+		}
 	}
-	return nullptr;
+
+	return _ioScheduler->request(resource->second.archive, resource->second.index, priority);
+}
+
+std::shared_ptr<BINArchive> RessourceManager::getBINArchive(const std::string &path) {
+	return getBINArchiveAsync(path).get();
+}
+
+std::future<std::shared_ptr<BINArchive>> RessourceManager::getBINArchiveAsync(const std::string &path, int priority) {
+	std::string key;
+	{
+		std::shared_lock<std::shared_mutex> l(_indexAccess);
+
+		// Loose files can change when they are rescanned, so only bin archives from archives are cached
+		const auto resource = _resources.find(_pathPrefix + AWE::getNormalizedPath(path));
+		if (_cache.isEnabled() && !_looseFiles.contains(getLooseFileKey(path)) && resource != _resources.end()) {
+			key = resource->first;
+
+			auto cached = _cache.findArchive(key);
+			if (cached) {
+				if (_recording)
+					recordAccess(path, resource->second);
+
+				std::promise<std::shared_ptr<BINArchive>> hit;
+				hit.set_value(std::move(cached));
+				return hit.get_future();
+			}
+		}
+	}
+
+	// The archive is decoded on the thread waiting for it, to not block the io thread
+	return std::async(
+		std::launch::deferred,
+		[this, key, request = getResourceAsync(path, priority)]() mutable -> std::shared_ptr<BINArchive> {
+			std::unique_ptr<Common::ReadStream> bin = request.get();
+			if (!bin)
+				return nullptr;
+
+			auto archive = std::make_shared<BINArchive>(*bin);
+			if (!key.empty())
+				_cache.insertArchive(key, archive, archive->getDataSize());
+
+			return archive;
+		}
+	);
+}
+
+void RessourceManager::setVerifyArchives(bool verify) {
+	_verifyArchives = verify;
+}
+
+void RessourceManager::setCacheBudget(size_t budget) {
+	_cache.setBudget(budget);
+}
+
+ResourceCache::Statistics RessourceManager::getCacheStatistics() const {
+	return _cache.getStatistics();
+}
+
+void RessourceManager::setTraceMode(TraceMode mode, const std::string &directory) {
+	std::lock_guard<std::mutex> l(_traceAccess);
+	_traceMode = mode;
+	_traceDirectory = directory;
+}
+
+void RessourceManager::beginSession(const std::string &name) {
+	endSession();
+
+	std::unique_lock<std::mutex> l(_traceAccess);
+	_sessionName = name;
+
+	switch (_traceMode) {
+		case kTraceRecord:
+			_recording = true;
+			break;
+
+		case kTraceReplay: {
+			const std::string traceFile = getTraceFile(name);
+			_traceStatistics = TraceStatistics{};
+			l.unlock();
+			replayTrace(traceFile);
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+void RessourceManager::endSession() {
+	if (_cache.isEnabled()) {
+		const auto statistics = _cache.getStatistics();
+		spdlog::debug(
+			"Resource cache: {} hits, {} misses, {} evictions, {} entries with {} of {} bytes",
+			statistics.hits,
+			statistics.misses,
+			statistics.evictions,
+			statistics.entries,
+			statistics.size,
+			statistics.budget
+		);
+	}
+
+	std::lock_guard<std::mutex> l(_traceAccess);
+	if (!_recording)
+		return;
+
+	_recording = false;
+
+	const std::string traceFile = getTraceFile(_sessionName);
+	std::ofstream out(traceFile, std::ios::trunc);
+	for (const auto &entry : _trace)
+		out << entry.offset << " " << entry.size << " " << entry.path << "\n";
+
+	if (!out)
+		spdlog::warn("Failed to write resource trace {}", traceFile);
+	else
+		spdlog::info("Recorded {} resources into trace {}", _trace.size(), traceFile);
+
+	_trace.clear();
+	_tracedPaths.clear();
+}
+
+RessourceManager::TraceStatistics RessourceManager::getTraceStatistics() const {
+	std::lock_guard<std::mutex> l(_traceAccess);
+	return _traceStatistics;
+}
+
+void RessourceManager::recordAccess(const std::string &path, const std::string &looseFile) {
+	std::error_code error;
+	const size_t size = std::filesystem::file_size(looseFile, error);
+
+	std::lock_guard<std::mutex> l(_traceAccess);
+	if (_tracedPaths.emplace(path).second)
+		_trace.emplace_back(TraceEntry{path, 0, error ? 0 : size});
+}
+
+void RessourceManager::recordAccess(const std::string &path, const ResourceEntry &entry) {
+	const auto range = entry.archive->getResourceRange(entry.index);
+
+	std::lock_guard<std::mutex> l(_traceAccess);
+	if (_tracedPaths.emplace(path).second)
+		_trace.emplace_back(TraceEntry{path, range ? range->offset : 0, range ? range->size : 0});
+}
+
+void RessourceManager::replayTrace(const std::string &traceFile) {
+	std::ifstream in(traceFile);
+	if (!in) {
+		spdlog::debug("No resource trace {} available", traceFile);
+		return;
+	}
+
+	struct PrefetchRange {
+		const Archive *archive;
+		Archive::ResourceRange range;
+	};
+
+	std::vector<PrefetchRange> ranges;
+	std::vector<std::string> looseFiles;
+	size_t staleEntries = 0;
+
+	{
+		std::shared_lock<std::shared_mutex> l(_indexAccess);
+
+		std::string line;
+		while (std::getline(in, line)) {
+			std::istringstream entryStream(line);
+			TraceEntry entry{};
+			entryStream >> entry.offset >> entry.size >> std::ws;
+			std::getline(entryStream, entry.path);
+			if (!entryStream || entry.path.empty())
+				continue;
+
+			const auto looseFile = _looseFiles.find(getLooseFileKey(entry.path));
+			if (looseFile != _looseFiles.end()) {
+				looseFiles.emplace_back(looseFile->second);
+				continue;
+			}
+
+			const auto resource = _resources.find(_pathPrefix + AWE::getNormalizedPath(entry.path));
+			if (resource == _resources.end()) {
+				staleEntries++;
+				continue;
+			}
+
+			// Skip entries whose location changed since the trace was recorded
+			const auto range = resource->second.archive->getResourceRange(resource->second.index);
+			if (!range || range->offset != entry.offset || range->size != entry.size) {
+				staleEntries++;
+				continue;
+			}
+
+			ranges.emplace_back(PrefetchRange{resource->second.archive, *range});
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> l(_traceAccess);
+		_traceStatistics = TraceStatistics{ranges.size() + looseFiles.size(), staleEntries};
+	}
+
+	if (staleEntries > 0)
+		spdlog::warn("Skipping {} outdated entries of resource trace {}", staleEntries, traceFile);
+
+	std::sort(ranges.begin(), ranges.end(), [](const PrefetchRange &a, const PrefetchRange &b) {
+		if (a.archive != b.archive)
+			return a.archive < b.archive;
+		return a.range.offset < b.range.offset;
+	});
+
+	spdlog::info("Prefetching {} resources from trace {}", ranges.size() + looseFiles.size(), traceFile);
+
+	// Read the ranges ahead in the background, merging ranges which are directly adjacent
+	Threads.add([ranges = std::move(ranges), looseFiles = std::move(looseFiles)]() {
+		std::optional<PrefetchRange> merged;
+		for (const auto &range : ranges) {
+			if (
+				merged &&
+				merged->archive == range.archive &&
+				range.range.offset <= merged->range.offset + merged->range.size
+			) {
+				merged->range.size = std::max(merged->range.size, range.range.offset + range.range.size - merged->range.offset);
+				continue;
+			}
+
+			if (merged)
+				merged->archive->prefetch(merged->range);
+			merged = range;
+		}
+
+		if (merged)
+			merged->archive->prefetch(merged->range);
+
+		for (const auto &looseFile : looseFiles) {
+			try {
+				Common::ReadFile file(looseFile);
+				file.prefetch(0, file.size());
+			} catch (...) {
+			}
+		}
+	}, Common::TaskPriority::kBackground);
+}
+
+std::string RessourceManager::getTraceFile(const std::string &session) const {
+	std::string fileName = session;
+	std::replace(fileName.begin(), fileName.end(), '/', '_');
+	return (std::filesystem::path(_traceDirectory) / (fileName + ".trace")).string();
+}
+
+std::future<std::unique_ptr<Common::ReadStream>> RessourceManager::getResourceAsync(rid_t rid, int priority) {
+	return getResourceAsync(getResourcePath(rid), priority);
 }
 
 void RessourceManager::setPathPrefix(const std::string &pathPrefix) {
@@ -145,7 +595,9 @@ void RessourceManager::setPathPrefix(const std::string &pathPrefix) {
 }
 
 void RessourceManager::setRootPath(const std::string &rootPath) {
+	std::unique_lock<std::shared_mutex> l(_indexAccess);
 	_rootPath = rootPath;
+	scanAllLooseFiles();
 }
 
 void RessourceManager::addPath(const std::string &path) {
@@ -153,7 +605,44 @@ void RessourceManager::addPath(const std::string &path) {
 	if (!std::filesystem::is_directory(path))
 		return;
 
+	std::unique_lock<std::shared_mutex> l(_indexAccess);
 	_paths.emplace_back(path);
+	scanLooseFiles(path);
+}
+
+void RessourceManager::rescanLooseFiles() {
+	std::unique_lock<std::shared_mutex> l(_indexAccess);
+	scanAllLooseFiles();
+}
+
+void RessourceManager::scanAllLooseFiles() {
+	_looseFiles.clear();
+	_looseDirectories.clear();
+
+	// Files in the root path take precedence over files in the additional paths
+	if (!_rootPath.empty())
+		scanLooseFiles(_rootPath);
+	for (const auto &path: _paths)
+		scanLooseFiles(path);
+}
+
+void RessourceManager::scanLooseFiles(const std::string &path) {
+	std::error_code ec;
+	std::filesystem::recursive_directory_iterator iter(
+		path,
+		std::filesystem::directory_options::skip_permission_denied,
+		ec
+	);
+
+	for (; !ec && iter != std::filesystem::recursive_directory_iterator(); iter.increment(ec)) {
+		const auto relativePath = getLooseFileKey(iter->path().lexically_relative(path).string());
+
+		std::error_code statusError;
+		if (iter->is_directory(statusError))
+			_looseDirectories.emplace(relativePath);
+		else if (iter->is_regular_file(statusError))
+			_looseFiles.emplace(relativePath, iter->path().string());
+	}
 }
 
 } // End of namespace AWE
@@ -24,11 +24,19 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
+#include <future>
+#include <atomic>
+#include <mutex>
 
 #include "src/common/singleton.h"
 #include "src/common/readstream.h"
 
 #include "src/awe/archive.h"
+#include "src/awe/ioscheduler.h"
+#include "src/awe/resourcecache.h"
 #include "src/awe/packmetafile.h"
 
 namespace AWE {
@@ -38,7 +46,14 @@ namespace AWE {
  *
  * This class can be used to manage resources and index archives. It
  * is also used to read rid to path mappings from the packmeta and
- * streamed resource files
+ * streamed resource files.
+ *
+ * All resources are kept in one merged index, which is filled when
+ * archives are indexed and when loose files are scanned in the root
+ * path and the additional paths. Looking up resources therefore needs
+ * neither file system access nor asking every archive. Loose files
+ * override resources from archives and are only scanned when paths are
+ * set or added, or when rescanLooseFiles() is called.
  */
 class RessourceManager : public Common::Singleton<RessourceManager> {
 public:
@@ -46,12 +61,37 @@ public:
 	void setRootPath(const std::string &rootPath);
 	void addPath(const std::string &path);
 
+	/*!
+	 * Scan the root path and all additional paths again for loose
+	 * files, for example after files were added or removed from them
+	 */
+	void rescanLooseFiles();
+
+	/*
+	 * The index methods are safe to be called from multiple threads at once.
+	 * The methods indexing multiple files load them in parallel, but merge
+	 * them in the given order, so that they take precedence exactly as if
+	 * they were indexed one after another.
+	 */
+
 	void indexPackmeta(const std::string &packmetaFile);
+	void indexPackmetas(const std::vector<std::string> &packmetaFiles);
 
 	void indexStreamedResource(const std::string &resourcedbFile);
+	void indexStreamedResources(const std::vector<std::string> &resourcedbFiles);
 
 	void indexArchive(const std::string &binFile, const std::string &rmdpFile);
 
+	/*!
+	 * Index an OpenAWE pack file created by the repack tool. It is used like a
+	 * bin/rmdp archive and mapped into memory the same way.
+	 *
+	 * \param packFile The path of the pack file
+	 */
+	void indexArchive(const std::string &packFile);
+
+	void indexArchives(const std::vector<std::pair<std::string, std::string>> &archiveFiles);
+
 	bool hasResource(const std::string &path);
 	bool hasDirectory(const std::string &path);
 
@@ -63,12 +103,168 @@ public:
 
 	Common::ReadStream *getResource(rid_t rid);
 
+	/*!
+	 * Request a resource to be loaded asynchronously on the io thread. Requests
+	 * of higher priority are served first, requests of the same priority are
+	 * served in the order of their location in the archives, so submitting
+	 * everything needed at once allows the reads to be ordered and merged.
+	 *
+	 * \param path The path of the resource
+	 * \param priority The priority of the request
+	 * \return A future with the resource or nullptr if it does not exist
+	 */
+	std::future<std::unique_ptr<Common::ReadStream>> getResourceAsync(const std::string &path, int priority = 0);
+
+	std::future<std::unique_ptr<Common::ReadStream>> getResourceAsync(rid_t rid, int priority = 0);
+
+	/*!
+	 * Get a bin archive. Bin archives from indexed archives are kept decoded in
+	 * the resource cache, regardless of whether the archive containing them is
+	 * memory backed, so that requesting them again does not inflate them again.
+	 *
+	 * \param path The path of the bin archive
+	 * \return The bin archive or nullptr if it does not exist
+	 */
+	std::shared_ptr<BINArchive> getBINArchive(const std::string &path);
+
+	/*!
+	 * Request a bin archive like getBINArchive(). If it is not cached, it is
+	 * read on the io thread, but decoded when the future is waited for.
+	 *
+	 * \param path The path of the bin archive
+	 * \param priority The priority of the request
+	 * \return A future with the bin archive or nullptr if it does not exist
+	 */
+	std::future<std::shared_ptr<BINArchive>> getBINArchiveAsync(const std::string &path, int priority = 0);
+
+	/*!
+	 * Enable or disable verifying the checksums of resources from archives,
+	 * when they are accessed. This applies to archives indexed afterwards.
+	 *
+	 * \param verify If the resource data should be verified
+	 */
+	void setVerifyArchives(bool verify);
+
+	/*!
+	 * Set the budget of the cache for decoded resources. Resources from
+	 * archives which need decompression or copying are kept in the cache and
+	 * handed out as shared buffers, so repeated requests don't touch the
+	 * archive again. Bin archives requested by getBINArchive() are kept
+	 * decoded in the same cache. A budget of 0, the default, disables the
+	 * cache.
+	 *
+	 * \param budget The maximum number of bytes held by the cache
+	 */
+	void setCacheBudget(size_t budget);
+
+	/*!
+	 * Get the hit, miss and eviction counters of the resource cache
+	 *
+	 * \return The statistics of the resource cache
+	 */
+	ResourceCache::Statistics getCacheStatistics() const;
+
+	enum TraceMode {
+		kTraceDisabled,
+		kTraceRecord,
+		kTraceReplay
+	};
+
+	/*!
+	 * Set how resource access traces are handled for load sessions. When
+	 * recording, every resource requested during a session is written
+	 * together with its offset and size into a trace file named after the
+	 * session when the session ends. When replaying, the trace of a session
+	 * is read when it begins and the recorded ranges are read ahead in the
+	 * background in the order of their offsets.
+	 *
+	 * \param mode The trace mode to use
+	 * \param directory The directory in which the trace files are stored
+	 */
+	void setTraceMode(TraceMode mode, const std::string &directory);
+
+	/*!
+	 * Begin a load session, for example loading an episode
+	 *
+	 * \param name The name of the session, which is used as name of the trace file
+	 */
+	void beginSession(const std::string &name);
+
+	/*!
+	 * End the current load session and write its trace, if recording
+	 */
+	void endSession();
+
+	struct TraceStatistics {
+		size_t prefetched;
+		size_t stale;
+	};
+
+	/*!
+	 * Get the number of prefetched and skipped outdated entries of the last
+	 * replayed trace
+	 *
+	 * \return The statistics of the last replayed trace
+	 */
+	TraceStatistics getTraceStatistics() const;
+
 private:
+	struct ResourceEntry {
+		const Archive *archive;
+		size_t index;
+	};
+
+	struct TraceEntry {
+		std::string path;
+		size_t offset;
+		size_t size;
+	};
+
+	std::unique_ptr<RIDProvider> loadPackmeta(const std::string &packmetaFile);
+	std::unique_ptr<RIDProvider> loadStreamedResource(const std::string &resourcedbFile);
+	static std::unique_ptr<Archive> loadArchive(const std::string &binFile, const std::string &rmdpFile, bool verify);
+
+	void addMeta(std::unique_ptr<RIDProvider> meta);
+	void addArchive(std::unique_ptr<Archive> archive);
+
+	/*!
+	 * Scan the root path and all additional paths for loose files, the index lock has to be held exclusively
+	 */
+	void scanAllLooseFiles();
+	void scanLooseFiles(const std::string &path);
+
+	Common::ReadStream *getCachedResource(const std::string &key, const ResourceEntry &entry);
+
+	void recordAccess(const std::string &path, const std::string &looseFile);
+	void recordAccess(const std::string &path, const ResourceEntry &entry);
+	void replayTrace(const std::string &traceFile);
+	std::string getTraceFile(const std::string &session) const;
+
 	std::string _pathPrefix;
+	bool _verifyArchives{false};
 	std::string _rootPath;
 	std::vector<std::unique_ptr<RIDProvider>> _meta;
 	std::vector<std::string> _paths;
 	std::vector<std::unique_ptr<Archive>> _archives;
+
+	mutable std::shared_mutex _indexAccess;
+	std::unordered_map<std::string, std::string> _looseFiles;
+	std::unordered_set<std::string> _looseDirectories;
+	std::unordered_map<std::string, ResourceEntry> _resources;
+
+	ResourceCache _cache;
+
+	TraceMode _traceMode{kTraceDisabled};
+	std::string _traceDirectory;
+	std::string _sessionName;
+	std::atomic_bool _recording{false};
+	mutable std::mutex _traceAccess;
+	std::vector<TraceEntry> _trace;
+	std::unordered_set<std::string> _tracedPaths;
+	TraceStatistics _traceStatistics{};
+
+	std::once_flag _ioSchedulerInit;
+	std::unique_ptr<IOScheduler> _ioScheduler;
 };
 
 } // End of namespace AWE
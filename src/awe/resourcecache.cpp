@@ -0,0 +1,130 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "src/common/exception.h"
+
+#include "src/awe/resourcecache.h"
+
+namespace AWE {
+
+ResourceCache::ResourceCache(size_t budget) : _budget(budget), _size(0), _hits(0), _misses(0), _evictions(0) {
+}
+
+void ResourceCache::setBudget(size_t budget) {
+	std::lock_guard<std::mutex> l(_access);
+	_budget = budget;
+	evict(_budget);
+}
+
+bool ResourceCache::isEnabled() const {
+	std::lock_guard<std::mutex> l(_access);
+	return _budget > 0;
+}
+
+std::optional<ResourceCache::Entry> ResourceCache::find(const std::string &key) {
+	std::lock_guard<std::mutex> l(_access);
+
+	const auto iter = _index.find(key);
+	if (iter == _index.end()) {
+		_misses++;
+		return std::nullopt;
+	}
+
+	_hits++;
+	_entries.splice(_entries.begin(), _entries, iter->second);
+	return iter->second->entry;
+}
+
+ResourceCache::Entry ResourceCache::insert(const std::string &key, Common::ReadStream &stream) {
+	const size_t size = stream.size();
+
+	// Decode the data outside of the lock, so that multiple resources can be loaded at once
+	std::shared_ptr<byte[]> data(new byte[size]);
+	const auto view = stream.getView(0, size);
+	if (!view.empty())
+		std::memcpy(data.get(), view.data(), size);
+	else if (stream.readAt(0, data.get(), size) != size)
+		throw CreateException("Failed to read {} bytes of resource {}", size, key);
+
+	Entry entry{std::move(data), size};
+
+	std::lock_guard<std::mutex> l(_access);
+	insertItem(_index, Item{key, entry, nullptr});
+
+	return entry;
+}
+
+std::shared_ptr<BINArchive> ResourceCache::findArchive(const std::string &key) {
+	std::lock_guard<std::mutex> l(_access);
+
+	const auto iter = _archiveIndex.find(key);
+	if (iter == _archiveIndex.end()) {
+		_misses++;
+		return nullptr;
+	}
+
+	_hits++;
+	_entries.splice(_entries.begin(), _entries, iter->second);
+	return iter->second->archive;
+}
+
+void ResourceCache::insertArchive(const std::string &key, std::shared_ptr<BINArchive> archive, size_t size) {
+	std::lock_guard<std::mutex> l(_access);
+	insertItem(_archiveIndex, Item{key, Entry{nullptr, size}, std::move(archive)});
+}
+
+void ResourceCache::clear() {
+	std::lock_guard<std::mutex> l(_access);
+	_entries.clear();
+	_index.clear();
+	_archiveIndex.clear();
+	_size = 0;
+}
+
+ResourceCache::Statistics ResourceCache::getStatistics() const {
+	std::lock_guard<std::mutex> l(_access);
+	return {_hits, _misses, _evictions, _entries.size(), _size, _budget};
+}
+
+void ResourceCache::evict(size_t budget) {
+	while (_size > budget && !_entries.empty()) {
+		const auto &last = _entries.back();
+		_size -= last.entry.size;
+		(last.archive ? _archiveIndex : _index).erase(last.key);
+		_entries.pop_back();
+		_evictions++;
+	}
+}
+
+void ResourceCache::insertItem(EntryIndex &index, Item item) {
+	const size_t size = item.entry.size;
+	if (size > _budget || index.contains(item.key))
+		return;
+
+	evict(_budget - size);
+
+	_entries.emplace_front(std::move(item));
+	index.emplace(_entries.front().key, _entries.begin());
+	_size += size;
+}
+
+} // End of namespace AWE
@@ -0,0 +1,148 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AWE_RESOURCECACHE_H
+#define AWE_RESOURCECACHE_H
+
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "src/common/types.h"
+#include "src/common/readstream.h"
+
+namespace AWE {
+
+class BINArchive;
+
+/*!
+ * \brief Least recently used cache for decoded resources
+ *
+ * The cache keeps the data of resources as shared immutable buffers up to a
+ * byte budget. When the budget is exceeded, the least recently used buffers
+ * are evicted. Buffers which are still in use when they are evicted stay
+ * valid until the last stream using them is destroyed. All methods can be
+ * called from multiple threads at once.
+ *
+ * Besides raw resource data, the cache also keeps decoded bin archives,
+ * which share the budget with the resource data but use their own keys.
+ */
+class ResourceCache : Common::Noncopyable {
+public:
+	struct Entry {
+		std::shared_ptr<const byte[]> data;
+		size_t size;
+	};
+
+	struct Statistics {
+		size_t hits;
+		size_t misses;
+		size_t evictions;
+		size_t entries;
+		size_t size;
+		size_t budget;
+	};
+
+	explicit ResourceCache(size_t budget = 0);
+
+	/*!
+	 * Set the maximum number of bytes held by the cache, evicting entries
+	 * if necessary. A budget of 0 disables the cache.
+	 * \param budget The budget in bytes
+	 */
+	void setBudget(size_t budget);
+
+	/*!
+	 * Check if the cache is enabled by a budget greater than 0
+	 * \return If the cache is enabled
+	 */
+	bool isEnabled() const;
+
+	/*!
+	 * Find an entry and mark it as most recently used
+	 * \param key The key of the resource
+	 * \return The entry or nothing if it is not cached
+	 */
+	std::optional<Entry> find(const std::string &key);
+
+	/*!
+	 * Read a stream completely into a shared buffer and insert it into the
+	 * cache. Streams larger than the budget are not cached. If the stream
+	 * can't be read completely, an exception is thrown and nothing is cached.
+	 * \param key The key of the resource
+	 * \param stream The stream to read from its beginning
+	 * \return The entry containing the data of the stream
+	 */
+	Entry insert(const std::string &key, Common::ReadStream &stream);
+
+	/*!
+	 * Find a decoded bin archive and mark it as most recently used
+	 * \param key The key of the bin archive
+	 * \return The bin archive or nullptr if it is not cached
+	 */
+	std::shared_ptr<BINArchive> findArchive(const std::string &key);
+
+	/*!
+	 * Insert a decoded bin archive into the cache. Archives larger than the
+	 * budget are not cached.
+	 * \param key The key of the bin archive
+	 * \param archive The bin archive to insert
+	 * \param size The number of bytes to account for the archive
+	 */
+	void insertArchive(const std::string &key, std::shared_ptr<BINArchive> archive, size_t size);
+
+	/*!
+	 * Remove all entries from the cache, the counters are kept
+	 */
+	void clear();
+
+	/*!
+	 * Get the counters and the current size of the cache
+	 * \return The statistics of the cache
+	 */
+	Statistics getStatistics() const;
+
+private:
+	struct Item {
+		std::string key;
+		Entry entry;
+		std::shared_ptr<BINArchive> archive;
+	};
+
+	typedef std::list<Item> EntryList;
+	typedef std::unordered_map<std::string, EntryList::iterator> EntryIndex;
+
+	void evict(size_t budget);
+	void insertItem(EntryIndex &index, Item item);
+
+	mutable std::mutex _access;
+	size_t _budget;
+	size_t _size;
+	size_t _hits, _misses, _evictions;
+	EntryList _entries;
+	EntryIndex _index, _archiveIndex;
+};
+
+} // End of namespace AWE
+
+#endif // AWE_RESOURCECACHE_H
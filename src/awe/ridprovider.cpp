@@ -26,7 +26,12 @@
 namespace AWE {
 
 std::string RIDProvider::getNameByRid(rid_t rid) {
-	return _resources[rid];
+	// Only look up the rid without inserting it, so that concurrent lookups are safe
+	const auto resource = _resources.find(rid);
+	if (resource == _resources.end())
+		return "";
+
+	return resource->second;
 }
 
 std::vector<rid_t> RIDProvider::getRIDs() {
@@ -2,24 +2,117 @@
 // Created by patrick on 03.11.23.
 //
 
+#include <cstring>
+
 #include <filesystem>
+#include <memory>
 #include <numeric>
+#include <type_traits>
+
+#include <spdlog/spdlog.h>
 
 #include "src/common/exception.h"
-#include "src/common/memwritestream.h"
+#include "src/common/fnv1a.h"
+#include "src/common/mappedfile.h"
 #include "src/common/memreadstream.h"
 #include "src/common/readfile.h"
 #include "src/common/writefile.h"
 #include "src/common/lz4.h"
 #include "src/common/strutil.h"
+#include "src/common/threadpool.h"
 
 #include "src/awe/rmdblobarchive.h"
 
 static const uint32_t kRTOC = MKTAG('R', 'T', 'O', 'C');
+static const uint32_t kRTCC = MKTAG('R', 'T', 'C', 'C');
+
+static const uint32_t kTocCacheVersion = 2;
 
 namespace AWE {
 
-RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &path) {
+/*!
+ * Hash the complete contents of the rmdtoc file for keying the toc cache
+ */
+static uint64_t hashRMDToc(Common::ReadStream &rmdtoc) {
+	uint64_t hash = Common::kFNV1a64Offset;
+
+	std::vector<byte> buffer(65536);
+	for (size_t offset = 0; offset < rmdtoc.size(); offset += buffer.size()) {
+		const auto readSize = rmdtoc.readAt(offset, buffer.data(), buffer.size());
+		hash = Common::fnv1a64(buffer.data(), readSize, hash);
+	}
+
+	return hash;
+}
+
+RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &path, const std::string &cacheFile) {
+	TocHeader key{};
+	key.magic = kRTCC;
+	key.version = kTocCacheVersion;
+
+	if (!cacheFile.empty()) {
+		key.rmdtocSize = rmdtoc.size();
+		key.rmdtocHash = hashRMDToc(rmdtoc);
+	}
+
+	loadToc([&]() -> Common::ReadStream & { return rmdtoc; }, cacheFile, key);
+	openBlobs(path);
+}
+
+RMDBlobArchive::RMDBlobArchive(const std::string &rmdtocFile, const std::string &cacheFile, bool verifyHash) {
+	TocHeader key{};
+	key.magic = kRTCC;
+	key.version = kTocCacheVersion;
+
+	// The rmdtoc file is only opened if its contents are actually needed
+	std::unique_ptr<Common::ReadFile> rmdtoc;
+	const auto getTocStream = [&]() -> Common::ReadStream & {
+		if (!rmdtoc)
+			rmdtoc = std::make_unique<Common::ReadFile>(rmdtocFile);
+		return *rmdtoc;
+	};
+
+	if (!cacheFile.empty()) {
+		key.rmdtocSize = std::filesystem::file_size(rmdtocFile);
+		key.rmdtocTime = std::filesystem::last_write_time(rmdtocFile).time_since_epoch().count();
+		if (verifyHash)
+			key.rmdtocHash = hashRMDToc(getTocStream());
+	}
+
+	loadToc(getTocStream, cacheFile, key);
+	openBlobs(std::filesystem::path(rmdtocFile).parent_path().string());
+}
+
+void RMDBlobArchive::loadToc(
+	const std::function<Common::ReadStream &()> &getTocStream,
+	const std::string &cacheFile,
+	const TocHeader &key
+) {
+	if (!cacheFile.empty() && loadTocCache(cacheFile, key))
+		return;
+
+	parseToc(getTocStream(), key);
+	assignTables(_toc);
+
+	if (!cacheFile.empty())
+		writeTocCache(cacheFile);
+}
+
+void RMDBlobArchive::openBlobs(const std::string &path) {
+	for (const auto &blob: _blobs) {
+		const auto blobPath = std::filesystem::path(getName(blob.nameOffset, blob.nameSize)).filename().string();
+
+		_blobStreams.emplace_back(
+			std::make_unique<Common::ReadFile>(
+				path.empty()
+					? blobPath
+					: std::format("{}/{}", path, blobPath)
+			)
+		);
+	}
+}
+
+void RMDBlobArchive::parseToc(Common::ReadStream &rmdtoc, TocHeader header) {
 	const auto magic = rmdtoc.readUint32LE();
 	if (magic != kRTOC)
 		throw CreateException("Invalid RMDToc magic id, expected 0x{:X}, found 0x{:X}", kRTOC, magic);
@@ -48,7 +141,9 @@ RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &pa
 	const auto compressionTableOffset = rmdtoc.readUint32LE();
 	const auto compressionTableSize   = rmdtoc.readUint32LE();
 
-	Common::DynamicMemoryWriteStream tocData(false);
+	// The chunks are decompressed directly behind each other into one buffer
+	std::vector<byte> tocData;
+	std::vector<byte> compressedData;
 
 	rmdtoc.seek(blobTableOffset);
 	for (unsigned int i = 0; i < blobTableSize / 16; ++i) {
@@ -61,50 +156,40 @@ RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &pa
 
 		assert(compressionHint == 16);
 
-		const auto compressedData = new byte[compressedSize];
-
-		const auto lastPos = rmdtoc.pos();
-		rmdtoc.seek(dataOffset);
-		rmdtoc.read(compressedData, compressedSize);
-
-		std::unique_ptr<Common::ReadStream> chunk(Common::decompressLZ4(
-				compressedData,
-				compressedSize,
-				uncompressedSize
-		));
-		tocData.writeStream(chunk.get());
+		std::span<const byte> compressedChunk = rmdtoc.getView(dataOffset, compressedSize);
+		if (compressedChunk.empty()) {
+			compressedData.resize(compressedSize);
+			if (rmdtoc.readAt(dataOffset, compressedData.data(), compressedSize) != compressedSize)
+				throw CreateException("Unexpected end of RMDToc chunk at {}", dataOffset);
+			compressedChunk = compressedData;
+		}
 
-		rmdtoc.seek(lastPos);
+		const size_t chunkOffset = tocData.size();
+		tocData.resize(chunkOffset + uncompressedSize);
+		Common::decompressLZ4(compressedChunk, std::span<byte>(tocData).subspan(chunkOffset));
 	}
 
-	Common::MemoryReadStream toc(tocData.getData(), tocData.getLength(), true);
+	Common::MemoryReadStream toc(tocData.data(), tocData.size(), false);
 
 	toc.seek(nameTableOffset);
-	std::unique_ptr<Common::ReadStream> nameTable(toc.readStream(nameTableSize));
+	std::vector<byte> nameTable(nameTableSize);
+	if (toc.read(nameTable.data(), nameTable.size()) != nameTable.size())
+		throw CreateException("Name table exceeds the RMDToc data");
 
 	toc.seek(compressionTableOffset);
 	std::unique_ptr<Common::ReadStream> compressionTable(toc.readStream(compressionTableSize));
 
+	std::vector<BlobEntry> blobs(blobFilesCount);
 	toc.seek(blobFilesOffset);
-	for (unsigned int i = 0; i < blobFilesCount; ++i) {
-		const auto nameOffset = toc.readUint32LE();
-		const auto nameSize   = toc.readUint32LE();
+	for (auto &blob: blobs) {
+		blob.nameOffset = toc.readUint32LE();
+		blob.nameSize   = toc.readUint32LE();
 		toc.skip(8);
-
-		nameTable->seek(nameOffset);
-		const auto blobPath = nameTable->readFixedSizeString(nameSize);
-
-		_blobStreams.emplace_back(
-			std::make_unique<Common::ReadFile>(
-				path.empty()
-					? std::filesystem::path(blobPath).filename().string()
-					: std::format("{}/{}", path, std::filesystem::path(blobPath).filename().string())
-			)
-		);
 	}
 
-	_directories.resize(folderTableCount);
-	_files.resize(fileTableCount);
+	std::vector<DirectoryEntry> directories(folderTableCount);
+	std::vector<FileEntry> files(fileTableCount);
+	std::vector<CompressionInfo> compressionInfos;
 
 	toc.seek(folderTableOffset);
 	for (unsigned int i = 0; i < folderTableCount; ++i) {
@@ -116,24 +201,29 @@ RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &pa
 		const auto nameOffset  = toc.readUint32LE();
 		const auto nameSize    = toc.readUint32LE();
 
-		nameTable->seek(nameOffset);
-		const auto name = nameTable->readFixedSizeString(nameSize);
+		auto &directory = directories[i];
 
-		auto &directory = _directories[i];
+		if (i == 0)
+			directory.directory = -1;
 
-		if (i != 0)
-			directory.name = name;
+		// The root directory has no name
+		directory.nameOffset = nameOffset;
+		directory.nameSize = i != 0 ? nameSize : 0;
 
 		directory.lowerDirectoriesOffset = folderIndex;
 		directory.lowerDirectoriesCount = folderCount;
 		directory.filesOffset = fileIndex;
 		directory.filesCount = fileCount;
 
+		if (static_cast<size_t>(folderIndex) + folderCount > folderTableCount ||
+			static_cast<size_t>(fileIndex) + fileCount > fileTableCount)
+			throw CreateException("Directory {} exceeds the RMDToc tables", i);
+
 		for (size_t j = 0; j < folderCount; ++j) {
-			_directories[j + folderIndex].directory = i;
+			directories[j + folderIndex].directory = i;
 		}
 		for (size_t j = 0; j < fileCount; ++j) {
-			_files[j + fileIndex].directory = i;
+			files[j + fileIndex].directory = i;
 		}
 	}
 
@@ -147,17 +237,18 @@ RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &pa
 		const auto dmkpTableOffset        = toc.readUint32LE();
 		const auto dmkpTableSize          = toc.readUint32LE();
 
-		auto &file = _files[i];
+		auto &file = files[i];
 
-		nameTable->seek(nameOffset);
-		file.name = nameTable->readFixedSizeString(nameSize);
+		file.nameOffset = nameOffset;
+		file.nameSize = nameSize;
 		file.decompressedSize = decompressedSize;
 
-		const auto lastPos = toc.pos();
 		compressionTable->seek(compressionInfoOffset);
 
-		file.compressionInfo.resize(compressionInfoSize / 16);
-		for (auto &compressionInfo : file.compressionInfo) {
+		file.compressionInfoOffset = compressionInfos.size();
+		file.compressionInfoCount = compressionInfoSize / 16;
+		for (unsigned int j = 0; j < file.compressionInfoCount; ++j) {
+			CompressionInfo compressionInfo{};
 			compressionInfo.hint = compressionTable->readByte();
 			compressionInfo.blobIndex= compressionTable->readByte();
 			compressionTable->skip(1);
@@ -169,13 +260,196 @@ RMDBlobArchive::RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &pa
 			compressionInfo.uncompressedSize = compressionTable->readUint32LE();
 			compressionInfo.compressedSize = compressionTable->readUint32LE();
 
-			//fmt::print("{} {} {} {}\n", compressionInfo.blobIndex, compressionInfo.hint, compressionInfo.offset, compressionInfo.compressedSize);
+			compressionInfos.emplace_back(compressionInfo);
+		}
+ 	}
+
+	header.numCompressionInfos = compressionInfos.size();
+	header.numDirectories = directories.size();
+	header.numFiles = files.size();
+	header.numBlobs = blobs.size();
+	header.namesSize = nameTable.size();
+
+	const auto appendTable = [&](const void *data, size_t size) {
+		const auto offset = _toc.size();
+		_toc.resize(offset + size);
+		if (size > 0)
+			std::memcpy(_toc.data() + offset, data, size);
+	};
+
+	_toc.clear();
+	_toc.reserve(
+		sizeof(TocHeader) +
+		compressionInfos.size() * sizeof(CompressionInfo) +
+		directories.size() * sizeof(DirectoryEntry) +
+		files.size() * sizeof(FileEntry) +
+		blobs.size() * sizeof(BlobEntry) +
+		nameTable.size()
+	);
+	appendTable(&header, sizeof(TocHeader));
+	appendTable(compressionInfos.data(), compressionInfos.size() * sizeof(CompressionInfo));
+	appendTable(directories.data(), directories.size() * sizeof(DirectoryEntry));
+	appendTable(files.data(), files.size() * sizeof(FileEntry));
+	appendTable(blobs.data(), blobs.size() * sizeof(BlobEntry));
+	appendTable(nameTable.data(), nameTable.size());
+}
+
+bool RMDBlobArchive::loadTocCache(const std::string &cacheFile, const TocHeader &key) {
+	if (!std::filesystem::is_regular_file(cacheFile))
+		return false;
 
-			assert(compressionInfo.blobIndex<blobFilesCount);
+	try {
+		auto cache = std::make_unique<Common::MappedFile>(cacheFile);
+
+		const auto headerData = cache->getView(0, sizeof(TocHeader));
+		if (headerData.empty())
+			return false;
+
+		const auto &header = *reinterpret_cast<const TocHeader *>(headerData.data());
+		if (
+			header.magic != key.magic ||
+			header.version != key.version ||
+			header.rmdtocSize != key.rmdtocSize ||
+			header.rmdtocTime != key.rmdtocTime ||
+			(key.rmdtocHash != 0 && header.rmdtocHash != key.rmdtocHash)
+		)
+			return false;
+
+		assignTables(cache->getView(0, cache->size()));
+		_tocCache = std::move(cache);
+	} catch (const std::exception &e) {
+		spdlog::warn("Ignoring invalid toc cache {}: {}", cacheFile, e.what());
+		return false;
+	}
+
+	return true;
+}
+
+void RMDBlobArchive::writeTocCache(const std::string &cacheFile) const {
+	// Write to a temporary file first, so that no partially written cache is ever mapped
+	const auto tempFile = std::format("{}.tmp", cacheFile);
+
+	try {
+		Common::WriteFile file(tempFile);
+		file.write(_toc.data(), _toc.size());
+		file.close();
+
+		std::filesystem::rename(tempFile, cacheFile);
+	} catch (const std::exception &e) {
+		spdlog::warn("Failed to write toc cache {}: {}", cacheFile, e.what());
+	}
+}
+
+void RMDBlobArchive::assignTables(std::span<const byte> toc) {
+	static_assert(std::is_trivially_copyable_v<TocHeader>);
+	static_assert(std::is_trivially_copyable_v<CompressionInfo>);
+	static_assert(std::is_trivially_copyable_v<DirectoryEntry>);
+	static_assert(std::is_trivially_copyable_v<FileEntry>);
+	static_assert(std::is_trivially_copyable_v<BlobEntry>);
+	static_assert(sizeof(TocHeader) % alignof(CompressionInfo) == 0);
+
+	if (toc.size() < sizeof(TocHeader))
+		throw CreateException("Flat toc is too small");
+
+	const auto &header = *reinterpret_cast<const TocHeader *>(toc.data());
+
+	const size_t compressionInfosOffset = sizeof(TocHeader);
+	const size_t directoriesOffset = compressionInfosOffset + header.numCompressionInfos * sizeof(CompressionInfo);
+	const size_t filesOffset = directoriesOffset + header.numDirectories * sizeof(DirectoryEntry);
+	const size_t blobsOffset = filesOffset + header.numFiles * sizeof(FileEntry);
+	const size_t namesOffset = blobsOffset + header.numBlobs * sizeof(BlobEntry);
+
+	if (namesOffset + header.namesSize != toc.size())
+		throw CreateException("Flat toc size mismatch, expected {} bytes, got {}", namesOffset + header.namesSize, toc.size());
+
+	if (header.numDirectories == 0)
+		throw CreateException("Flat toc contains no root directory");
+
+	_compressionInfos = std::span(
+		reinterpret_cast<const CompressionInfo *>(toc.data() + compressionInfosOffset),
+		header.numCompressionInfos
+	);
+	_directories = std::span(
+		reinterpret_cast<const DirectoryEntry *>(toc.data() + directoriesOffset),
+		header.numDirectories
+	);
+	_files = std::span(
+		reinterpret_cast<const FileEntry *>(toc.data() + filesOffset),
+		header.numFiles
+	);
+	_blobs = std::span(
+		reinterpret_cast<const BlobEntry *>(toc.data() + blobsOffset),
+		header.numBlobs
+	);
+	_names = std::string_view(
+		reinterpret_cast<const char *>(toc.data() + namesOffset),
+		header.namesSize
+	);
+
+	// Validate all references, since the flat toc might come from a cache file
+	const auto checkName = [&](uint32_t offset, uint32_t size) {
+		if (static_cast<size_t>(offset) + size > _names.size())
+			throw CreateException("Name exceeds the name table");
+	};
+
+	for (const auto &compressionInfo: _compressionInfos) {
+		if (compressionInfo.blobIndex >= _blobs.size())
+			throw CreateException("Invalid blob index {}", compressionInfo.blobIndex);
+	}
+
+	for (size_t i = 0; i < _directories.size(); ++i) {
+		const auto &directory = _directories[i];
+		checkName(directory.nameOffset, directory.nameSize);
+		if (
+			(i != 0 && (directory.directory < 0 || static_cast<size_t>(directory.directory) >= _directories.size())) ||
+			static_cast<size_t>(directory.lowerDirectoriesOffset) + directory.lowerDirectoriesCount > _directories.size() ||
+			static_cast<size_t>(directory.filesOffset) + directory.filesCount > _files.size()
+		)
+			throw CreateException("Directory {} exceeds the toc tables", i);
+	}
+
+	if (!_directories.empty() && _directories.front().directory != -1)
+		throw CreateException("The first directory is not the root directory");
+
+	// Every directory has to lead to the root directory, otherwise resolving its path would never finish
+	enum class DirectoryState : byte { kUnchecked, kChecking, kReachesRoot };
+	std::vector<DirectoryState> directoryStates(_directories.size(), DirectoryState::kUnchecked);
+	if (!directoryStates.empty())
+		directoryStates[0] = DirectoryState::kReachesRoot;
+
+	std::vector<size_t> chain;
+	for (size_t i = 0; i < _directories.size(); ++i) {
+		size_t current = i;
+		chain.clear();
+		while (directoryStates[current] == DirectoryState::kUnchecked) {
+			directoryStates[current] = DirectoryState::kChecking;
+			chain.emplace_back(current);
+			current = _directories[current].directory;
 		}
 
-		toc.seek(lastPos);
- 	}
+		if (directoryStates[current] == DirectoryState::kChecking)
+			throw CreateException("Directory {} is part of a cycle", current);
+
+		for (const auto directory : chain)
+			directoryStates[directory] = DirectoryState::kReachesRoot;
+	}
+
+	for (size_t i = 0; i < _files.size(); ++i) {
+		const auto &file = _files[i];
+		checkName(file.nameOffset, file.nameSize);
+		if (
+			file.directory >= _directories.size() ||
+			static_cast<size_t>(file.compressionInfoOffset) + file.compressionInfoCount > _compressionInfos.size()
+		)
+			throw CreateException("File {} exceeds the toc tables", i);
+	}
+
+	for (const auto &blob: _blobs)
+		checkName(blob.nameOffset, blob.nameSize);
+}
+
+std::string_view RMDBlobArchive::getName(uint32_t offset, uint32_t size) const {
+	return _names.substr(offset, size);
 }
 
 size_t RMDBlobArchive::getNumResources() const {
@@ -193,14 +467,17 @@ std::vector<size_t> RMDBlobArchive::getDirectoryResources(const std::string &dir
 }
 
 std::string RMDBlobArchive::getResourcePath(size_t index) const {
-	FileEntry file = _files.at(index);
+	if (index >= _files.size())
+		throw CreateException("Invalid resource index {}", index);
+
+	const FileEntry &file = _files[index];
 
-	std::string path = file.name;
+	std::string path(getName(file.nameOffset, file.nameSize));
 
-	DirectoryEntry currentDir = _directories[file.directory];
-	while (currentDir.directory != -1) {
-		path = std::format("{}/{}", currentDir.name, path);
-		currentDir = _directories[currentDir.directory];
+	const DirectoryEntry *currentDir = &_directories[file.directory];
+	while (currentDir->directory != -1) {
+		path = std::format("{}/{}", getName(currentDir->nameOffset, currentDir->nameSize), path);
+		currentDir = &_directories[currentDir->directory];
 	}
 
 	return path;
@@ -215,43 +492,34 @@ Common::ReadStream *RMDBlobArchive::getResource(const std::string &rid) const {
 	if (!entry)
 		return nullptr;
 
-	auto writeStream = Common::DynamicMemoryWriteStream(false);
-	for (const auto &info: entry->compressionInfo) {
-		auto &blobStream = _blobStreams.at(info.blobIndex);
-
-		blobStream->seek(info.offset);
+	return readFile(*entry);
+}
 
-		switch (info.hint) {
-			case 0: {
-				std::vector<byte> data(info.uncompressedSize);
-				blobStream->read(data.data(), data.size());
+Common::ReadStream *RMDBlobArchive::getResourceByIndex(size_t index) const {
+	if (index >= _files.size())
+		return nullptr;
 
-				writeStream.write(data.data(), data.size());
-				break;
-			}
+	return readFile(_files[index]);
+}
 
-			case 16: {
-				std::vector<byte> data(info.compressedSize);
-				blobStream->read(data.data(), data.size());
+Common::ReadStream *RMDBlobArchive::readFile(const FileEntry &entry) const {
+	const auto chunks = _compressionInfos.subspan(entry.compressionInfoOffset, entry.compressionInfoCount);
 
-				std::unique_ptr<Common::ReadStream> decompressed(
-						Common::decompressLZ4(
-								data.data(),
-								data.size(),
-								info.uncompressedSize
-						)
-				);
-				writeStream.writeStream(decompressed.get());
+	std::vector<size_t> chunkOffsets(chunks.size());
+	size_t size = 0;
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		chunkOffsets[i] = size;
+		size += chunks[i].uncompressedSize;
+	}
 
-				break;
-			}
+	std::unique_ptr<byte[]> data(new byte[size]);
 
-			default:
-				throw CreateException("Invalid compression hint {}", info.hint);
-		}
-	}
+	// Every chunk has a known place in the output, so they can be decompressed independently
+	Threads.parallelFor(chunks.size(), [&](size_t index) {
+		decompressChunk(chunks[index], data.get() + chunkOffsets[index]);
+	});
 
-	return new Common::MemoryReadStream(writeStream.getData(), writeStream.getLength());
+	return new Common::MemoryReadStream(data.release(), size);
 }
 
 bool RMDBlobArchive::hasResource(const std::string &rid) const {
@@ -269,16 +537,13 @@ bool RMDBlobArchive::hasDirectory(const std::string &directory) const {
 }
 
 std::optional<RMDBlobArchive::DirectoryEntry> RMDBlobArchive::findDirectoryEntry(const std::string &path) const {
-	const auto filePath = Common::split(path, std::regex("/"));
-	const auto splitPath = std::vector<std::string>(filePath.begin(), filePath.end());
-
 	DirectoryEntry currentDir = _directories.front();
-	for (const auto &part: splitPath) {
+	for (const auto part: Common::Tokenizer(path, '/')) {
 		bool found = false;
 		for (unsigned int i = 0; i < currentDir.lowerDirectoriesCount; ++i) {
-			DirectoryEntry potentialDir = _directories[i + currentDir.lowerDirectoriesOffset];
+			const DirectoryEntry &potentialDir = _directories[i + currentDir.lowerDirectoriesOffset];
 
-			if (potentialDir.name == part) {
+			if (getName(potentialDir.nameOffset, potentialDir.nameSize) == part) {
 				currentDir = potentialDir;
 				found = true;
 				break;
@@ -297,13 +562,55 @@ std::optional<RMDBlobArchive::FileEntry> RMDBlobArchive::findFileEntry(
 		const RMDBlobArchive::DirectoryEntry& dir
 ) const {
 	for (unsigned int i = 0; i < dir.filesCount; ++i) {
-		FileEntry currentFile = _files[i + dir.filesOffset];
+		const FileEntry &currentFile = _files[i + dir.filesOffset];
 
-		if (currentFile.name == fileName)
+		if (getName(currentFile.nameOffset, currentFile.nameSize) == fileName)
 			return currentFile;
 	}
 
 	return {};
 }
 
+void RMDBlobArchive::decompressChunk(const CompressionInfo &info, byte *output) const {
+	switch (info.hint) {
+		case 0:
+			readBlob(info.blobIndex, info.offset, output, info.uncompressedSize);
+			break;
+
+		case 16: {
+			const std::span<byte> outputSpan(output, info.uncompressedSize);
+
+			// Decompress directly out of memory backed blobs, without reading the compressed data first
+			const auto view = _blobStreams.at(info.blobIndex)->getView(info.offset, info.compressedSize);
+			if (!view.empty()) {
+				Common::decompressLZ4(view, outputSpan);
+				break;
+			}
+
+			std::vector<byte> compressedData(info.compressedSize);
+			readBlob(info.blobIndex, info.offset, compressedData.data(), compressedData.size());
+			Common::decompressLZ4(compressedData, outputSpan);
+			break;
+		}
+
+		default:
+			throw CreateException("Invalid compression hint {}", info.hint);
+	}
+}
+
+void RMDBlobArchive::readBlob(size_t blobIndex, size_t offset, byte *data, size_t length) const {
+	auto &blobStream = _blobStreams.at(blobIndex);
+
+	size_t readSize;
+	if (blobStream->isConcurrent()) {
+		readSize = blobStream->readAt(offset, data, length);
+	} else {
+		std::lock_guard<std::mutex> l(_blobMutex);
+		readSize = blobStream->readAt(offset, data, length);
+	}
+
+	if (readSize != length)
+		throw CreateException("Unexpected end of blob {}, expected {} bytes, got {}", blobIndex, length, readSize);
+}
+
 } // End of namespace AWE
\ No newline at end of file
@@ -21,7 +21,11 @@
 #ifndef OPENAWE_RMDBLOBARCHIVE_H
 #define OPENAWE_RMDBLOBARCHIVE_H
 
+#include <functional>
 #include <optional>
+#include <mutex>
+#include <span>
+#include <string_view>
 
 #include "src/awe/archive.h"
 
@@ -44,15 +48,34 @@ namespace AWE {
  * \remark It is not intended to implement the games utilizing thifs format
  * anytime soon, this class was written for research purposes.
  */
-class RMDBlobArchive : Archive {
+class RMDBlobArchive : public Archive {
 public:
 	/*!
 	 * Create a new RMDBlob archive instance and load the data from the
-	 * rmdtoc file to fill the appropriate tables
+	 * rmdtoc file to fill the appropriate tables. If a cache file is given,
+	 * the parsed tables are stored in it in a flat layout and are directly
+	 * mapped into memory on the next load instead of parsing the rmdtoc
+	 * file again. Since a stream has no modification time, the cache is
+	 * keyed by the size and hash of the rmdtoc data, which requires reading
+	 * it completely.
 	 * \param rmdtoc A stream from the rmdtoc file
 	 * \param path The path of the rmdtoc file to help find the corresponding blob files
+	 * \param cacheFile An optional path to the toc cache file, empty to disable caching
 	 */
-	RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &path);
+	RMDBlobArchive(Common::ReadStream &rmdtoc, const std::string &path, const std::string &cacheFile = "");
+
+	/*!
+	 * Create a new RMDBlob archive instance from a rmdtoc file. If a cache
+	 * file is given, it is keyed by the size and modification time of the
+	 * rmdtoc file, so that a matching cache is used without opening the
+	 * rmdtoc file at all. Optionally the hash of the rmdtoc contents is
+	 * checked as well, which detects changes keeping size and modification
+	 * time, at the cost of reading the whole rmdtoc file.
+	 * \param rmdtocFile The path of the rmdtoc file, the blob files are searched next to it
+	 * \param cacheFile An optional path to the toc cache file, empty to disable caching
+	 * \param verifyHash If the cache should also be keyed by the hash of the rmdtoc contents
+	 */
+	explicit RMDBlobArchive(const std::string &rmdtocFile, const std::string &cacheFile = "", bool verifyHash = false);
 
 	/*!
 	 * Get the number of resources contained in this file
@@ -76,13 +99,25 @@ public:
 
 	/*!
 	 * Get a stream to the resource given by a path. Returns a null pointer
-	 * if the resource is not found
+	 * if the resource is not found. The compressed chunks of the resource
+	 * are decompressed in parallel directly into one output buffer. This
+	 * method can be called from multiple threads at once.
 	 * \param rid The path of the resource to get
 	 * \return A pointer to a valid readstream of the resource or a null pointer
 	 * if the reosurce is not found
 	 */
 	Common::ReadStream *getResource(const std::string &rid) const override;
 
+	/*!
+	 * Get a stream to the resource given by its index in the file table,
+	 * without looking up its path. This method can be called from multiple
+	 * threads at once.
+	 * \param index The index of the resource
+	 * \return A pointer to a valid readstream of the resource or a null pointer
+	 * if the index is invalid
+	 */
+	Common::ReadStream *getResourceByIndex(size_t index) const override;
+
 	/*!
 	 * Return if a certain directory exists in the archive
 	 * \param rid The path to the files
@@ -98,30 +133,108 @@ public:
 	bool hasDirectory(const std::string &directory) const override;
 
 private:
+	/*
+	 * The following structures are stored as is in the flat toc buffer and
+	 * the toc cache file, so they have to stay trivially copyable. Names are
+	 * referenced by offset and size into the name table of the rmdtoc file.
+	 */
+	struct TocHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t rmdtocSize;
+		int64_t rmdtocTime;
+		uint64_t rmdtocHash;
+		uint32_t numCompressionInfos;
+		uint32_t numDirectories;
+		uint32_t numFiles;
+		uint32_t numBlobs;
+		uint32_t namesSize;
+		uint32_t padding;
+	};
+
 	struct CompressionInfo {
+		uint64_t offset;
+		uint32_t compressedSize;
+		uint32_t uncompressedSize;
 		byte blobIndex;
 		byte hint;
-		unsigned long offset;
-		unsigned int compressedSize;
-		unsigned int uncompressedSize;
 	};
 
 	struct DirectoryEntry {
-		int directory{-1};
-		unsigned int lowerDirectoriesOffset;
-		unsigned int lowerDirectoriesCount;
-		unsigned int filesOffset;
-		unsigned int filesCount;
-		std::string name;
+		int32_t directory;
+		uint32_t lowerDirectoriesOffset;
+		uint32_t lowerDirectoriesCount;
+		uint32_t filesOffset;
+		uint32_t filesCount;
+		uint32_t nameOffset;
+		uint32_t nameSize;
 	};
 
 	struct FileEntry {
-		std::vector<CompressionInfo> compressionInfo;
-		unsigned int decompressedSize;
-		unsigned int directory;
-		std::string name;
+		uint32_t compressionInfoOffset;
+		uint32_t compressionInfoCount;
+		uint32_t decompressedSize;
+		uint32_t directory;
+		uint32_t nameOffset;
+		uint32_t nameSize;
+	};
+
+	struct BlobEntry {
+		uint32_t nameOffset;
+		uint32_t nameSize;
 	};
 
+	/*!
+	 * Load the tables either from the toc cache file or by parsing the rmdtoc file
+	 * \param getTocStream Returns the stream of the rmdtoc file, only called if the cache can not be used
+	 * \param cacheFile The path of the toc cache file, empty to disable caching
+	 * \param key The header containing the expected version and rmdtoc size, time and hash
+	 */
+	void loadToc(const std::function<Common::ReadStream &()> &getTocStream, const std::string &cacheFile, const TocHeader &key);
+
+	/*!
+	 * Open the blob files referenced by the toc
+	 * \param path The directory containing the blob files
+	 */
+	void openBlobs(const std::string &path);
+
+	/*!
+	 * Parse the rmdtoc file and store its tables in the flat toc buffer
+	 * \param rmdtoc The stream of the rmdtoc file
+	 * \param header The header of the flat toc, which gets completed by this method
+	 */
+	void parseToc(Common::ReadStream &rmdtoc, TocHeader header);
+
+	/*!
+	 * Try to map a toc cache file and use its tables, if it matches the key
+	 * \param cacheFile The path of the toc cache file
+	 * \param key The header containing the expected version and rmdtoc size, time and hash. A hash of zero
+	 * means, that the hash is not checked
+	 * \return If the cache file was valid and is used
+	 */
+	bool loadTocCache(const std::string &cacheFile, const TocHeader &key);
+
+	/*!
+	 * Write the flat toc buffer to a toc cache file
+	 * \param cacheFile The path of the toc cache file
+	 */
+	void writeTocCache(const std::string &cacheFile) const;
+
+	/*!
+	 * Check the tables in a flat toc for consistency and point the table views
+	 * of this archive to them
+	 * \param toc The flat toc data, which has to outlive the archive
+	 */
+	void assignTables(std::span<const byte> toc);
+
+	/*!
+	 * Get a name from the name table
+	 * \param offset The offset of the name in the name table
+	 * \param size The size of the name
+	 * \return A view to the name
+	 */
+	std::string_view getName(uint32_t offset, uint32_t size) const;
+
 	/*!
 	 * Find the directory entry for a certain path which might not exist
 	 * \param path The path to find
@@ -140,9 +253,42 @@ private:
 		const DirectoryEntry& dir
 	) const;
 
-	std::vector<DirectoryEntry> _directories;
-	std::vector<FileEntry> _files;
+	/*!
+	 * Read and decompress all chunks of a file into one buffer
+	 * \param entry The file entry to read
+	 * \return A stream owning the decompressed data
+	 */
+	Common::ReadStream *readFile(const FileEntry &entry) const;
+
+	/*!
+	 * Read and decompress a single chunk of a file into its final place in
+	 * the output buffer
+	 * \param info The compression info of the chunk
+	 * \param output The pointer to the output buffer at the chunks offset
+	 */
+	void decompressChunk(const CompressionInfo &info, byte *output) const;
+
+	/*!
+	 * Read raw data from one of the blob files at an absolute offset. If the
+	 * blob stream does not support concurrent reads, the read is serialized.
+	 * \param blobIndex The index of the blob file to read from
+	 * \param offset The absolute offset in the blob file
+	 * \param data The buffer to read the data into
+	 * \param length The number of bytes to read
+	 */
+	void readBlob(size_t blobIndex, size_t offset, byte *data, size_t length) const;
+
+	std::vector<byte> _toc;
+	std::unique_ptr<Common::ReadStream> _tocCache;
+
+	std::span<const CompressionInfo> _compressionInfos;
+	std::span<const DirectoryEntry> _directories;
+	std::span<const FileEntry> _files;
+	std::span<const BlobEntry> _blobs;
+	std::string_view _names;
+
 	std::vector<std::unique_ptr<Common::ReadStream>> _blobStreams;
+	mutable std::mutex _blobMutex;
 
 	std::vector<std::unique_ptr<Common::ReadStream>> _streams;
 };
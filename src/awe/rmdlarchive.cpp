@@ -48,6 +48,11 @@ size_t RMDLArchive::getNumResources() const {
 Common::ReadStream *RMDLArchive::getResource(const std::string &rid) const {
 	for (const auto &entry : _fileEntries) {
 		if (entry.name == rid) {
+			// Return a view, if the archive is backed by memory
+			const auto view = _stream.getView(entry.offset, entry.size);
+			if (!view.empty())
+				return new Common::MemoryReadStream(view.data(), view.size());
+
 			byte *data = new byte[entry.size];
 
 			_stream.seek(entry.offset);
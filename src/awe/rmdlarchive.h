@@ -46,7 +46,9 @@ namespace AWE {
 class RMDLArchive : public Archive {
 public:
 	/*!
-	 * Load a rmdl archive from the specified stream
+	 * Load a rmdl archive from the specified stream. If the stream is
+	 * backed by memory, resources are returned as views into it and must
+	 * not outlive the stream.
 	 *
 	 * \param bin the stream to load from
 	 */
@@ -22,8 +22,8 @@
 #include <cassert>
 #include <algorithm>
 #include <optional>
-#include <regex>
 #include <vector>
+#include <queue>
 #include <mutex>
 
 #include "src/common/endianreadstream.h"
@@ -31,10 +31,13 @@
 #include "src/common/memreadstream.h"
 #include "src/common/exception.h"
 #include "src/common/crc32.h"
+#include "src/common/fnv1a.h"
 
 #include "src/awe/path.h"
 #include "src/awe/rmdparchive.h"
 
+static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF;
+
 enum kArchiveVersion {
 	kVersionAlanWake = 2,
 	kVersionNightmare = 7,
@@ -44,7 +47,7 @@ enum kArchiveVersion {
 
 namespace AWE {
 
-RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _rmdp(rmdp) {
+RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _rmdp(rmdp), _verifyData(false) {
 	_littleEndian = bin->readByte() == 0;
 	Common::EndianReadStream end = Common::EndianReadStream(bin, !_littleEndian);
 
@@ -68,6 +71,8 @@ RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _r
 	}
 
 	delete bin;
+
+	buildPathIndex();
 }
 
 size_t RMDPArchive::getNumResources() const {
@@ -75,66 +80,165 @@ size_t RMDPArchive::getNumResources() const {
 }
 
 std::vector<uint32_t> RMDPArchive::getPathHashes(const std::string &path) const {
-	std::vector<std::string> pathNames = Common::split(path, std::regex("/"));
 	std::vector<uint32_t> pathHashes;
-	pathHashes.resize(pathNames.size());
-
-	for (uint64_t i = 0; i < pathNames.size(); ++i)
-		pathHashes[i] = Common::crc32(pathNames[i]);
+	for (const auto pathName : Common::Tokenizer(path, '/'))
+		pathHashes.emplace_back(Common::crc32(pathName));
 
 	return pathHashes;
 }
 
-std::optional<RMDPArchive::FolderEntry> RMDPArchive::findDirectory(const std::vector<uint32_t> &pathHashes) const {
-	FolderEntry folder = _folderEntries.front();
-	if (pathHashes.empty()) return folder;
+std::optional<size_t> RMDPArchive::findDirectory(const std::vector<uint32_t> &pathHashes) const {
+	if (_folderEntries.empty())
+		return {};
 
+	size_t folderIndex = 0;
 	for (uint32_t nameHash : pathHashes) {
+		const FolderEntry &folder = _folderEntries[folderIndex];
 		if (folder.nextLowerFolder == -1)
 			return {};
 
-		folder = _folderEntries[folder.nextLowerFolder];
+		folderIndex = folder.nextLowerFolder;
 
-		while (nameHash != folder.nameHash) {
-			if (folder.nextNeighbourFolder == -1)
+		while (nameHash != _folderEntries[folderIndex].nameHash) {
+			if (_folderEntries[folderIndex].nextNeighbourFolder == -1)
 				return {};
-			folder = _folderEntries[folder.nextNeighbourFolder];
+			folderIndex = _folderEntries[folderIndex].nextNeighbourFolder;
 		}
 	}
 
-	return folder;
+	return folderIndex;
 }
 
-std::optional<RMDPArchive::FileEntry> RMDPArchive::findFile(const FolderEntry &folder, const uint32_t nameHash) const {
+std::optional<size_t> RMDPArchive::findFile(const FolderEntry &folder, const uint32_t nameHash) const {
 	if (folder.nextFile == -1)
 		return {};
-	FileEntry file = _fileEntries[folder.nextFile];
 
-	while (file.nameHash != nameHash) {
-		if (file.nextFile == -1)
+	size_t fileIndex = folder.nextFile;
+	while (_fileEntries[fileIndex].nameHash != nameHash) {
+		if (_fileEntries[fileIndex].nextFile == -1)
+			return {};
+		fileIndex = _fileEntries[fileIndex].nextFile;
+	}
+
+	return fileIndex;
+}
+
+void RMDPArchive::buildPathIndex() {
+	size_t capacity = 16;
+	while (capacity < _fileEntries.size() * 2)
+		capacity <<= 1;
+
+	_pathIndex.assign(capacity, {0, kInvalidIndex});
+
+	if (_folderEntries.empty())
+		return;
+
+	std::vector<bool> visitedFolders(_folderEntries.size(), false);
+	std::queue<std::pair<int64_t, std::string>> folders;
+	folders.emplace(0, "");
+
+	while (!folders.empty()) {
+		const auto [folderIndex, prefix] = std::move(folders.front());
+		folders.pop();
+
+		if (folderIndex < 0 || static_cast<size_t>(folderIndex) >= _folderEntries.size())
+			throw CreateException("Invalid folder index {}", folderIndex);
+		if (visitedFolders[folderIndex])
+			continue;
+		visitedFolders[folderIndex] = true;
+
+		const FolderEntry &folder = _folderEntries[folderIndex];
+
+		// Add all files of this folder, guarding against cycles in the file list
+		int64_t fileIndex = folder.nextFile;
+		for (size_t i = 0; fileIndex != -1 && i < _fileEntries.size(); ++i) {
+			if (fileIndex < 0 || static_cast<size_t>(fileIndex) >= _fileEntries.size())
+				throw CreateException("Invalid file index {}", fileIndex);
+
+			const FileEntry &file = _fileEntries[fileIndex];
+			insertPathIndex(prefix + Common::toLower(file.name), fileIndex);
+			fileIndex = file.nextFile;
+		}
+
+		// Queue all direct sub folders in the order of their list
+		int64_t subFolderIndex = folder.nextLowerFolder;
+		for (size_t i = 0; subFolderIndex != -1 && i < _folderEntries.size(); ++i) {
+			if (subFolderIndex < 0 || static_cast<size_t>(subFolderIndex) >= _folderEntries.size())
+				throw CreateException("Invalid folder index {}", subFolderIndex);
+
+			const FolderEntry &subFolder = _folderEntries[subFolderIndex];
+			folders.emplace(subFolderIndex, prefix + Common::toLower(subFolder.name) + "/");
+			subFolderIndex = subFolder.nextNeighbourFolder;
+		}
+	}
+}
+
+void RMDPArchive::insertPathIndex(std::string_view path, uint32_t fileIndex) {
+	const uint64_t hash = Common::fnv1a64(path);
+	const size_t mask = _pathIndex.size() - 1;
+
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		auto &entry = _pathIndex[i];
+
+		// Keep the first file found for a path, like the linked list lookup does
+		if (entry.fileIndex != kInvalidIndex && entry.pathHash == hash)
+			return;
+
+		if (entry.fileIndex == kInvalidIndex) {
+			entry.pathHash = hash;
+			entry.fileIndex = fileIndex;
+			return;
+		}
+	}
+}
+
+std::optional<size_t> RMDPArchive::findResource(std::string_view rid) const {
+	const uint64_t hash = Common::fnv1a64(rid);
+	const size_t mask = _pathIndex.size() - 1;
+
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		const auto &entry = _pathIndex[i];
+
+		if (entry.fileIndex == kInvalidIndex)
 			return {};
-		file = _fileEntries[file.nextFile];
+
+		if (entry.pathHash == hash)
+			return entry.fileIndex;
 	}
-	return file;
+}
+
+std::optional<size_t> RMDPArchive::findResourceInTree(const std::string &rid) const {
+	// Extract and separate file name from the rest of the path
+	auto pathHashes = getPathHashes(rid);
+	if (pathHashes.empty())
+		return {};
+
+	uint32_t fileHash = pathHashes.back();
+	pathHashes.pop_back();
+
+	const auto folderIndex = findDirectory(pathHashes);
+	if (!folderIndex)
+		return {};
+
+	return findFile(_folderEntries[*folderIndex], fileHash);
 }
 
 std::vector<size_t> RMDPArchive::getDirectoryResources(const std::string &directory) {
 	auto pathHashes = getPathHashes(directory);
 
-	auto maybeFolder = findDirectory(pathHashes);
-	if (!maybeFolder) return {};
-	FolderEntry folder = *maybeFolder;
+	const auto folderIndex = findDirectory(pathHashes);
+	if (!folderIndex)
+		return {};
 
+	const FolderEntry &folder = _folderEntries[*folderIndex];
 	if (folder.nextFile == -1)
 		return {};
 
 	std::vector<size_t> indices;
-	FileEntry file = _fileEntries[folder.nextFile];
-	indices.emplace_back(folder.nextFile);
-
-	while (file.nextFile != -1) {
-		indices.emplace_back(file.nextFile);
-		file = _fileEntries[file.nextFile];
+	int64_t fileIndex = folder.nextFile;
+	while (fileIndex != -1) {
+		indices.emplace_back(fileIndex);
+		fileIndex = _fileEntries[fileIndex].nextFile;
 	}
 
 	return indices;
@@ -172,51 +276,85 @@ std::string RMDPArchive::getResourcePath(size_t index) const {
 }
 
 Common::ReadStream *RMDPArchive::getResource(const std::string &rid) const {
-	std::lock_guard<std::mutex> g(_readMutex);
-
-	// Extract and separate file name from the rest of the path
-	auto pathHashes = getPathHashes(rid);
-	uint32_t fileHash = pathHashes.back();
-	pathHashes.pop_back();
+	const auto fileIndex = findResource(rid);
+	if (!fileIndex)
+		return nullptr;
 
-	const auto maybeFolder = findDirectory(pathHashes);
-	if (!maybeFolder) return nullptr;
-	FolderEntry folder = *maybeFolder;
+	return getResourceByIndex(*fileIndex);
+}
 
-	if (folder.nextFile == -1)
+Common::ReadStream *RMDPArchive::getResourceByIndex(size_t index) const {
+	if (index >= getNumResources())
 		return nullptr;
 
-	const auto maybeFile = findFile(folder, fileHash);
-	if (!maybeFile) return nullptr;
-	const FileEntry &file = *maybeFile;
+	const FileEntry &file = _fileEntries[index];
+
+	// If the archive is backed by memory, like a memory mapped file, return a view into it without copying
+	const auto view = _rmdp->getView(file.offset, file.size);
+	if (!view.empty()) {
+		if (_verifyData)
+			verifyData(index, view);
+		return new Common::MemoryReadStream(view.data(), view.size());
+	}
 
 	byte *data = new byte[file.size];
-	_rmdp->seek(file.offset);
-	_rmdp->read(data, file.size);
+	if (_rmdp->isConcurrent()) {
+		_rmdp->readAt(file.offset, data, file.size);
+	} else {
+		std::lock_guard<std::mutex> g(_readMutex);
+		_rmdp->readAt(file.offset, data, file.size);
+	}
 
-	assert(Common::crc32(data, file.size) == file.fileDataHash);
+	if (_verifyData) {
+		try {
+			verifyData(index, {data, file.size});
+		} catch (...) {
+			delete[] data;
+			throw;
+		}
+	}
 
 	return new Common::MemoryReadStream(data, file.size, true);
 }
 
-bool RMDPArchive::hasResource(const std::string &rid) const {
-	// Extract and separate file name from the rest of the path
-	auto pathHashes = getPathHashes(rid);
-	uint32_t fileHash = pathHashes.back();
-	pathHashes.pop_back();
+void RMDPArchive::setVerifyData(bool verify) {
+	_verifyData = verify;
+}
+
+void RMDPArchive::verifyData(size_t index, std::span<const byte> data) const {
+	const uint32_t hash = Common::crc32(data.data(), data.size());
+	if (hash != _fileEntries[index].fileDataHash)
+		throw CreateException(
+			"Checksum mismatch in {}, expected {:08x}, got {:08x}",
+			getResourcePath(index),
+			_fileEntries[index].fileDataHash,
+			hash
+		);
+}
+
+std::optional<Archive::ResourceRange> RMDPArchive::getResourceRange(size_t index) const {
+	if (index >= getNumResources())
+		return std::nullopt;
+
+	const FileEntry &file = _fileEntries[index];
+	return ResourceRange{file.offset, file.size};
+}
 
-	auto maybeFolder = findDirectory(pathHashes);
-	if (!maybeFolder) return false;
-	FolderEntry folder = *maybeFolder;
+void RMDPArchive::prefetch(const ResourceRange &range) const {
+	_rmdp->prefetch(range.offset, range.size);
+}
 
-	auto maybeFile = findFile(folder, fileHash);
-	return maybeFile.has_value();
+bool RMDPArchive::isMemoryBacked() const {
+	return _rmdp->size() == 0 || !_rmdp->getView(0, 1).empty();
+}
+
+bool RMDPArchive::hasResource(const std::string &rid) const {
+	return findResource(rid).has_value();
 }
 
 bool RMDPArchive::hasDirectory(const std::string &directory) const {
 	const auto pathHashes = getPathHashes(directory);
-	const auto maybeFolder = findDirectory(pathHashes);
-	return maybeFolder.has_value();
+	return findDirectory(pathHashes).has_value();
 }
 
 std::string RMDPArchive::readEntryName(Common::ReadStream *bin, int64_t offset, uint32_t nameSize) {
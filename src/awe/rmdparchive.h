@@ -25,6 +25,8 @@
 #include <memory>
 #include <optional>
 #include <mutex>
+#include <atomic>
+#include <string_view>
 
 #include "src/common/endianreadstream.h"
 #include "src/common/containers.h"
@@ -58,6 +60,15 @@ public:
 	 */
 	RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp);
 
+	/*!
+	 * Enable or disable verifying the checksum of every resource, when it is
+	 * accessed. If verification is enabled and a checksum does not match, an
+	 * exception is thrown. Verification is disabled by default.
+	 *
+	 * \param verify If resource data should be verified
+	 */
+	void setVerifyData(bool verify);
+
 	/*!
 	 * Get the number of resources contained inside this archive by simply
 	 * returning the size of the _fileEntries vector
@@ -85,18 +96,51 @@ public:
 	std::string getResourcePath(size_t index) const override;
 
 	/*!
-	 * Loads a file from the bin/rmdp archive and get the metadata by
-	 * following the indexes from folder and file entries and create
-	 * a memory stream from it.
+	 * Loads a file from the bin/rmdp archive by looking up its metadata
+	 * in the path index and create a memory stream from it. If the rmdp stream is backed by memory,
+	 * like a memory mapped file, the returned stream is a view into it
+	 * and must not outlive the archive.
 	 *
 	 * \param rid the virtual path to the resource
 	 * \return the newly created stream for the specified resource
 	 */
 	[[nodiscard]] Common::ReadStream *getResource(const std::string &rid) const override;
 
+	/*!
+	 * Loads a file from the bin/rmdp archive directly by its file index,
+	 * without any path lookup. The same restrictions as for getResource
+	 * apply to the returned stream.
+	 *
+	 * \param index the index of the file entry
+	 * \return the newly created stream for the specified resource
+	 */
+	[[nodiscard]] Common::ReadStream *getResourceByIndex(size_t index) const override;
+
+	/*!
+	 * Get the range of a resource in the rmdp file
+	 *
+	 * \param index The index of the resource
+	 * \return The offset and size of the resource in the rmdp file
+	 */
+	[[nodiscard]] std::optional<ResourceRange> getResourceRange(size_t index) const override;
+
+	/*!
+	 * Advise the rmdp stream to load a range ahead of time
+	 *
+	 * \param range The range in the rmdp file
+	 */
+	void prefetch(const ResourceRange &range) const override;
+
+	/*!
+	 * Check if the rmdp file is held in memory, like a memory mapped file
+	 *
+	 * \return If resources are views into the rmdp file
+	 */
+	[[nodiscard]] bool isMemoryBacked() const override;
+
 	/*!
 	 * Check if the file specified by rid exists inside this archive
-	 * by iterating through the tree
+	 * by looking it up in the path index
 	 *
 	 * \param rid the file to check
 	 * \return if the file given by rid exists inside this archive
@@ -111,6 +155,26 @@ public:
 	 */
 	bool hasDirectory(const std::string &directory) const override;
 
+	/*!
+	 * Find the index of a resource using the flat path index built while
+	 * loading the archive. This needs one hash of the path and usually a
+	 * single probe into the index, without any allocations.
+	 *
+	 * \param rid the virtual path to the resource
+	 * \return the index of the resource, if it exists
+	 */
+	[[nodiscard]] std::optional<size_t> findResource(std::string_view rid) const;
+
+	/*!
+	 * Find the index of a resource by walking the linked folder and file
+	 * tables of the archive. This is a lot slower than findResource and
+	 * mainly kept for verifying and benchmarking the path index.
+	 *
+	 * \param rid the virtual path to the resource
+	 * \return the index of the resource, if it exists
+	 */
+	[[nodiscard]] std::optional<size_t> findResourceInTree(const std::string &rid) const;
+
 private:
 	/*!
 	 * Load header version 2 used by Alan Wake
@@ -180,19 +244,51 @@ private:
 		uint64_t offset, size;
 	};
 
+	/*!
+	 * Entry of the flat path index, which maps the FNV-1a hash of the full
+	 * lower case path of a file to its index in _fileEntries.
+	 */
+	struct PathIndexEntry {
+		uint64_t pathHash;
+		uint32_t fileIndex;
+	};
+
 	/*!
 	 * A helper function that navigates through _folderEntries under
 	 * path given as an array of hashes.
 	 *
-	 * \return folder entry, if it exists under giver path
+	 * \return index of the folder entry, if it exists under giver path
 	 */
-	std::optional<FolderEntry> findDirectory(const std::vector<uint32_t> &pathHashes) const;
+	std::optional<size_t> findDirectory(const std::vector<uint32_t> &pathHashes) const;
 
 	/*!
 	 * A helper functon that find a file in a given folder by
 	 * its name hash value.
+	 *
+	 * \return index of the file entry, if it exists in the folder
 	 */
-	std::optional<FileEntry> findFile(const FolderEntry &folder, const uint32_t nameHash) const;
+	std::optional<size_t> findFile(const FolderEntry &folder, const uint32_t nameHash) const;
+
+	/*!
+	 * Verify the data of a resource against the checksum stored in the
+	 * archive and throw an exception if it does not match
+	 *
+	 * \param index The index of the resource
+	 * \param data The data of the resource
+	 */
+	void verifyData(size_t index, std::span<const byte> data) const;
+
+	/*!
+	 * Build the flat path index by walking the folder tree breadth first,
+	 * in the same order the linked lists are searched by findDirectory and
+	 * findFile, so that duplicate paths resolve to the same file.
+	 */
+	void buildPathIndex();
+
+	/*!
+	 * Insert a file into the path index if the path is not yet contained
+	 */
+	void insertPathIndex(std::string_view path, uint32_t fileIndex);
 
 	bool _littleEndian;
 	uint32_t _version;
@@ -200,11 +296,16 @@ private:
 	Common::Vector<FolderEntry> _folderEntries;
 	Common::Vector<FileEntry> _fileEntries;
 
+	std::vector<PathIndexEntry> _pathIndex;
+
 	std::unique_ptr<Common::ReadStream> _rmdp;
 
+	std::atomic_bool _verifyData;
+
 	/*
-	 * TODO: Currently the reading is critical sectioned allowing only one parallel read at a time in the archive. This
-	 * could be improved by creating and utilizing a fixed set of streams allowing parallel access to the archive
+	 * The tables are immutable after loading and resources are read with positional reads, so the archive can be
+	 * accessed from multiple threads at once. Only if the underlying stream does not support concurrent positional
+	 * reads, the reading is critical sectioned by this mutex.
 	 */
 	mutable std::mutex _readMutex;
 };
@@ -23,6 +23,7 @@
 #include <spdlog/spdlog.h>
 
 #include "src/common/exception.h"
+#include "src/common/profiler.h"
 
 #include "src/awe/script/bytecode.h"
 #include "src/awe/script/types.h"
@@ -40,6 +41,8 @@ bool Bytecode::hasEntryPoint(const std::string &entryPoint) {
 }
 
 void Bytecode::run(Context &context, uint32_t offset, const entt::entity &caller) {
+	PROFILE_ZONE("Run Script");
+
 	spdlog::debug("Starting script offset {}", offset);
 	_bytecode->seek(offset * 4);
 
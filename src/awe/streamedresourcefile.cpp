@@ -18,9 +18,10 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <regex>
 #include <iostream>
 
+#include "src/common/strutil.h"
+
 #include "streamedresourcefile.h"
 #include "src/awe/objectbinaryreadstreamv1.h"
 
@@ -83,8 +84,8 @@ StreamedResourceFile::StreamedResourceFile(Common::ReadStream &streamedResource)
 		);
 
 		std::string fileName = streamedResource.readNullTerminatedString();
-		fileName = std::regex_replace(fileName, std::regex("\\\\"), "/");
-		fileName = std::regex_replace(fileName, std::regex("data/"), "");
+		Common::foldSlashes(fileName);
+		Common::replaceInPlace(fileName, "data/", "");
 
 		//spdlog::trace rids[i] << " " << fileName << std::endl;
 
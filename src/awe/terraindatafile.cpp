@@ -18,9 +18,9 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bit>
 #include <stdexcept>
 #include <vector>
-#include <regex>
 
 #include <spdlog/spdlog.h>
 #include <glm/gtx/string_cast.hpp>
@@ -63,24 +63,42 @@ TerrainDataFile::TerrainDataFile(Common::ReadStream &terrainData) {
 		// Read vertices
 		const uint32_t numVertices = terrainData.readUint32LE();
 		_vertices.resize(numVertices);
-		for (auto &vertex : _vertices) {
-			vertex.position.x = terrainData.readIEEEFloatLE();
-			vertex.position.y = terrainData.readIEEEFloatLE();
-			vertex.position.z = terrainData.readIEEEFloatLE();
 
-			vertex.normal.x = static_cast<float>(terrainData.readSint16LE()) / 32767.0f;
-			vertex.normal.y = static_cast<float>(terrainData.readSint16LE()) / 32767.0f;
-			vertex.normal.z = static_cast<float>(terrainData.readSint16LE()) / 32767.0f;
+		// The vertices are stored as interleaved records, which are read in one go
+		struct VertexRecord {
+			float position[3];
+			int16_t normalAndDisplacement[4];
+		};
+		static_assert(sizeof(VertexRecord) == 20);
+
+		std::vector<VertexRecord> vertexRecords(numVertices);
+		terrainData.readSpan(std::span(vertexRecords));
+		for (size_t i = 0; i < numVertices; ++i) {
+			auto &record = vertexRecords[i];
+			if constexpr (std::endian::native == std::endian::big) {
+				Common::swapBytesArray(std::span(record.position));
+				Common::swapBytesArray(std::span(record.normalAndDisplacement));
+			}
+
+			auto &vertex = _vertices[i];
+			vertex.position.x = record.position[0];
+			vertex.position.y = record.position[1];
+			vertex.position.z = record.position[2];
+
+			vertex.normal.x = static_cast<float>(record.normalAndDisplacement[0]) / 32767.0f;
+			vertex.normal.y = static_cast<float>(record.normalAndDisplacement[1]) / 32767.0f;
+			vertex.normal.z = static_cast<float>(record.normalAndDisplacement[2]) / 32767.0f;
 
-			vertex.displacementFactor = static_cast<float>(terrainData.readSint16LE()) / 32767.0f;
+			vertex.displacementFactor = static_cast<float>(record.normalAndDisplacement[3]) / 32767.0f;
 		}
 
 		// Read Polygons
 		const uint32_t numPolygons = terrainData.readUint32LE();
 		_polygons.resize(numPolygons);
 		for (auto &polygon : _polygons) {
-			for (int i = 0; i < 4; ++i) {
-				const uint32_t index = terrainData.readUint32LE();
+			uint32_t indices[4];
+			terrainData.readArrayLE(std::span(indices));
+			for (const auto index : indices) {
 				if (index != 0xFFFFFFFF)
 					polygon.indices.emplace_back(index);
 			}
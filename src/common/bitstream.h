@@ -22,6 +22,7 @@
 #define OPENAWE_BITSTREAM_H
 
 #include <bit>
+#include <cassert>
 
 #include "src/common/readstream.h"
 #include "src/common/endianness.h"
@@ -33,8 +34,10 @@ namespace Common {
  *
  * This class offers the possiblity to read bits over a normal bitstream.
  *
- * A value is being read from a normal readstream depending on the template paremeter given and is then read bit by bit
- * until we have all requested bits for the value.
+ * Values are read from a normal readstream depending on the template paremeter given and are appended to a 64 bit
+ * cache, from which the requested bits are extracted with a single shift and mask. A new value is only read from the
+ * underlying stream when a bit of it is requested, so the position of the underlying stream is the same as if the
+ * bits were read one by one.
  *
  * \tparam T The data type on which the bitstream should operate
  * \tparam le If the bitstream read in little endian
@@ -43,57 +46,100 @@ namespace Common {
 template<typename T, bool le, bool msb>
 class BitStream {
 public:
-	explicit BitStream(Common::ReadStream &bits) : _curValue(0), _remainingBits(0), _bits(bits) {}
+	explicit BitStream(Common::ReadStream &bits) : _cache(0), _remainingBits(0), _bits(bits) {}
 
+	/*!
+	 * Read a number of bits as one value
+	 * \param n The number of bits to read, at most 32
+	 * \return The read bits
+	 */
 	uint32_t read(size_t n) {
-		uint32_t newValue = 0;
-		if constexpr (msb)
-			for (size_t i = 0; i < n; ++i) {
-				newValue = (read() ? 1 : 0) | (newValue << 1);
-			}
-		else
-			for (size_t i = 0; i < n; ++i) {
-				newValue |= (read() ? 1 : 0) << i;
-			}
+		assert(n <= 32);
+
+		if (_remainingBits >= n)
+			return take(n);
+
+		if constexpr (kValueBits < 64) {
+			// There are less than 32 bits remaining, so at least one more value of at most 32 bits fits into the cache
+			do {
+				readNextValue();
+			} while (_remainingBits < n);
+
+			return take(n);
+		} else {
+			// A 64 bit value doesn't fit next to the remaining bits, so combine the remaining bits with the next value
+			const size_t first = _remainingBits;
+			const uint64_t firstBits = take(first);
+			readNextValue();
+			const uint64_t secondBits = take(n - first);
 
-		return newValue;
+			if constexpr (msb)
+				return (firstBits << (n - first)) | secondBits;
+			else
+				return firstBits | (secondBits << first);
+		}
 	}
 
 	void skip(size_t n) {
-		for (size_t i = 0; i < n; ++i) {
-			read();
+		while (n > 32) {
+			read(32);
+			n -= 32;
 		}
+
+		read(n);
 	}
 
 	bool read() {
 		if (_remainingBits == 0)
 			readNextValue();
 
-		bool value;
+		return take(1) != 0;
+	}
+
+private:
+	static constexpr size_t kValueBits = sizeof(T) * 8;
+
+	/*!
+	 * Take a number of bits from the cache, which has to contain enough bits
+	 */
+	uint64_t take(size_t n) {
+		if (n == 0)
+			return 0;
+
+		// The unused bits of the cache are always zero
+		uint64_t value;
 		if constexpr (msb) {
-			value = _curValue & (1 << (sizeof(T) * 8 - 1));
-			_curValue <<= 1;
+			value = _cache >> (64 - n);
+			_cache <<= n;
 		} else {
-			value = _curValue & 1;
-			_curValue >>= 1;
+			value = _cache & (~0ull >> (64 - n));
+			_cache >>= n;
 		}
 
-		_remainingBits--;
+		_remainingBits -= n;
 		return value;
 	}
 
-private:
+	/*!
+	 * Read the next value from the stream and append it behind the remaining bits of the cache
+	 */
 	void readNextValue() {
-		_curValue = _bits.read<T>();
+		T value = _bits.read<T>();
 		if constexpr (!le && sizeof(T) > 1 && std::endian::native == std::endian::little)
-			_curValue = swapBytes(_curValue);
+			value = swapBytes(value);
 		if constexpr (le && sizeof(T) > 1 && std::endian::native == std::endian::big)
-			_curValue = swapBytes(_curValue);
-		_remainingBits = sizeof(T) * 8;
+			value = swapBytes(value);
+
+		if constexpr (msb)
+			_cache |= static_cast<uint64_t>(value) << (64 - kValueBits - _remainingBits);
+		else
+			_cache |= static_cast<uint64_t>(value) << _remainingBits;
+
+		_remainingBits += kValueBits;
 	}
 
-	T _curValue;
-	unsigned short _remainingBits;
+	uint64_t _cache;
+	size_t _remainingBits;
 	Common::ReadStream &_bits;
 };
 
@@ -45,6 +45,10 @@ static bool has_sse   = false;
 static bool has_sse2  = false;
 static bool has_sse3  = false;
 static bool has_ssse3 = false;
+static bool has_sse41 = false;
+static bool has_sse42 = false;
+static bool has_pclmulqdq = false;
+static bool has_avx   = false;
 
 void retrieveCPUInfo() {
 	if (cpuinfoRetrieved)
@@ -62,6 +66,19 @@ void retrieveCPUInfo() {
 	has_sse2  = data[3] & bit_SSE2;
 	has_sse3  = data[2] & bit_SSE3;
 	has_ssse3 = data[2] & bit_SSSE3;
+	has_sse41 = data[2] & bit_SSE4_1;
+	has_sse42 = data[2] & bit_SSE4_2;
+	has_pclmulqdq = data[2] & bit_PCLMUL;
+
+	// AVX can only be used if the operating system saves the ymm registers on context switches
+	bool osSavesYMM = false;
+	if (data[2] & bit_OSXSAVE) {
+		uint32_t xcr0, xcr0High;
+		__asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+		osSavesYMM = (xcr0 & 0x6) == 0x6;
+	}
+
+	has_avx = osSavesYMM && (data[2] & bit_AVX);
 #endif
 }
 
@@ -187,6 +204,26 @@ bool hasSSSE3() {
 	return has_ssse3;
 }
 
+bool hasSSE41() {
+	retrieveCPUInfo();
+	return has_sse41;
+}
+
+bool hasSSE42() {
+	retrieveCPUInfo();
+	return has_sse42;
+}
+
+bool hasPCLMULQDQ() {
+	retrieveCPUInfo();
+	return has_pclmulqdq;
+}
+
+bool hasAVX() {
+	retrieveCPUInfo();
+	return has_avx;
+}
+
 bool hasNEON() {
 #if HAS_GETAUXVAL
     return (getauxval(AT_HWCAP) & HWCAP_NEON) == HWCAP_NEON;
@@ -74,6 +74,30 @@ bool hasSSE3();
  */
 bool hasSSSE3();
 
+/*!
+ * Return if the cpu supports SSE4.1 instructions
+ * \return If the cpu supports SSE4.1 instructions
+ */
+bool hasSSE41();
+
+/*!
+ * Return if the cpu supports SSE4.2 instructions
+ * \return If the cpu supports SSE4.2 instructions
+ */
+bool hasSSE42();
+
+/*!
+ * Return if the cpu supports carry-less multiplication (PCLMULQDQ)
+ * \return If the cpu supports the PCLMULQDQ instruction
+ */
+bool hasPCLMULQDQ();
+
+/*!
+ * Return if the cpu and operating system support AVX instructions
+ * \return If the cpu and operating system support AVX instructions
+ */
+bool hasAVX();
+
 /*!
  * Return if the cpu supports NEON instructions
  * \return If the cpu supports NEON instructions
@@ -0,0 +1,210 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "src/common/crc32.h"
+#include "src/common/cpuinfo.h"
+#include "src/common/endianness.h"
+
+#if ARCH_X86 && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#	define HAS_CRC32_CLMUL 1
+#	include <immintrin.h>
+#endif
+
+namespace Common {
+
+/*!
+ * Tables for calculating the crc32 of 8 bytes at once. The first table is the
+ * regular crc32 table, every following table advances the crc of the previous
+ * table by another zero byte.
+ */
+static constexpr std::array<std::array<uint32_t, 256>, 8> kCRC32SliceTables = [] {
+	std::array<std::array<uint32_t, 256>, 8> tables{};
+	for (size_t i = 0; i < 256; ++i)
+		tables[0][i] = kCRC32Table[i];
+
+	for (size_t i = 0; i < 256; ++i) {
+		for (size_t slice = 1; slice < 8; ++slice)
+			tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+	}
+
+	return tables;
+}();
+
+/*!
+ * Calculate the crc32 of a data block 8 bytes at a time. The hash is given
+ * and returned without the final inversion.
+ */
+static uint32_t crc32SliceBy8(const byte *data, size_t length, uint32_t hash) {
+	const auto &t = kCRC32SliceTables;
+
+	while (length >= 8) {
+		uint32_t low, high;
+		std::memcpy(&low, data, 4);
+		std::memcpy(&high, data + 4, 4);
+		if constexpr (std::endian::native == std::endian::big) {
+			low = swapBytes(low);
+			high = swapBytes(high);
+		}
+
+		low ^= hash;
+		hash =
+			t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+			t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+
+		data += 8;
+		length -= 8;
+	}
+
+	for (size_t i = 0; i < length; ++i)
+		hash = kCRC32Table[(hash ^ data[i]) & 0xFF] ^ (hash >> 8);
+
+	return hash;
+}
+
+#if HAS_CRC32_CLMUL
+
+/*
+ * Folding constants for the crc32 polynomial in the bit reflected domain, as
+ * described in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction" by Gopal et al.
+ */
+alignas(16) static const uint64_t kCRC32K1K2[] = {0x0154442bd4, 0x01c6e41596};
+alignas(16) static const uint64_t kCRC32K3K4[] = {0x01751997d0, 0x00ccaa009e};
+alignas(16) static const uint64_t kCRC32K5K0[] = {0x0163cd6124, 0x0000000000};
+alignas(16) static const uint64_t kCRC32Poly[] = {0x01db710641, 0x01f7011641};
+
+/*!
+ * Calculate the crc32 of a data block by folding 64 bytes at a time using
+ * carry-less multiplications. The length has to be a multiple of 16 and at
+ * least 64 bytes. The hash is given and returned without the final inversion.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("pclmul,sse4.1")))
+#endif
+static uint32_t crc32CLMUL(const byte *data, size_t length, uint32_t hash) {
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+	x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+	x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+	x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+	x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(hash)));
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(kCRC32K1K2));
+
+	data += 64;
+	length -= 64;
+
+	// Fold four blocks of 16 bytes in parallel
+	while (length >= 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		y5 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+		y6 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+		y7 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+		y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+		data += 64;
+		length -= 64;
+	}
+
+	// Fold the four blocks into one
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(kCRC32K3K4));
+
+	for (const __m128i &next : {x2, x3, x4}) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+	}
+
+	// Fold the remaining blocks of 16 bytes
+	while (length >= 16) {
+		x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+		data += 16;
+		length -= 16;
+	}
+
+	// Fold 128 bits to 64 bits
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_srli_si128(x1, 8);
+	x1 = _mm_xor_si128(x1, x2);
+
+	x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(kCRC32K5K0));
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduction to 32 bits
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(kCRC32Poly));
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+#endif // HAS_CRC32_CLMUL
+
+uint32_t crc32Runtime(const byte *data, size_t length, uint32_t hash) {
+	hash ^= 0xFFFFFFFF;
+
+#if HAS_CRC32_CLMUL
+	static const bool useCLMUL = hasPCLMULQDQ() && hasSSE41();
+
+	if (useCLMUL && length >= 64) {
+		const size_t foldLength = length & ~static_cast<size_t>(15);
+		hash = crc32CLMUL(data, foldLength, hash);
+		data += foldLength;
+		length -= foldLength;
+	}
+#endif
+
+	return crc32SliceBy8(data, length, hash) ^ 0xFFFFFFFF;
+}
+
+} // End of namespace Common
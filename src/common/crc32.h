@@ -24,6 +24,7 @@
 #include <cstdint>
 
 #include <string_view>
+#include <type_traits>
 
 #include "src/common/types.h"
 
@@ -80,11 +81,26 @@ static constexpr uint32_t kCRC32Table[] = {
 };
 
 /*!
- * Calculate the crc32 hash from a string
+ * Calculate the crc32 hash of a data block using the fastest implementation
+ * available on the executing cpu. This is either folding with carry-less
+ * multiplications (PCLMULQDQ) or a slice-by-8 table lookup.
+ * \param data The data pointer to calculate the crc32 for
+ * \param length The length of the data block
+ * \param hash The hash of preceding data, to calculate the hash incrementally
+ * \return The hash calculated from the given data
+ */
+uint32_t crc32Runtime(const byte *data, size_t length, uint32_t hash = 0);
+
+/*!
+ * Calculate the crc32 hash from a string. At compile time a simple table
+ * lookup is used, at runtime the fastest available implementation.
  * \param data The string to calculate the hash for
  * \return The hash caculated from the given string
  */
 constexpr uint32_t crc32(const std::string_view &data) {
+	if (!std::is_constant_evaluated())
+		return crc32Runtime(reinterpret_cast<const byte *>(data.data()), data.size());
+
 	uint32_t hash = 0xFFFFFFFF;
 
 	for (char date : data) {
@@ -95,12 +111,16 @@ constexpr uint32_t crc32(const std::string_view &data) {
 }
 
 /*!
- * Calculate the crc32 hash from a raw data block
+ * Calculate the crc32 hash from a raw data block. At compile time a simple
+ * table lookup is used, at runtime the fastest available implementation.
  * \param data The data pointer to calculate the crc32 for
  * \param length The length of the data block
  * \return The hash caculated from the given string
  */
 constexpr uint32_t crc32(const byte *data, size_t length) {
+	if (!std::is_constant_evaluated())
+		return crc32Runtime(data, length);
+
 	uint32_t hash = 0xFFFFFFFF;
 
 	for (size_t i = 0; i < length; i++) {
@@ -0,0 +1,103 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/common/types.h"
+#include "src/common/endianness.h"
+#include "src/common/cpuinfo.h"
+
+#if ARCH_X86 && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#	define HAS_SWAP_SSSE3 1
+#	include <immintrin.h>
+#endif
+
+namespace Common {
+
+#if HAS_SWAP_SSSE3
+
+/*!
+ * Swap the bytes of an array 16 bytes at a time using a byte shuffle. The
+ * shuffle mask defines the element size. Returns the number of bytes which
+ * were processed, the remaining tail has to be swapped by the caller.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("ssse3")))
+#endif
+static size_t swapBytesSSSE3(byte *data, size_t length, __m128i mask) {
+	size_t i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_shuffle_epi8(a, mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(data + i + 16), _mm_shuffle_epi8(b, mask));
+	}
+	for (; i + 16 <= length; i += 16) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_shuffle_epi8(a, mask));
+	}
+	return i;
+}
+
+static const bool kUseSSSE3 = hasSSSE3();
+
+#endif // HAS_SWAP_SSSE3
+
+void swapBytes(std::span<uint64_t> values) {
+	size_t start = 0;
+
+#if HAS_SWAP_SSSE3
+	if (kUseSSSE3) {
+		const __m128i mask = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+		start = swapBytesSSSE3(reinterpret_cast<byte *>(values.data()), values.size_bytes(), mask) / sizeof(uint64_t);
+	}
+#endif
+
+	for (size_t i = start; i < values.size(); ++i)
+		values[i] = swapBytes(values[i]);
+}
+
+void swapBytes(std::span<uint32_t> values) {
+	size_t start = 0;
+
+#if HAS_SWAP_SSSE3
+	if (kUseSSSE3) {
+		const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+		start = swapBytesSSSE3(reinterpret_cast<byte *>(values.data()), values.size_bytes(), mask) / sizeof(uint32_t);
+	}
+#endif
+
+	for (size_t i = start; i < values.size(); ++i)
+		values[i] = swapBytes(values[i]);
+}
+
+void swapBytes(std::span<uint16_t> values) {
+	size_t start = 0;
+
+#if HAS_SWAP_SSSE3
+	if (kUseSSSE3) {
+		const __m128i mask = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+		start = swapBytesSSSE3(reinterpret_cast<byte *>(values.data()), values.size_bytes(), mask) / sizeof(uint16_t);
+	}
+#endif
+
+	for (size_t i = start; i < values.size(); ++i)
+		values[i] = swapBytes(values[i]);
+}
+
+} // End of namespace Common
@@ -21,7 +21,9 @@
 #ifndef SRC_COMMON_ENDIANNESS_H
 #define SRC_COMMON_ENDIANNESS_H
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 #define MANUAL_BSWAP_16(x) ( \
 	((x & 0xFF00) >> 8) |       \
@@ -78,6 +80,32 @@ inline uint16_t swapBytes(uint16_t a) {
 #endif
 }
 
+/*!
+ * Swap the bytes of every value in an array in place
+ * \param values the values to swap
+ */
+void swapBytes(std::span<uint64_t> values);
+void swapBytes(std::span<uint32_t> values);
+void swapBytes(std::span<uint16_t> values);
+
+/*!
+ * Swap the bytes of every value in an array of arbitrary arithmetic type in
+ * place, by reinterpreting it as an array of unsigned ints of the same size.
+ * \tparam T the type of the array elements
+ * \param values the values to swap
+ */
+template<typename T, size_t Extent>
+void swapBytesArray(std::span<T, Extent> values) {
+	if constexpr (sizeof(T) == 8)
+		swapBytes(std::span<uint64_t>(reinterpret_cast<uint64_t *>(values.data()), values.size()));
+	else if constexpr (sizeof(T) == 4)
+		swapBytes(std::span<uint32_t>(reinterpret_cast<uint32_t *>(values.data()), values.size()));
+	else if constexpr (sizeof(T) == 2)
+		swapBytes(std::span<uint16_t>(reinterpret_cast<uint16_t *>(values.data()), values.size()));
+	else
+		static_assert(sizeof(T) == 1, "Unsupported type size for byte swapping");
+}
+
 } // End of namespace Common
 
 #endif //SRC_COMMON_ENDIANNESS_H
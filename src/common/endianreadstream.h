@@ -72,6 +72,21 @@ public:
 	 */
 	int64_t readSint64();
 
+	/*!
+	 * Read an array of values with a single read and convert them from the
+	 * predefined endianness to the native one
+	 * \tparam T The type of the values
+	 * \param values The span to read the values into
+	 * \return The number of complete values read
+	 */
+	template<typename T, size_t Extent>
+	size_t readArray(std::span<T, Extent> values) {
+		if (_bigEndian)
+			return _parentStream->readArrayBE(values);
+		else
+			return _parentStream->readArrayLE(values);
+	}
+
 private:
 	bool _bigEndian;
 	ReadStream *_parentStream;
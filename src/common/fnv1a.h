@@ -0,0 +1,74 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_FNV1A_H
+#define OPENAWE_FNV1A_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include <string_view>
+
+namespace Common {
+
+static constexpr uint64_t kFNV1a64Offset = 0xCBF29CE484222325;
+static constexpr uint64_t kFNV1a64Prime  = 0x00000100000001B3;
+
+/*!
+ * Calculate the 64 bit FNV-1a hash of a string. Since it is a lot less likely to collide than a 32 bit hash, it is
+ * used for indexing large sets of strings like archive paths.
+ *
+ * \param data The string to hash
+ * \return The 64 bit hash of the string
+ */
+constexpr uint64_t fnv1a64(std::string_view data) {
+	uint64_t hash = kFNV1a64Offset;
+
+	for (char date : data) {
+		hash ^= static_cast<unsigned char>(date);
+		hash *= kFNV1a64Prime;
+	}
+
+	return hash;
+}
+
+/*!
+ * Continue calculating the 64 bit FNV-1a hash over a chunk of binary data. By passing the result of a previous call
+ * as hash, data which is only available piecewise can be hashed.
+ *
+ * \param data The data to hash
+ * \param length The length of the data in bytes
+ * \param hash The hash of the preceding data or the FNV-1a offset basis
+ * \return The 64 bit hash of the data
+ */
+inline uint64_t fnv1a64(const void *data, size_t length, uint64_t hash = kFNV1a64Offset) {
+	const auto *bytes = static_cast<const unsigned char *>(data);
+
+	for (size_t i = 0; i < length; ++i) {
+		hash ^= bytes[i];
+		hash *= kFNV1a64Prime;
+	}
+
+	return hash;
+}
+
+}
+
+#endif //OPENAWE_FNV1A_H
@@ -18,9 +18,19 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
+#include <algorithm>
+
 #include <glm/ext/matrix_transform.hpp>
 
-#include "frustrum.h"
+#include "src/common/cpuinfo.h"
+#include "src/common/exception.h"
+#include "src/common/frustrum.h"
+
+#if ARCH_X86 && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#	define HAS_FRUSTRUM_SIMD 1
+#	include <immintrin.h>
+#endif
 
 /*
  * Frustrum calculations based on:
@@ -29,6 +39,139 @@
 
 namespace Common {
 
+/*!
+ * Calculate the signed distance of a point to a plane. The order of operations is fixed, so that the vectorized
+ * batch tests produce exactly the same results as the single tests.
+ */
+static inline float planeDistance(const glm::vec4 &plane, float x, float y, float z) {
+	return (plane.x * x + plane.y * y) + (plane.z * z + plane.w);
+}
+
+/*!
+ * The component arrays a batch test uses for a single plane. For spheres, every plane uses the same arrays. For
+ * boxes, every plane uses the corner of the box which lies furthest in the direction of the planes normal and has
+ * no radius.
+ */
+struct PlaneInput {
+	const float *x, *y, *z, *radius;
+};
+
+#if HAS_FRUSTRUM_SIMD
+
+/*!
+ * Test eight shapes at a time against the planes and set their bits in the visibility mask. Returns the number of
+ * shapes which were tested, the remaining tail has to be tested by the caller.
+ */
+template<bool kSpheres>
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx")))
+#endif
+static size_t testAVX(const glm::vec4 *planes, const PlaneInput *inputs, size_t count, uint64_t *visible) {
+	const __m256 zero = _mm256_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 culled = zero;
+		__m256 x, y, z, radius;
+
+		if constexpr (kSpheres) {
+			x = _mm256_loadu_ps(inputs[0].x + i);
+			y = _mm256_loadu_ps(inputs[0].y + i);
+			z = _mm256_loadu_ps(inputs[0].z + i);
+			radius = _mm256_loadu_ps(inputs[0].radius + i);
+		}
+
+		for (size_t p = 0; p < 6; ++p) {
+			if constexpr (!kSpheres) {
+				x = _mm256_loadu_ps(inputs[p].x + i);
+				y = _mm256_loadu_ps(inputs[p].y + i);
+				z = _mm256_loadu_ps(inputs[p].z + i);
+			}
+
+			__m256 d = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(planes[p].x)), _mm256_mul_ps(y, _mm256_set1_ps(planes[p].y))),
+				_mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(planes[p].z)), _mm256_set1_ps(planes[p].w))
+			);
+			if constexpr (kSpheres)
+				d = _mm256_add_ps(d, radius);
+
+			culled = _mm256_or_ps(culled, _mm256_cmp_ps(d, zero, _CMP_LE_OQ));
+		}
+
+		const uint64_t mask = ~_mm256_movemask_ps(culled) & 0xFF;
+		visible[i / 64] |= mask << (i % 64);
+	}
+
+	return i;
+}
+
+/*!
+ * Test four shapes at a time against the planes and set their bits in the visibility mask. Returns the number of
+ * shapes which were tested, the remaining tail has to be tested by the caller.
+ */
+template<bool kSpheres>
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse")))
+#endif
+static size_t testSSE(const glm::vec4 *planes, const PlaneInput *inputs, size_t count, uint64_t *visible) {
+	const __m128 zero = _mm_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 culled = zero;
+		__m128 x, y, z, radius;
+
+		if constexpr (kSpheres) {
+			x = _mm_loadu_ps(inputs[0].x + i);
+			y = _mm_loadu_ps(inputs[0].y + i);
+			z = _mm_loadu_ps(inputs[0].z + i);
+			radius = _mm_loadu_ps(inputs[0].radius + i);
+		}
+
+		for (size_t p = 0; p < 6; ++p) {
+			if constexpr (!kSpheres) {
+				x = _mm_loadu_ps(inputs[p].x + i);
+				y = _mm_loadu_ps(inputs[p].y + i);
+				z = _mm_loadu_ps(inputs[p].z + i);
+			}
+
+			__m128 d = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p].x)), _mm_mul_ps(y, _mm_set1_ps(planes[p].y))),
+				_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(planes[p].z)), _mm_set1_ps(planes[p].w))
+			);
+			if constexpr (kSpheres)
+				d = _mm_add_ps(d, radius);
+
+			culled = _mm_or_ps(culled, _mm_cmple_ps(d, zero));
+		}
+
+		const uint64_t mask = ~_mm_movemask_ps(culled) & 0xF;
+		visible[i / 64] |= mask << (i % 64);
+	}
+
+	return i;
+}
+
+static const bool kUseAVX = hasAVX();
+static const bool kUseSSE = hasSSE();
+
+#endif // HAS_FRUSTRUM_SIMD
+
+/*!
+ * Run the fastest available vectorized batch test and return the number of shapes which were tested
+ */
+template<bool kSpheres>
+static size_t testBatch(const glm::vec4 *planes, const PlaneInput *inputs, size_t count, uint64_t *visible) {
+#if HAS_FRUSTRUM_SIMD
+	if (kUseAVX)
+		return testAVX<kSpheres>(planes, inputs, count, visible);
+	if (kUseSSE)
+		return testSSE<kSpheres>(planes, inputs, count, visible);
+#endif
+
+	return 0;
+}
+
 Frustrum::Frustrum() : _view(glm::identity<glm::mat4>()), _projection(glm::identity<glm::mat4>()) {
 	generatePlanes();
 }
@@ -49,7 +192,7 @@ void Frustrum::setProjectionMatrix(glm::mat4 projection) {
 
 bool Frustrum::test(const glm::vec3 &point) const {
 	for (const auto &plane: _planes) {
-		const float d = glm::dot(glm::vec4(point, 1.0f), plane);
+		const float d = planeDistance(plane, point.x, point.y, point.z);
 		if (d <= 0)
 			return false;
 	}
@@ -59,7 +202,7 @@ bool Frustrum::test(const glm::vec3 &point) const {
 
 bool Frustrum::test(const BoundSphere &sphere) const {
 	for (const auto &plane: _planes) {
-		const float d = glm::dot(glm::vec4(sphere.position, 1.0f), plane);
+		const float d = planeDistance(plane, sphere.position.x, sphere.position.y, sphere.position.z);
 		if (d + sphere.radius <= 0)
 			return false;
 	}
@@ -67,6 +210,88 @@ bool Frustrum::test(const BoundSphere &sphere) const {
 	return true;
 }
 
+bool Frustrum::test(const BoundBox &box) const {
+	for (const auto &plane: _planes) {
+		const float d = planeDistance(
+			plane,
+			plane.x >= 0 ? box.xmax : box.xmin,
+			plane.y >= 0 ? box.ymax : box.ymin,
+			plane.z >= 0 ? box.zmax : box.zmin
+		);
+		if (d <= 0)
+			return false;
+	}
+
+	return true;
+}
+
+void Frustrum::test(
+	std::span<const float> x,
+	std::span<const float> y,
+	std::span<const float> z,
+	std::span<const float> radius,
+	std::span<uint64_t> visible
+) const {
+	const size_t count = x.size();
+	if (y.size() != count || z.size() != count || radius.size() != count)
+		throw CreateException("Component arrays of the spheres have different sizes");
+	if (visible.size() < getMaskSize(count))
+		throw CreateException("Visibility mask is too small for {} spheres", count);
+
+	std::fill_n(visible.begin(), getMaskSize(count), 0);
+
+	PlaneInput inputs[6];
+	std::fill_n(inputs, 6, PlaneInput{x.data(), y.data(), z.data(), radius.data()});
+
+	for (size_t i = testBatch<true>(_planes.data(), inputs, count, visible.data()); i < count; ++i) {
+		if (test(BoundSphere{glm::vec3(x[i], y[i], z[i]), radius[i]}))
+			visible[i / 64] |= 1ull << (i % 64);
+	}
+}
+
+void Frustrum::test(
+	std::span<const float> xmin,
+	std::span<const float> ymin,
+	std::span<const float> zmin,
+	std::span<const float> xmax,
+	std::span<const float> ymax,
+	std::span<const float> zmax,
+	std::span<uint64_t> visible
+) const {
+	const size_t count = xmin.size();
+	if (
+		ymin.size() != count || zmin.size() != count ||
+		xmax.size() != count || ymax.size() != count || zmax.size() != count
+	)
+		throw CreateException("Component arrays of the boxes have different sizes");
+	if (visible.size() < getMaskSize(count))
+		throw CreateException("Visibility mask is too small for {} boxes", count);
+
+	std::fill_n(visible.begin(), getMaskSize(count), 0);
+
+	PlaneInput inputs[6];
+	for (size_t p = 0; p < 6; ++p) {
+		inputs[p] = PlaneInput{
+			_planes[p].x >= 0 ? xmax.data() : xmin.data(),
+			_planes[p].y >= 0 ? ymax.data() : ymin.data(),
+			_planes[p].z >= 0 ? zmax.data() : zmin.data(),
+			nullptr
+		};
+	}
+
+	for (size_t i = testBatch<false>(_planes.data(), inputs, count, visible.data()); i < count; ++i) {
+		BoundBox box;
+		box.xmin = xmin[i];
+		box.ymin = ymin[i];
+		box.zmin = zmin[i];
+		box.xmax = xmax[i];
+		box.ymax = ymax[i];
+		box.zmax = zmax[i];
+		if (test(box))
+			visible[i / 64] |= 1ull << (i % 64);
+	}
+}
+
 void Frustrum::generatePlanes() {
 	const glm::mat4 vp = glm::transpose(_projection * _view);
 
@@ -21,6 +21,8 @@
 #ifndef OPENAWE_FRUSTRUM_H
 #define OPENAWE_FRUSTRUM_H
 
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "src/common/types.h"
@@ -64,6 +66,77 @@ public:
 	 */
 	bool test(const BoundSphere &sphere) const;
 
+	/*!
+	 * Test if a given axis aligned bounding box is contained or intersects the frustrum. The test is conservative,
+	 * boxes close to a corner of the frustrum can be reported as visible although they are outside of it.
+	 * \param box The box to test
+	 * \return If the box is in the frustrum or intersects it
+	 */
+	bool test(const BoundBox &box) const;
+
+	/*!
+	 * Test a batch of bounding spheres given as separate arrays of their components. For every sphere i, the bit
+	 * i % 64 of visible[i / 64] is set if the sphere is in the frustrum or intersects it and cleared if not. The
+	 * results are identical to testing every sphere on its own, but are computed for multiple spheres at once
+	 * using AVX or SSE, depending on what the cpu supports. The results are only identical as long as the
+	 * compiler does not fuse multiplications and additions of the single tests, which is why the build disables
+	 * floating point contraction for the frustrum.
+	 *
+	 * \param x The x coordinates of the sphere centers
+	 * \param y The y coordinates of the sphere centers
+	 * \param z The z coordinates of the sphere centers
+	 * \param radius The radii of the spheres
+	 * \param visible The visibility mask which has to hold at least getMaskSize(x.size()) values
+	 */
+	void test(
+		std::span<const float> x,
+		std::span<const float> y,
+		std::span<const float> z,
+		std::span<const float> radius,
+		std::span<uint64_t> visible
+	) const;
+
+	/*!
+	 * Test a batch of axis aligned bounding boxes given as separate arrays of their components. The visibility mask
+	 * is written the same way as for spheres and the results are identical to testing every box on its own.
+	 *
+	 * \param xmin The minimal x coordinates of the boxes
+	 * \param ymin The minimal y coordinates of the boxes
+	 * \param zmin The minimal z coordinates of the boxes
+	 * \param xmax The maximal x coordinates of the boxes
+	 * \param ymax The maximal y coordinates of the boxes
+	 * \param zmax The maximal z coordinates of the boxes
+	 * \param visible The visibility mask which has to hold at least getMaskSize(xmin.size()) values
+	 */
+	void test(
+		std::span<const float> xmin,
+		std::span<const float> ymin,
+		std::span<const float> zmin,
+		std::span<const float> xmax,
+		std::span<const float> ymax,
+		std::span<const float> zmax,
+		std::span<uint64_t> visible
+	) const;
+
+	/*!
+	 * Get the number of values a visibility mask needs for testing a batch of shapes
+	 * \param count The number of shapes in the batch
+	 * \return The number of 64 bit values needed for the mask
+	 */
+	static constexpr size_t getMaskSize(size_t count) {
+		return (count + 63) / 64;
+	}
+
+	/*!
+	 * Get if a shape of a batch test was visible
+	 * \param visible The visibility mask written by a batch test
+	 * \param index The index of the shape in the batch
+	 * \return If the shape was in the frustrum or intersected it
+	 */
+	static constexpr bool isVisible(std::span<const uint64_t> visible, size_t index) {
+		return (visible[index / 64] >> (index % 64)) & 1;
+	}
+
 private:
 	void generatePlanes();
 
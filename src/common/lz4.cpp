@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <memory>
+
 #if WITH_LZ4
 #	include <lz4.h>
 #endif
@@ -29,12 +31,16 @@
 namespace Common {
 
 ReadStream *decompressLZ4(const byte *data, size_t compressedSize, size_t decompressedSize) {
-#if WITH_LZ4
-	byte *decompressedData = new byte[decompressedSize];
+	std::unique_ptr<byte[]> decompressedData(new byte[decompressedSize]);
+	decompressLZ4(data, compressedSize, decompressedData.get(), decompressedSize);
+	return new MemoryReadStream(decompressedData.release(), decompressedSize);
+}
 
+void decompressLZ4(const byte *data, size_t compressedSize, byte *output, size_t decompressedSize) {
+#if WITH_LZ4
 	const auto decompressed = LZ4_decompress_safe(
 		reinterpret_cast<const char*>(data),
-		reinterpret_cast<char*>(decompressedData),
+		reinterpret_cast<char*>(output),
 		compressedSize,
 		decompressedSize
 	);
@@ -46,8 +52,36 @@ ReadStream *decompressLZ4(const byte *data, size_t compressedSize, size_t decomp
 			decompressed
 		);
 	}
+#else
+	throw CreateException("LZ4 support was not enabled");
+#endif
+}
+
+void decompressLZ4(std::span<const byte> input, std::span<byte> output) {
+	decompressLZ4(input.data(), input.size(), output.data(), output.size());
+}
+
+size_t getLZ4CompressBound(size_t decompressedSize) {
+#if WITH_LZ4
+	return LZ4_compressBound(decompressedSize);
+#else
+	throw CreateException("LZ4 support was not enabled");
+#endif
+}
+
+size_t compressLZ4(std::span<const byte> input, std::span<byte> output) {
+#if WITH_LZ4
+	const auto compressed = LZ4_compress_default(
+		reinterpret_cast<const char*>(input.data()),
+		reinterpret_cast<char*>(output.data()),
+		input.size(),
+		output.size()
+	);
+
+	if (compressed <= 0 && !input.empty())
+		throw CreateException("LZ4 compression of {} bytes into {} bytes failed", input.size(), output.size());
 
-	return new MemoryReadStream(decompressedData, decompressedSize);
+	return compressed;
 #else
 	throw CreateException("LZ4 support was not enabled");
 #endif
@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <span>
+
 #include "src/common/readstream.h"
 
 namespace Common {
@@ -31,4 +33,38 @@ namespace Common {
  */
 ReadStream *decompressLZ4(const byte *data, size_t compressedSize, size_t decompressedSize);
 
+/*!
+ * Decompress a certain memory area compressed as lz4 data into an already
+ * allocated output buffer, which has to be at least decompressedSize bytes
+ * large. This function is safe to be called from multiple threads at once.
+ * @param data A pointer to the data to decompress
+ * @param compressedSize The size size of the compressed data
+ * @param output A pointer to the buffer receiving the decompressed data
+ * @param decompressedSize The decompressed sie of the data
+ */
+void decompressLZ4(const byte *data, size_t compressedSize, byte *output, size_t decompressedSize);
+
+/*!
+ * Decompress lz4 data into a buffer owned by the caller. The output has to
+ * have exactly the decompressed size of the data.
+ * @param input The compressed data
+ * @param output The buffer receiving the decompressed data
+ */
+void decompressLZ4(std::span<const byte> input, std::span<byte> output);
+
+/*!
+ * Get the maximum size of lz4 compressed data for data of a given size
+ * @param decompressedSize The size of the data to compress
+ * @return The size an output buffer for compressLZ4 should have
+ */
+size_t getLZ4CompressBound(size_t decompressedSize);
+
+/*!
+ * Compress data as lz4 into a buffer owned by the caller
+ * @param input The data to compress
+ * @param output The buffer receiving the compressed data, see getLZ4CompressBound
+ * @return The size of the compressed data
+ */
+size_t compressLZ4(std::span<const byte> input, std::span<byte> output);
+
 } // End of namespace Common
@@ -0,0 +1,182 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <algorithm>
+
+#include "src/common/mappedfile.h"
+#include "src/common/exception.h"
+
+#if OS_LINUX || OS_MACOS
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#elif OS_WINDOWS
+#	include <windows.h>
+#endif
+
+namespace Common {
+
+MappedFile::MappedFile(const std::string &file) : _data(nullptr), _size(0), _position(0) {
+	if (!std::filesystem::is_regular_file(file))
+		throw Common::Exception("{} not found", file);
+
+	_size = std::filesystem::file_size(file);
+
+#if OS_LINUX || OS_MACOS
+	// Mapping an empty file is not possible, so it stays without data
+	if (_size == 0)
+		return;
+
+	const int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw Common::Exception("Failed to open {}", file);
+
+	void *mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		throw Common::Exception("Failed to map {} into memory", file);
+
+	_data = reinterpret_cast<const byte *>(mapping);
+#elif OS_WINDOWS
+	_file = nullptr;
+	_mapping = nullptr;
+
+	if (_size == 0)
+		return;
+
+	_file = CreateFileA(
+		file.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if (_file == INVALID_HANDLE_VALUE)
+		throw Common::Exception("Failed to open {}", file);
+
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!_mapping) {
+		CloseHandle(_file);
+		throw Common::Exception("Failed to create file mapping for {}", file);
+	}
+
+	_data = reinterpret_cast<const byte *>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!_data) {
+		CloseHandle(_mapping);
+		CloseHandle(_file);
+		throw Common::Exception("Failed to map {} into memory", file);
+	}
+#else
+	throw Common::Exception("Memory mapped files are not supported on this platform");
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if OS_LINUX || OS_MACOS
+	if (_data)
+		munmap(const_cast<byte *>(_data), _size);
+#elif OS_WINDOWS
+	if (_data)
+		UnmapViewOfFile(_data);
+	if (_mapping)
+		CloseHandle(_mapping);
+	if (_file)
+		CloseHandle(_file);
+#endif
+}
+
+size_t MappedFile::read(void *data, size_t length) {
+	const size_t sizeToRead = readAt(_position, data, length);
+	_position += sizeToRead;
+	return sizeToRead;
+}
+
+size_t MappedFile::readAt(size_t offset, void *data, size_t length) {
+	if (offset >= _size)
+		return 0;
+
+	const size_t sizeToRead = std::min<size_t>(length, _size - offset);
+	std::memcpy(data, _data + offset, sizeToRead);
+	return sizeToRead;
+}
+
+bool MappedFile::isConcurrent() const {
+	return true;
+}
+
+std::span<const byte> MappedFile::getView(size_t offset, size_t length) const {
+	if (offset > _size || length > _size - offset)
+		return {};
+
+	return {_data + offset, length};
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+	if (offset >= _size || length == 0)
+		return;
+
+	length = std::min(length, _size - offset);
+
+#if OS_LINUX || OS_MACOS
+	// madvise requires a page aligned start address
+	const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const size_t alignedOffset = offset - offset % pageSize;
+	madvise(const_cast<byte *>(_data) + alignedOffset, length + offset - alignedOffset, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::seek(ptrdiff_t length, ReadStream::SeekOrigin origin) {
+	ptrdiff_t position = 0;
+	switch (origin) {
+		case BEGIN:
+			position = length;
+			break;
+		case CURRENT:
+			position = static_cast<ptrdiff_t>(_position) + length;
+			break;
+		case END:
+			position = static_cast<ptrdiff_t>(_size) + length;
+			break;
+	}
+
+	if (position < 0 || static_cast<size_t>(position) > _size)
+		throw Common::Exception("Mapped file out of bounds");
+
+	_position = position;
+}
+
+size_t MappedFile::pos() const {
+	return _position;
+}
+
+bool MappedFile::eos() const {
+	return _position >= _size;
+}
+
+size_t MappedFile::size() const {
+	return _size;
+}
+
+} // End of namespace Common
@@ -0,0 +1,76 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_MAPPEDFILE_H
+#define SRC_COMMON_MAPPEDFILE_H
+
+#include <string>
+
+#include "src/common/readstream.h"
+
+namespace Common {
+
+/*!
+ * \brief Class for accessing memory mapped files as a ReadStream
+ *
+ * This class maps a whole file read only into memory and offers access to it as a ReadStream. Since the file contents
+ * are directly accessible in memory, views into the mapping can be handed out using getView() without copying any
+ * data, and positional reads can be done concurrently from multiple threads. The mapping is removed when the stream is
+ * destroyed, so all views into the file have to be released before that.
+ */
+class MappedFile : public ReadStream {
+public:
+	/*!
+	 * Map the given file into memory
+	 * \param file the file to map
+	 */
+	explicit MappedFile(const std::string &file);
+	~MappedFile() override;
+
+	size_t read(void *data, size_t length) override;
+
+	size_t readAt(size_t offset, void *data, size_t length) override;
+
+	bool isConcurrent() const override;
+
+	std::span<const byte> getView(size_t offset, size_t length) const override;
+
+	void prefetch(size_t offset, size_t length) const override;
+
+	void seek(ptrdiff_t length, SeekOrigin origin = BEGIN) override;
+
+	size_t pos() const override;
+
+	bool eos() const override;
+
+	size_t size() const override;
+
+private:
+	const byte *_data;
+	size_t _size, _position;
+
+#if OS_WINDOWS
+	void *_file, *_mapping;
+#endif
+};
+
+} // End of namespace Common
+
+#endif // SRC_COMMON_MAPPEDFILE_H
@@ -39,6 +39,14 @@ MemoryReadStream::MemoryReadStream(const char *data, size_t length) :
 	_position(0) {
 }
 
+MemoryReadStream::MemoryReadStream(std::shared_ptr<const byte[]> data, size_t length) :
+	_dispose(false),
+	_sharedData(std::move(data)),
+	_data(_sharedData.get()),
+	_size(length),
+	_position(0) {
+}
+
 MemoryReadStream::~MemoryReadStream() {
 	if (_dispose)
 		delete[] _data;
@@ -51,6 +59,26 @@ size_t MemoryReadStream::read(void *data, size_t length) {
 	return sizeToRead;
 }
 
+size_t MemoryReadStream::readAt(size_t offset, void *data, size_t length) {
+	if (offset >= _size)
+		return 0;
+
+	size_t sizeToRead = std::min<size_t>(length, _size - offset);
+	std::memcpy(data, _data + offset, sizeToRead);
+	return sizeToRead;
+}
+
+bool MemoryReadStream::isConcurrent() const {
+	return true;
+}
+
+std::span<const byte> MemoryReadStream::getView(size_t offset, size_t length) const {
+	if (offset > _size || length > _size - offset)
+		return {};
+
+	return {_data + offset, length};
+}
+
 void MemoryReadStream::seek(ptrdiff_t length, ReadStream::SeekOrigin origin) {
 	switch (origin) {
 		case BEGIN:
@@ -22,6 +22,7 @@
 #define SRC_COMMON_MEMREADSTREAM_H
 
 #include <sstream>
+#include <memory>
 
 #include "src/common/readstream.h"
 
@@ -32,10 +33,22 @@ public:
 	MemoryReadStream(byte *data, size_t length, bool dispose = true);
 	MemoryReadStream(const byte *data, size_t length);
 	MemoryReadStream(const char *data, size_t length);
+	/*!
+	 * Create a stream from a shared buffer, which is kept alive as long as the stream exists
+	 * \param data The shared buffer to read from
+	 * \param length The length of the buffer
+	 */
+	MemoryReadStream(std::shared_ptr<const byte[]> data, size_t length);
 	~MemoryReadStream();
 
 	size_t read(void *data, size_t length) override;
 
+	size_t readAt(size_t offset, void *data, size_t length) override;
+
+	bool isConcurrent() const override;
+
+	std::span<const byte> getView(size_t offset, size_t length) const override;
+
 	size_t pos() const override;
 
 	bool eos() const override;
@@ -46,6 +59,7 @@ public:
 
 private:
 	bool _dispose;
+	std::shared_ptr<const byte[]> _sharedData;
 	const byte *_data;
 	size_t _size, _position;
 };
@@ -22,6 +22,12 @@
 #define OPENAWE_NURBS_H
 
 #include <cstring>
+#include <cstdint>
+#include <array>
+#include <span>
+#include <vector>
+
+#include "src/common/exception.h"
 
 namespace Common {
 
@@ -30,42 +36,111 @@ namespace Common {
  *
  * This class represents a Non-Uniform Rational B-Spline, also known as NURBS. It is used for interpolating values over
  * a range of control points and knots.
+ *
+ * The basis functions are evaluated in fixed size storage, so interpolating doesn't allocate any memory. Therefore the
+ * degree of the curve is limited to kMaxDegree, which covers the curves of havok spline compressed animations.
  */
 template<typename T>
 class NURBS {
 public:
+	static constexpr unsigned int kMaxDegree = 3;
+
 	NURBS(std::vector<T> controlPoints, std::vector<uint8_t> knots, unsigned int degree) :
 		_degree(degree),
-		_controlPoints(controlPoints),
-		_knots(knots) {
+		_controlPoints(std::move(controlPoints)),
+		_knots(std::move(knots)) {
+		if (_degree > kMaxDegree)
+			throw CreateException("NURBS curves with degree {} are not supported, only up to {}", _degree, kMaxDegree);
+		if (_controlPoints.size() <= _degree)
+			throw CreateException("NURBS curve of degree {} needs more than {} control points", _degree, _degree);
+		if (_knots.size() < _controlPoints.size() + _degree + 1)
+			throw CreateException(
+				"NURBS curve with {} control points needs {} knots, got {}",
+				_controlPoints.size(),
+				_controlPoints.size() + _degree + 1,
+				_knots.size()
+			);
 	}
 
 	T interpolate(unsigned int t) const {
-		const size_t span = findSpan(t);
-		const auto basis = bsplineBasis(span, t);
+		return evaluate(findSpan(t), t);
+	}
+
+	/*!
+	 * Interpolate the curve at consecutive times. The span of every time is
+	 * found by advancing the span of the previous time instead of searching
+	 * it again.
+	 * \param first The time of the first value
+	 * \param values The values to fill, the time is incremented by one for every value
+	 */
+	void interpolate(unsigned int first, std::span<T> values) const {
+		if (values.empty())
+			return;
+
+		switch (_degree) {
+			case 0: interpolate<0>(first, values); break;
+			case 1: interpolate<1>(first, values); break;
+			case 2: interpolate<2>(first, values); break;
+			default: interpolate<3>(first, values); break;
+		}
+	}
+
+private:
+	template<unsigned int Degree>
+	void interpolate(unsigned int first, std::span<T> values) const {
+		const unsigned int lastSpan = _controlPoints.size() - 1;
+		const unsigned int lastKnot = _knots[_controlPoints.size()];
+
+		size_t span = findSpan(first);
+		for (unsigned int i = 0; i < values.size(); ++i) {
+			const unsigned int t = first + i;
+			if (t >= lastKnot)
+				span = lastSpan;
+			else
+				while (t >= _knots[span + 1])
+					span++;
+
+			values[i] = evaluate<Degree>(span, t);
+		}
+	}
+
+	T evaluate(size_t span, unsigned int t) const {
+		switch (_degree) {
+			case 0: return evaluate<0>(span, t);
+			case 1: return evaluate<1>(span, t);
+			case 2: return evaluate<2>(span, t);
+			default: return evaluate<3>(span, t);
+		}
+	}
+
+	/*!
+	 * Evaluate the curve with the degree known at compile time, so that the
+	 * loops over the basis functions are unrolled completely
+	 */
+	template<unsigned int Degree>
+	T evaluate(size_t span, unsigned int t) const {
+		const auto basis = bsplineBasis<Degree>(span, t);
 
 		T value;
 		std::memset(&value, 0, sizeof(T));
-		for (unsigned int i = 0; i <= _degree; ++i) {
+		for (unsigned int i = 0; i <= Degree; ++i) {
 			value += _controlPoints[span - i] * basis[i];
 		}
 
 		return value;
 	}
 
-private:
 	/*
 	 * bsplineBasis and findSpan are based on the implementations of
 	 * https://github.com/PredatorCZ/HavokLib
 	 */
 
-	std::vector<float> bsplineBasis(size_t span, float t) const {
-		std::vector<float> N(_degree + 1);
-		std::fill(N.begin(), N.end(), 0.0f);
-
+	template<unsigned int Degree>
+	std::array<float, Degree + 1> bsplineBasis(size_t span, float t) const {
+		std::array<float, Degree + 1> N{};
 		N[0] = 1.0f;
 
-		for (unsigned int i = 0; i < _degree; ++i) {
+		for (unsigned int i = 0; i < Degree; ++i) {
 			for (int j = i; j >= 0; --j) {
 				float a = (t - _knots[span - j]) / (_knots[span + i + 1 - j] - _knots[span - j]);
 				float tmp = N[j] * a;
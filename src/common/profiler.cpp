@@ -0,0 +1,245 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <format>
+
+#include "src/common/profiler.h"
+
+namespace Common {
+
+/*!
+ * The number of events a thread buffers before writing them to the trace file
+ */
+static constexpr size_t kMaxBufferedEvents = 4096;
+
+/*!
+ * The buffer of the current thread, which is owned by the profiler
+ */
+static thread_local void *tThreadBuffer = nullptr;
+
+/*!
+ * Escape a string so that it can be placed between quotes in json
+ */
+static std::string escapeJSON(std::string_view str) {
+	std::string escaped;
+	escaped.reserve(str.size());
+
+	for (const char c : str) {
+		switch (c) {
+			case '"':  escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+					escaped += std::format("\\u{:04x}", static_cast<int>(c));
+				else
+					escaped += c;
+		}
+	}
+
+	return escaped;
+}
+
+TraceProfiler::TraceProfiler() : _recording(false), _startTime(0), _firstEvent(true) {
+}
+
+TraceProfiler::~TraceProfiler() {
+	stop();
+}
+
+void TraceProfiler::start(const std::string &path) {
+	stop();
+
+	std::lock_guard<std::mutex> l(_access);
+	_file = std::make_unique<WriteFile>(path);
+	_startTime = now();
+	_firstEvent = true;
+
+	const std::string header = "{\"traceEvents\":[\n";
+	_file->write(header.data(), header.size());
+
+	_recording.store(true);
+}
+
+void TraceProfiler::stop() {
+	if (!_recording.exchange(false))
+		return;
+
+	std::vector<ThreadBuffer *> buffers;
+	{
+		std::lock_guard<std::mutex> l(_access);
+		for (const auto &buffer : _buffers)
+			buffers.emplace_back(buffer.get());
+	}
+
+	for (const auto buffer : buffers)
+		flush(*buffer);
+
+	std::lock_guard<std::mutex> l(_access);
+
+	// Name all threads known to the profiler
+	for (const auto buffer : buffers) {
+		std::lock_guard<std::mutex> bufferLock(buffer->access);
+		if (buffer->name.empty())
+			continue;
+
+		writeEvent(std::format(
+			R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+			buffer->id,
+			escapeJSON(buffer->name)
+		));
+	}
+
+	const std::string footer = "\n]}\n";
+	_file->write(footer.data(), footer.size());
+	_file.reset();
+}
+
+bool TraceProfiler::isRecording() const {
+	return _recording.load(std::memory_order_relaxed);
+}
+
+void TraceProfiler::addZone(const char *name, int64_t start, int64_t end) {
+	addEvent({kZone, name, start, end - start, 0.0});
+}
+
+void TraceProfiler::addFrame() {
+	addEvent({kFrame, "Frame", now(), 0, 0.0});
+}
+
+void TraceProfiler::addCounter(const char *name, double value) {
+	addEvent({kCounter, name, now(), 0, value});
+}
+
+void TraceProfiler::setThreadName(const std::string &name) {
+	ThreadBuffer &buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> l(buffer.access);
+	buffer.name = name;
+}
+
+int64_t TraceProfiler::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+TraceProfiler::ThreadBuffer &TraceProfiler::getThreadBuffer() {
+	if (tThreadBuffer)
+		return *static_cast<ThreadBuffer *>(tThreadBuffer);
+
+	std::lock_guard<std::mutex> l(_access);
+	auto &buffer = _buffers.emplace_back(std::make_unique<ThreadBuffer>());
+	buffer->id = static_cast<uint32_t>(_buffers.size());
+	buffer->events.reserve(kMaxBufferedEvents);
+	tThreadBuffer = buffer.get();
+
+	return *buffer;
+}
+
+void TraceProfiler::addEvent(const Event &event) {
+	if (!isRecording())
+		return;
+
+	ThreadBuffer &buffer = getThreadBuffer();
+
+	bool full;
+	{
+		std::lock_guard<std::mutex> l(buffer.access);
+		buffer.events.emplace_back(event);
+		full = buffer.events.size() >= kMaxBufferedEvents;
+	}
+
+	if (full)
+		flush(buffer);
+}
+
+void TraceProfiler::flush(ThreadBuffer &buffer) {
+	// Take the events out of the buffer first, so that the thread can continue recording while they are written
+	std::vector<Event> events;
+	events.reserve(kMaxBufferedEvents);
+	{
+		std::lock_guard<std::mutex> l(buffer.access);
+		std::swap(events, buffer.events);
+	}
+
+	std::lock_guard<std::mutex> l(_access);
+
+	// The recording might have been stopped in between
+	if (!_file)
+		return;
+
+	for (const auto &event : events) {
+		// Timestamps are given in microseconds relative to the start of the recording
+		const double timestamp = static_cast<double>(event.start - _startTime) / 1000.0;
+		const std::string name = escapeJSON(event.name);
+
+		switch (event.type) {
+			case kZone:
+				writeEvent(std::format(
+					R"({{"name":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+					name,
+					timestamp,
+					static_cast<double>(event.duration) / 1000.0,
+					buffer.id
+				));
+				break;
+
+			case kFrame:
+				writeEvent(std::format(
+					R"({{"name":"{}","ph":"i","s":"g","ts":{:.3f},"pid":1,"tid":{}}})",
+					name,
+					timestamp,
+					buffer.id
+				));
+				break;
+
+			case kCounter:
+				writeEvent(std::format(
+					R"({{"name":"{}","ph":"C","ts":{:.3f},"pid":1,"tid":{},"args":{{"value":{}}}}})",
+					name,
+					timestamp,
+					buffer.id,
+					event.value
+				));
+				break;
+		}
+	}
+}
+
+void TraceProfiler::writeEvent(const std::string &json) {
+	if (!_firstEvent)
+		_file->write(",\n", 2);
+	_firstEvent = false;
+
+	_file->write(json.data(), json.size());
+}
+
+TraceZone::TraceZone(const char *name) : _name(name) {
+	_start = TraceProfiler::instance().isRecording() ? TraceProfiler::now() : -1;
+}
+
+TraceZone::~TraceZone() {
+	if (_start >= 0)
+		TraceProfiler::instance().addZone(_name, _start, TraceProfiler::now());
+}
+
+} // End of namespace Common
@@ -0,0 +1,192 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_PROFILER_H
+#define OPENAWE_PROFILER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common/singleton.h"
+#include "src/common/writefile.h"
+
+/*
+ * Profiling macros for instrumenting the engine. Depending on the build they forward to the Tracy profiler
+ * (WITH_TRACY), to the built-in trace event profiler (WITH_TRACE_EVENTS) or expand to nothing. All names have to be
+ * string literals or otherwise live until the end of the program.
+ *
+ * PROFILE_ZONE(name)           Measure the time until the end of the current scope
+ * PROFILE_FUNCTION()           Measure the time until the end of the current function
+ * PROFILE_FRAME()              Mark the end of a frame
+ * PROFILE_COUNTER(name, value) Record the current value of a counter
+ * PROFILE_THREAD_NAME(name)    Set the name of the current thread, the name is copied
+ */
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(TRACY_ENABLE)
+
+#	include <tracy/Tracy.hpp>
+
+#	define PROFILE_ZONE(name) ZoneScopedN(name)
+#	define PROFILE_FUNCTION() ZoneScoped
+#	define PROFILE_FRAME() FrameMark
+#	define PROFILE_COUNTER(name, value) TracyPlot(name, static_cast<double>(value))
+#	define PROFILE_THREAD_NAME(name) tracy::SetThreadName(std::string(name).c_str())
+
+#elif defined(WITH_TRACE_EVENTS)
+
+#	define PROFILE_ZONE(name) const Common::TraceZone PROFILE_CONCAT(traceZone, __COUNTER__)(name)
+#	define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#	define PROFILE_FRAME() Common::TraceProfiler::instance().addFrame()
+#	define PROFILE_COUNTER(name, value) Common::TraceProfiler::instance().addCounter(name, static_cast<double>(value))
+#	define PROFILE_THREAD_NAME(name) Common::TraceProfiler::instance().setThreadName(name)
+
+#else
+
+#	define PROFILE_ZONE(name)
+#	define PROFILE_FUNCTION()
+#	define PROFILE_FRAME()
+#	define PROFILE_COUNTER(name, value)
+#	define PROFILE_THREAD_NAME(name)
+
+#endif
+
+namespace Common {
+
+/*!
+ * \brief Built-in profiler writing chrome trace events
+ *
+ * This profiler records zones, frame marks and counters of all threads and writes them as trace events in the json
+ * format, which can be viewed in chrome://tracing or Perfetto. Every thread records into its own buffer, which is
+ * written to the file when it gets full or when the recording is stopped. Events are only recorded between start()
+ * and stop().
+ */
+class TraceProfiler : public Singleton<TraceProfiler> {
+public:
+	TraceProfiler();
+	~TraceProfiler();
+
+	/*!
+	 * Start recording events into a trace file, a running recording is stopped before
+	 * \param path The path of the json file to write
+	 */
+	void start(const std::string &path);
+
+	/*!
+	 * Stop recording, write all remaining events and close the trace file
+	 */
+	void stop();
+
+	/*!
+	 * Get if events are currently recorded
+	 * \return If the profiler is recording
+	 */
+	bool isRecording() const;
+
+	/*!
+	 * Record a zone of the current thread
+	 * \param name The name of the zone
+	 * \param start The start time of the zone as returned by now()
+	 * \param end The end time of the zone as returned by now()
+	 */
+	void addZone(const char *name, int64_t start, int64_t end);
+
+	/*!
+	 * Record the end of a frame
+	 */
+	void addFrame();
+
+	/*!
+	 * Record the current value of a counter
+	 * \param name The name of the counter
+	 * \param value The value of the counter
+	 */
+	void addCounter(const char *name, double value);
+
+	/*!
+	 * Set the name of the current thread, which is shown for its events in the trace
+	 * \param name The name of the thread
+	 */
+	void setThreadName(const std::string &name);
+
+	/*!
+	 * Get the current time in nanoseconds for recording zones
+	 * \return The current time
+	 */
+	static int64_t now();
+
+private:
+	enum EventType {
+		kZone,
+		kFrame,
+		kCounter
+	};
+
+	struct Event {
+		EventType type;
+		const char *name;
+		int64_t start;
+		int64_t duration;
+		double value;
+	};
+
+	struct ThreadBuffer {
+		std::mutex access;
+		std::vector<Event> events;
+		uint32_t id;
+		std::string name;
+	};
+
+	ThreadBuffer &getThreadBuffer();
+	void addEvent(const Event &event);
+	void flush(ThreadBuffer &buffer);
+	void writeEvent(const std::string &json);
+
+	std::atomic_bool _recording;
+
+	// Guards the thread buffers list, the trace file and the start time
+	std::mutex _access;
+	std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+	std::unique_ptr<WriteFile> _file;
+	int64_t _startTime;
+	bool _firstEvent;
+};
+
+/*!
+ * \brief Zone of the built-in profiler measuring the time until it is destroyed
+ */
+class TraceZone : Noncopyable {
+public:
+	explicit TraceZone(const char *name);
+	~TraceZone();
+
+private:
+	const char *_name;
+	int64_t _start;
+};
+
+} // End of namespace Common
+
+#endif //OPENAWE_PROFILER_H
@@ -19,53 +19,186 @@
  */
 
 #include <filesystem>
+#include <algorithm>
+#include <cstring>
 #include <assert.h>
 
 #include "src/common/readfile.h"
 #include "src/common/exception.h"
 
+#if OS_LINUX || OS_MACOS
+#	include <fcntl.h>
+#	include <unistd.h>
+#elif OS_WINDOWS
+#	include <windows.h>
+#endif
+
 namespace Common {
 
 ReadFile::ReadFile(const std::string &file) :
 	_fileSize(std::filesystem::file_size(file)),
-	_in(file.c_str(), std::ios::in | std::ios::binary) {
+	_position(0),
+	_failed(false),
+	_buffer(std::make_unique<byte[]>(kBufferSize)),
+	_bufferOffset(0),
+	_bufferSize(0) {
 	if (!std::filesystem::is_regular_file(file))
 		throw Common::Exception("{} not found", file);
+
+#if OS_LINUX || OS_MACOS
+	_fd = open(file.c_str(), O_RDONLY);
+	if (_fd < 0)
+		throw Common::Exception("Failed to open {}", file);
+#elif OS_WINDOWS
+	_handle = CreateFileA(
+		file.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if (_handle == INVALID_HANDLE_VALUE)
+		throw Common::Exception("Failed to open {}", file);
+#endif
+}
+
+ReadFile::~ReadFile() {
+#if OS_LINUX || OS_MACOS
+	close(_fd);
+#elif OS_WINDOWS
+	CloseHandle(_handle);
+#endif
 }
 
 size_t ReadFile::read(void *data, size_t length) {
-	_in.read(reinterpret_cast<char *>(data), length);
+	if (_failed)
+		return 0;
+
+	byte *out = reinterpret_cast<byte *>(data);
+	size_t readSize = 0;
+	while (readSize < length) {
+		// Copy whatever the buffer already holds at the current position
+		if (_position >= _bufferOffset && _position < _bufferOffset + _bufferSize) {
+			const size_t bufferPosition = _position - _bufferOffset;
+			const size_t copySize = std::min(length - readSize, _bufferSize - bufferPosition);
+			std::memcpy(out + readSize, _buffer.get() + bufferPosition, copySize);
+			readSize += copySize;
+			_position += copySize;
+			continue;
+		}
+
+		// Large reads bypass the buffer and go directly into the destination
+		if (length - readSize >= kBufferSize) {
+			const size_t directSize = readAt(_position, out + readSize, length - readSize);
+			readSize += directSize;
+			_position += directSize;
+			break;
+		}
+
+		_bufferOffset = _position;
+		_bufferSize = _position < _fileSize ? readAt(_position, _buffer.get(), kBufferSize) : 0;
+		if (_bufferSize == 0)
+			break;
+	}
 
-	return _in.gcount();
+	if (readSize < length)
+		_failed = true;
+
+	return readSize;
+}
+
+size_t ReadFile::readAt(size_t offset, void *data, size_t length) {
+#if OS_LINUX || OS_MACOS
+	size_t readSize = 0;
+	while (readSize < length) {
+		const auto result = pread(
+			_fd,
+			reinterpret_cast<byte *>(data) + readSize,
+			length - readSize,
+			static_cast<off_t>(offset + readSize)
+		);
+
+		if (result < 0)
+			throw Common::Exception("Failed to read {} bytes at offset {}", length, offset);
+		if (result == 0)
+			break;
+
+		readSize += result;
+	}
+
+	return readSize;
+#elif OS_WINDOWS
+	size_t readSize = 0;
+	while (readSize < length) {
+		OVERLAPPED overlapped{};
+		overlapped.Offset = static_cast<DWORD>((offset + readSize) & 0xFFFFFFFF);
+		overlapped.OffsetHigh = static_cast<DWORD>((offset + readSize) >> 32);
+
+		DWORD result = 0;
+		const DWORD chunkSize = static_cast<DWORD>(std::min<size_t>(length - readSize, 0x80000000));
+		if (!::ReadFile(_handle, reinterpret_cast<byte *>(data) + readSize, chunkSize, &result, &overlapped)) {
+			if (GetLastError() == ERROR_HANDLE_EOF)
+				break;
+			throw Common::Exception("Failed to read {} bytes at offset {}", length, offset);
+		}
+		if (result == 0)
+			break;
+
+		readSize += result;
+	}
+
+	return readSize;
+#endif
+}
+
+bool ReadFile::isConcurrent() const {
+#if OS_LINUX || OS_MACOS || OS_WINDOWS
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ReadFile::prefetch(size_t offset, size_t length) const {
+#if OS_LINUX
+	posix_fadvise(_fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#endif
 }
 
 void ReadFile::seek(ptrdiff_t length, ReadStream::SeekOrigin origin) {
+	ptrdiff_t position = 0;
 	switch (origin) {
 		case BEGIN:
-			_in.seekg(length, std::ios::beg);
+			position = length;
 			break;
 		case CURRENT:
-			_in.seekg(length, std::ios::cur);
+			position = static_cast<ptrdiff_t>(_position) + length;
 			break;
 		case END:
-			_in.seekg(length, std::ios::end);
+			position = static_cast<ptrdiff_t>(_fileSize) + length;
 			break;
 	}
+
+	if (position < 0) {
+		_failed = true;
+		return;
+	}
+
+	_position = static_cast<size_t>(position);
+	_failed = false;
 }
 
 bool ReadFile::eos() const {
-	return _in.peek() == EOF;
+	return _failed || _position >= _fileSize;
 }
 
 size_t ReadFile::pos() const {
-    if (_in.fail())
-        throw Common::Exception("File stream failed");
-
-    const auto pos = _in.tellg();
-    if (pos == std::istream::pos_type(-1))
-		throw Common::Exception("Invalid file stream position");
+	if (_failed)
+		throw Common::Exception("File stream failed");
 
-	return _in.tellg();
+	return _position;
 }
 
 size_t ReadFile::size() const {
@@ -22,7 +22,7 @@
 #define SRC_COMMON_READFILE_H
 
 #include <string>
-#include <fstream>
+#include <memory>
 
 #include "src/common/readstream.h"
 
@@ -32,7 +32,8 @@ namespace Common {
  * \brief Class for accessing files as a ReadStream
  *
  * This class offers the possibility to access a file using a ReadStream. It offers the common methods which the base
- * ReadStream class accesses.
+ * ReadStream class accesses. Sequential reads go through a user space buffer filled by positional reads on a native
+ * file handle, and the position is tracked by the class itself, so that many small reads stay cheap.
  */
 class ReadFile : public ReadStream {
 public:
@@ -42,16 +43,42 @@ public:
 	 * \param file the file to read
 	 */
 	ReadFile(const std::string &file);
+	~ReadFile();
 
 	/*!
-	 * Read a generic chunk of data
+	 * Read a generic chunk of data. If less than the requested length could be read, the stream is marked as failed
+	 * until the next seek.
 	 * \param data the data buffer to read
 	 * \param length the length to read
 	 */
 	size_t read(void *data, size_t length) override;
 
 	/*!
-	 * Get the current position in the file
+	 * Read a generic chunk of data at an absolute offset. This uses positional reads on the native file handle, so
+	 * that it can be called from multiple threads without locking and without affecting the position of the
+	 * sequential read functions.
+	 * \param offset The offset in the file from which to read
+	 * \param data the data buffer to read
+	 * \param length the length to read
+	 * \return The number of bytes actually read
+	 */
+	size_t readAt(size_t offset, void *data, size_t length) override;
+
+	/*!
+	 * If positional reads are available on this platform and can be used concurrently
+	 * \return If readAt can be called from multiple threads at once
+	 */
+	bool isConcurrent() const override;
+
+	/*!
+	 * Advise the operating system to read a range of the file ahead of time
+	 * \param offset the offset of the range in the file
+	 * \param length the length of the range
+	 */
+	void prefetch(size_t offset, size_t length) const override;
+
+	/*!
+	 * Get the current position in the file. Throws if a previous read failed.
 	 * \return The current position  in the file
 	 */
 	size_t pos() const override;
@@ -63,7 +90,8 @@ public:
 	bool eos() const override;
 
 	/*!
-	 * Seek in the file according to a certain origin
+	 * Seek in the file according to a certain origin. This resets a previous failed read. Seeking before the start of
+	 * the file marks the stream as failed.
 	 * \param length The amount to seek from the origin. Can be negative too
 	 * \param origin The origin from which to seek. Can be the begin and end of the file or the current position
 	 */
@@ -72,8 +100,24 @@ public:
 	size_t size() const override;
 
 private:
+	static constexpr size_t kBufferSize = 64 * 1024;
+
 	const size_t _fileSize;
-	mutable std::ifstream _in;
+
+	size_t _position;
+	bool _failed;
+
+	std::unique_ptr<byte[]> _buffer;
+	size_t _bufferOffset;
+	size_t _bufferSize;
+
+#if OS_LINUX || OS_MACOS
+	int _fd;
+#elif OS_WINDOWS
+	void *_handle;
+#else
+#	error "ReadFile needs a native file handle on this platform"
+#endif
 };
 
 } // End of namespace Common
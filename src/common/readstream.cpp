@@ -21,7 +21,6 @@
 #include <cstring>
 
 #include <iostream>
-#include <regex>
 
 #include "src/common/endianness.h"
 #include "src/common/readstream.h"
@@ -146,7 +145,7 @@ std::string ReadStream::readNullTerminatedString() {
 std::string ReadStream::readNullTerminatedString(size_t stepSize) {
 	std::stringstream ss;
 	std::string s = readFixedSizeString(stepSize);
-	while (!std::regex_match(s, std::regex(".*\\0$"))) {
+	while (s.empty() || s.back() != '\0') {
 		ss << s;
 		s = readFixedSizeString(stepSize);
 	}
@@ -180,6 +179,25 @@ Common::ReadStream *ReadStream::readStream(size_t length) {
 	return new Common::MemoryReadStream(stream.getData(), stream.getLength());
 }
 
+size_t ReadStream::readAt(size_t offset, void *data, size_t length) {
+	const size_t lastPos = pos();
+	seek(offset);
+	const size_t readSize = read(data, length);
+	seek(lastPos);
+	return readSize;
+}
+
+bool ReadStream::isConcurrent() const {
+	return false;
+}
+
+std::span<const byte> ReadStream::getView(size_t /*offset*/, size_t /*length*/) const {
+	return {};
+}
+
+void ReadStream::prefetch(size_t /*offset*/, size_t /*length*/) const {
+}
+
 void ReadStream::skip(ptrdiff_t offset) {
 	seek(offset, CURRENT);
 }
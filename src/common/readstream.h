@@ -24,10 +24,13 @@
 #include <cstdint>
 #include <cstddef>
 
+#include <bit>
 #include <string>
 #include <span>
+#include <type_traits>
 
 #include "src/common/types.h"
+#include "src/common/endianness.h"
 
 namespace Common {
 
@@ -196,6 +199,62 @@ public:
 		return read(s.data(), s.size_bytes());
 	}
 
+	/*!
+	 * Read an array of little endian values with a single read and convert
+	 * them to the native endianness in place
+	 * \tparam T The arithmetic type of the values
+	 * \param values The span to read the values into
+	 * \return The number of complete values read
+	 */
+	template<typename T, size_t Extent> requires std::is_arithmetic_v<T>
+	size_t readArrayLE(std::span<T, Extent> values) {
+		const size_t count = read(values.data(), values.size_bytes()) / sizeof(T);
+		if constexpr (std::endian::native == std::endian::big)
+			swapBytesArray(values.first(count));
+		return count;
+	}
+
+	/*!
+	 * Read an array of big endian values with a single read and convert
+	 * them to the native endianness in place
+	 * \tparam T The arithmetic type of the values
+	 * \param values The span to read the values into
+	 * \return The number of complete values read
+	 */
+	template<typename T, size_t Extent> requires std::is_arithmetic_v<T>
+	size_t readArrayBE(std::span<T, Extent> values) {
+		const size_t count = read(values.data(), values.size_bytes()) / sizeof(T);
+		if constexpr (std::endian::native == std::endian::little)
+			swapBytesArray(values.first(count));
+		return count;
+	}
+
+	/*!
+	 * Read an array of little endian glm vectors, component by component
+	 * \param values The span to read the vectors into
+	 * \return The number of complete vectors read
+	 */
+	template<typename V, size_t Extent> requires std::is_arithmetic_v<typename V::value_type>
+	size_t readArrayLE(std::span<V, Extent> values) {
+		using T = typename V::value_type;
+		constexpr size_t components = V::length();
+		static_assert(sizeof(V) == components * sizeof(T));
+		return readArrayLE(std::span<T>(reinterpret_cast<T *>(values.data()), values.size() * components)) / components;
+	}
+
+	/*!
+	 * Read an array of big endian glm vectors, component by component
+	 * \param values The span to read the vectors into
+	 * \return The number of complete vectors read
+	 */
+	template<typename V, size_t Extent> requires std::is_arithmetic_v<typename V::value_type>
+	size_t readArrayBE(std::span<V, Extent> values) {
+		using T = typename V::value_type;
+		constexpr size_t components = V::length();
+		static_assert(sizeof(V) == components * sizeof(T));
+		return readArrayBE(std::span<T>(reinterpret_cast<T *>(values.data()), values.size() * components)) / components;
+	}
+
 	/*!
 	 * Read a generic chunk of data into the data pointer
 	 * with length specified in length
@@ -205,6 +264,44 @@ public:
 	 */
 	virtual size_t read(void *data, size_t length) = 0;
 
+	/*!
+	 * Read a generic chunk of data from an absolute offset without changing
+	 * the current position of the stream. The default implementation seeks,
+	 * reads and restores the position and is therefore not safe to be called
+	 * from multiple threads at once.
+	 * \param offset the absolute offset from which to read
+	 * \param data the data pointer in which to write the read data
+	 * \param length the length of the data to read
+	 * \return the length of the read data
+	 */
+	virtual size_t readAt(size_t offset, void *data, size_t length);
+
+	/*!
+	 * Check if readAt can be called from multiple threads at the same time
+	 * \return If concurrent positional reads are supported by this stream
+	 */
+	virtual bool isConcurrent() const;
+
+	/*!
+	 * Get a view into the memory backing this stream, if the stream is
+	 * completely held in memory, like memory mapped files. The view stays
+	 * valid as long as the stream exists. If the stream is not backed by
+	 * memory or the range exceeds the stream, an empty span is returned.
+	 * \param offset the absolute offset of the view
+	 * \param length the length of the view
+	 * \return a span containing the requested range or an empty span
+	 */
+	virtual std::span<const byte> getView(size_t offset, size_t length) const;
+
+	/*!
+	 * Hint that a range of the stream will be read soon, so that it can be
+	 * loaded ahead of time, for example by the read ahead of the operating
+	 * system. The default implementation does nothing.
+	 * \param offset the absolute offset of the range
+	 * \param length the length of the range
+	 */
+	virtual void prefetch(size_t offset, size_t length) const;
+
 	/*!
 	 * Seek a specified length from a specified origin, which
 	 * is either the beginning, the end or the current position
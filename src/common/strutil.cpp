@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <regex>
+#include <algorithm>
 
 #include "src/common/exception.h"
 
@@ -64,6 +65,36 @@ std::vector<std::string> split(const std::string &str, const std::regex &split)
 	return result;
 }
 
+std::vector<std::string> split(std::string_view str, char delimiter) {
+	std::vector<std::string> result;
+	for (const auto part : Tokenizer(str, delimiter))
+		result.emplace_back(part);
+
+	return result;
+}
+
+void toLowerInPlace(std::string &str) {
+	for (auto &c : str) {
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+	}
+}
+
+void foldSlashes(std::string &path) {
+	std::replace(path.begin(), path.end(), '\\', '/');
+}
+
+void replaceInPlace(std::string &str, std::string_view what, std::string_view with) {
+	if (what.empty())
+		return;
+
+	size_t position = str.find(what);
+	while (position != std::string::npos) {
+		str.replace(position, what.size(), with);
+		position = str.find(what, position + with.size());
+	}
+}
+
 std::string extract(const std::string &str, const std::regex &pattern) {
 	std::smatch match;
 	if(std::regex_search(str, match, pattern))
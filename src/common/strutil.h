@@ -25,6 +25,8 @@
 #include <vector>
 #include <regex>
 #include <charconv>
+#include <string_view>
+#include <iterator>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
@@ -104,6 +106,121 @@ std::string replace(const std::string &str, const std::string &what, const std::
  */
 std::vector<std::string> split(const std::string &str, const std::regex &split);
 
+/*!
+ * Split a string by a delimiter character. Unlike the regex based variant,
+ * no regex has to be built and matched for every call.
+ * \param str the string to split
+ * \param delimiter the character to split the string at
+ * \return a vector of split strings
+ */
+std::vector<std::string> split(std::string_view str, char delimiter);
+
+/*!
+ * \brief Iterate over the parts of a string split by a delimiter character
+ *
+ * The parts are views into the original string, so iterating over them
+ * doesn't allocate any memory. The string has to outlive the tokenizer. The
+ * parts are the same as with split, including empty parts between two
+ * delimiters, except for an empty last part which is skipped:
+ *
+ * \code
+ * for (const auto part : Common::Tokenizer("a/b//c/", '/'))
+ *     // "a", "b", "", "c"
+ * \endcode
+ */
+class Tokenizer {
+public:
+	class Iterator {
+	public:
+		typedef std::string_view value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::forward_iterator_tag iterator_category;
+
+		Iterator() = default;
+
+		constexpr Iterator(std::string_view str, char delimiter) : _rest(str), _delimiter(delimiter), _end(false) {
+			findToken();
+		}
+
+		constexpr std::string_view operator*() const {
+			return _token;
+		}
+
+		constexpr Iterator &operator++() {
+			// The last part ends at the end of the string, an empty part after a trailing delimiter is skipped
+			if (_token.size() == _rest.size() || _token.size() + 1 == _rest.size()) {
+				_end = true;
+				return *this;
+			}
+
+			_rest.remove_prefix(_token.size() + 1);
+			findToken();
+			return *this;
+		}
+
+		constexpr Iterator operator++(int) {
+			Iterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		constexpr bool operator==(const Iterator &other) const {
+			if (_end || other._end)
+				return _end == other._end;
+			return _token.data() == other._token.data();
+		}
+
+	private:
+		constexpr void findToken() {
+			_token = _rest.substr(0, _rest.find(_delimiter));
+		}
+
+		std::string_view _rest;
+		std::string_view _token;
+		char _delimiter{0};
+		bool _end{true};
+	};
+
+	constexpr Tokenizer(std::string_view str, char delimiter) : _str(str), _delimiter(delimiter) {
+	}
+
+	constexpr Iterator begin() const {
+		return Iterator(_str, _delimiter);
+	}
+
+	constexpr Iterator end() const {
+		return Iterator();
+	}
+
+private:
+	std::string_view _str;
+	char _delimiter;
+};
+
+/*!
+ * Change all ascii alpha letters of a string to lower case letters without
+ * allocating a new string
+ * \param str the string to change
+ */
+void toLowerInPlace(std::string &str);
+
+/*!
+ * Fold all backslashes of a path into forward slashes without allocating a
+ * new string
+ * \param path the path to change
+ */
+void foldSlashes(std::string &path);
+
+/*!
+ * Substitute all occurrences of one substring for another in a single pass
+ * over the string. The replaced parts are not searched again, so replacing
+ * a substring with a string containing it is allowed.
+ * \param str the string to replace in
+ * \param what the substring to search for
+ * \param with the substring to replace "what" with
+ */
+void replaceInPlace(std::string &str, std::string_view what, std::string_view with);
+
 /*!
  * Extract a certain pattern from a string
  * \param str The string to search for a pattern
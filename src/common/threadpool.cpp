@@ -18,81 +18,555 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
 #include <functional>
+#include <memory>
+#include <exception>
+#include <chrono>
+#include <optional>
 
 #include "src/common/threadpool.h"
 #include "src/common/exception.h"
+#include "src/common/profiler.h"
 
 namespace Common {
 
-ThreadPool::ThreadPool() : _threads(std::max<int>(std::thread::hardware_concurrency() - 1, 1)) {
-	_finished.store(false);
+/*!
+ * The pool and index of the worker running on the current thread, used to
+ * push tasks added from a worker onto its own deque
+ */
+static thread_local const ThreadPool *tCurrentPool = nullptr;
+static thread_local size_t tCurrentWorker = 0;
+
+/*!
+ * The priority of the task running on the current thread, which is inherited
+ * by the tasks it adds
+ */
+static thread_local TaskPriority tCurrentPriority = TaskPriority::kInteractive;
+
+/*!
+ * The number of workers which only run realtime tasks
+ */
+static const size_t kNumRealtimeWorkers = 1;
+
+/*!
+ * The id of the timer whose task is running on the current thread, so that
+ * a task can cancel itself without waiting for itself
+ */
+static thread_local TimerId tCurrentTimer = 0;
+
+ThreadPool::ThreadPool() :
+	_finished(false),
+	_running(0),
+	_queued(0),
+	_sleeping(0),
+	_sleepingRealtime(0),
+	_nextWorker(0),
+	_numWorkers(std::max<int>(std::thread::hardware_concurrency() - 1, 1)),
+	_nextTimerId(1) {
+	// All deques have to exist before the first worker starts stealing. The realtime workers are placed behind the
+	// normal workers.
+	for (size_t i = 0; i < _numWorkers + kNumRealtimeWorkers; ++i) {
+		_workers.emplace_back(std::make_unique<Worker>());
+		_workers.back()->realtime = i >= _numWorkers;
+	}
 
-	unsigned int i = 0;
-	for (auto &thread : _threads) {
-		thread = std::thread(std::bind(&ThreadPool::run, this));
+	for (size_t i = 0; i < _workers.size(); ++i) {
+		auto &thread = _workers[i]->thread;
+		thread = std::thread(&ThreadPool::run, this, i);
 
 #if OS_LINUX
 		pthread_setname_np(
 				thread.native_handle(),
-				std::format("Worker Thread {}", i++).c_str()
+				_workers[i]->realtime ?
+					std::format("RT Worker {}", i - _numWorkers).c_str() :
+					std::format("Worker Thread {}", i).c_str()
 		);
 #endif
 	}
+
+	_timerThread = std::thread(&ThreadPool::runTimers, this);
+
+#if OS_LINUX
+	pthread_setname_np(_timerThread.native_handle(), "Timer Thread");
+#endif
 }
 
 ThreadPool::~ThreadPool() {
-	_finished.store(true);
-	_taskCond.notify_all();
-	for (auto &thread : _threads) {
-		if (thread.joinable())
-			thread.join();
+	// The timer thread adds tasks while holding the timer lock, so it has to be stopped before the workers
+	{
+		std::lock_guard<std::mutex> l(_timerAccess);
+		_finished.store(true);
+	}
+	_timerCond.notify_all();
+
+	if (_timerThread.joinable())
+		_timerThread.join();
+
+	// Taking the lock makes sure no worker is between checking for the end and going to sleep
+	{
+		std::lock_guard<std::mutex> l(_sleepAccess);
+	}
+	_sleepCond.notify_all();
+	_realtimeCond.notify_all();
+
+	for (auto &worker : _workers) {
+		if (worker->thread.joinable())
+			worker->thread.join();
 	}
 }
 
 void ThreadPool::add(Runnable runnable) {
-	std::lock_guard<std::mutex> l(_taskAccess);
+	add(std::move(runnable), tCurrentPool == this ? tCurrentPriority : TaskPriority::kInteractive);
+}
+
+void ThreadPool::add(Runnable runnable, TaskPriority priority) {
 	if (!runnable)
 		throw CreateException("Invalid runnable object given");
 
-	_tasks.push(runnable);
-	_taskCond.notify_one();
+	const auto lane = static_cast<size_t>(priority);
+
+	// Tasks from outside of the pool or from realtime workers are distributed over the normal workers
+	size_t index = getCurrentWorker();
+	if (index >= _numWorkers)
+		index = _nextWorker++ % _numWorkers;
+
+	// The task is counted before it is pushed, so that it can't be taken before it is counted
+	_lanes[lane].queued++;
+	_queued++;
+	{
+		auto &worker = *_workers[index];
+		std::lock_guard<std::mutex> l(worker.access);
+		worker.tasks[lane].emplace_back(Task{std::move(runnable), std::chrono::steady_clock::now()});
+	}
+
+	// Only take the sleep lock if a worker might be sleeping. The counters are sequentially consistent, so either
+	// this thread sees the sleeping worker or the worker sees the new task before going to sleep. Realtime tasks
+	// prefer the realtime workers, so the normal workers can stay busy with their tasks.
+	if (priority == TaskPriority::kRealtime && _sleepingRealtime > 0) {
+		std::lock_guard<std::mutex> l(_sleepAccess);
+		_realtimeCond.notify_one();
+	} else if (_sleeping > 0) {
+		std::lock_guard<std::mutex> l(_sleepAccess);
+		_sleepCond.notify_one();
+	}
+}
+
+TimerId ThreadPool::addAfter(std::chrono::steady_clock::duration delay, Runnable runnable, TaskPriority priority) {
+	return addTimer(delay, std::chrono::steady_clock::duration::zero(), std::move(runnable), priority);
+}
+
+TimerId ThreadPool::addPeriodic(
+	std::chrono::steady_clock::duration interval,
+	Runnable runnable,
+	TaskPriority priority
+) {
+	if (interval <= std::chrono::steady_clock::duration::zero())
+		throw CreateException("Invalid interval for periodic task given");
+
+	return addTimer(interval, interval, std::move(runnable), priority);
+}
+
+bool ThreadPool::cancel(TimerId id) {
+	std::unique_lock<std::mutex> lock(_timerAccess);
+	const auto iter = _timers.find(id);
+	if (iter == _timers.end())
+		return false;
+
+	// The entry in the timer heap is skipped when it is due
+	const auto timer = iter->second;
+	timer->cancelled = true;
+	_timers.erase(iter);
+
+	if (tCurrentTimer == id)
+		return true;
+
+	// Wait for a queued or running call. Other tasks are not run meanwhile, since this might be called from the main
+	// thread, which must not pick up long running tasks or their exceptions.
+	_timerDone.wait(lock, [&] { return !timer->active; });
+
+	timer->runnable = nullptr;
+
+	return true;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &function) {
+	parallelFor(0, count, 1, [&function](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			function(i);
+	});
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &function) {
+	if (begin >= end)
+		return;
+
+	grain = std::max<size_t>(grain, 1);
+	const size_t count = (end - begin + grain - 1) / grain;
+
+	if (count == 1) {
+		function(begin, end);
+		return;
+	}
+
+	/*
+	 * Chunks are claimed through a shared counter by the calling thread and
+	 * a number of helper tasks. Helpers which start after all chunks are
+	 * claimed return without touching the function, which might not exist
+	 * anymore at that point.
+	 */
+	struct Job {
+		const std::function<void(size_t, size_t)> *function{nullptr};
+		size_t begin{0}, end{0}, grain{0}, count{0};
+		std::atomic_size_t next{0};
+		std::atomic_size_t finished{0};
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+
+	const auto job = std::make_shared<Job>();
+	job->function = &function;
+	job->begin = begin;
+	job->end = end;
+	job->grain = grain;
+	job->count = count;
+
+	const auto work = [job]() {
+		size_t chunk;
+		while ((chunk = job->next++) < job->count) {
+			const size_t chunkBegin = job->begin + chunk * job->grain;
+			const size_t chunkEnd = std::min(chunkBegin + job->grain, job->end);
+
+			try {
+				(*job->function)(chunkBegin, chunkEnd);
+			} catch (...) {
+				std::lock_guard<std::mutex> l(job->mutex);
+				if (!job->error)
+					job->error = std::current_exception();
+			}
+
+			if (++job->finished == job->count) {
+				std::lock_guard<std::mutex> l(job->mutex);
+				job->done.notify_all();
+			}
+		}
+	};
+
+	const auto numHelpers = std::min(count - 1, getNumWorkerThreads());
+	for (size_t i = 0; i < numHelpers; ++i)
+		add(work);
+
+	work();
+
+	std::unique_lock<std::mutex> lock(job->mutex);
+	job->done.wait(lock, [&] { return job->finished == job->count; });
+
+	if (job->error)
+		std::rethrow_exception(job->error);
 }
 
 bool ThreadPool::empty() const {
-	std::lock_guard<std::mutex> l(_taskAccess);
-	return _tasks.empty() && _running == 0;
+	// A task is counted as running before it is removed from the queued tasks
+	return _queued == 0 && _running == 0;
 }
 
 size_t ThreadPool::getQueuedTasks() const {
-	std::lock_guard<std::mutex> l(_taskAccess);
-	return _tasks.size();
+	return _queued;
 }
 
 size_t ThreadPool::getNumWorkerThreads() const {
-	return _threads.size();
+	return _numWorkers;
 }
 
-void ThreadPool::run() {
-	while (true) {
-		std::unique_lock<std::mutex> lock(_taskAccess);
-		if (_tasks.empty())
-			_taskCond.wait(lock, [&] {return !_tasks.empty() || _finished; });
+size_t ThreadPool::getNumRealtimeWorkerThreads() const {
+	return _workers.size() - _numWorkers;
+}
+
+size_t ThreadPool::getQueuedTasks(TaskPriority priority) const {
+	return _lanes[static_cast<size_t>(priority)].queued;
+}
+
+size_t ThreadPool::getStartedTasks(TaskPriority priority) const {
+	return _lanes[static_cast<size_t>(priority)].started;
+}
+
+std::chrono::nanoseconds ThreadPool::getWaitTime(TaskPriority priority) const {
+	return std::chrono::nanoseconds(_lanes[static_cast<size_t>(priority)].waitTime);
+}
+
+std::chrono::nanoseconds ThreadPool::getMaxWaitTime(TaskPriority priority) const {
+	return std::chrono::nanoseconds(_lanes[static_cast<size_t>(priority)].maxWaitTime);
+}
+
+bool ThreadPool::takeTask(size_t index, Runnable &task, TaskPriority &priority) {
+	if (_queued == 0)
+		return false;
+
+	// Realtime workers only take realtime tasks
+	const bool realtime = index < _workers.size() && _workers[index]->realtime;
+	const size_t numLanes = realtime ? 1 : kNumPriorities;
+
+	for (size_t lane = 0; lane < numLanes; ++lane) {
+		if (_lanes[lane].queued == 0)
+			continue;
+
+		std::optional<Task> taken;
+
+		// Take the newest task of the own deque, its data is most likely still in the cache
+		if (index < _workers.size()) {
+			auto &worker = *_workers[index];
+			std::lock_guard<std::mutex> l(worker.access);
+			if (!worker.tasks[lane].empty()) {
+				taken = std::move(worker.tasks[lane].back());
+				worker.tasks[lane].pop_back();
+			}
+		}
 
-		if (_finished)
-			return;
+		// Steal the oldest task of another worker
+		for (size_t i = 1; i <= _workers.size() && !taken; ++i) {
+			auto &victim = *_workers[(index + i) % _workers.size()];
+			std::lock_guard<std::mutex> l(victim.access);
+			if (!victim.tasks[lane].empty()) {
+				taken = std::move(victim.tasks[lane].front());
+				victim.tasks[lane].pop_front();
+			}
+		}
+
+		if (!taken)
+			continue;
 
 		_running++;
-		Runnable runnable = _tasks.front();
-		if (!runnable)
-			throw CreateException("Invalid runnable object given");
-		_tasks.pop();
-		lock.unlock();
-
-		runnable();
-		_running--;
+		_lanes[lane].queued--;
+		_queued--;
+
+		const uint64_t waitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - taken->added
+		).count();
+		_lanes[lane].started++;
+		_lanes[lane].waitTime += waitTime;
+		uint64_t maxWaitTime = _lanes[lane].maxWaitTime;
+		while (waitTime > maxWaitTime && !_lanes[lane].maxWaitTime.compare_exchange_weak(maxWaitTime, waitTime)) {}
+
+		task = std::move(taken->runnable);
+		priority = static_cast<TaskPriority>(lane);
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::runTask(Runnable &task, TaskPriority priority) {
+	// Restore the priority and the counter even if the task throws, so that the pool can become empty again
+	struct RunningGuard {
+		std::atomic_size_t &running;
+		const TaskPriority previousPriority;
+
+		~RunningGuard() {
+			tCurrentPriority = previousPriority;
+			running--;
+		}
+	} guard{_running, tCurrentPriority};
+
+	tCurrentPriority = priority;
+
+	PROFILE_ZONE("Task");
+	task();
+}
+
+bool ThreadPool::runPendingTask() {
+	Runnable task;
+	TaskPriority priority;
+	if (!takeTask(getCurrentWorker(), task, priority))
+		return false;
+
+	runTask(task, priority);
+	return true;
+}
+
+size_t ThreadPool::getCurrentWorker() const {
+	return tCurrentPool == this ? tCurrentWorker : _workers.size();
+}
+
+void ThreadPool::run(size_t index) {
+	tCurrentPool = this;
+	tCurrentWorker = index;
+
+	const bool realtime = _workers[index]->realtime;
+	PROFILE_THREAD_NAME(
+		realtime ? std::format("RT Worker {}", index - _numWorkers) : std::format("Worker Thread {}", index)
+	);
+
+	auto &sleeping = realtime ? _sleepingRealtime : _sleeping;
+	auto &cond = realtime ? _realtimeCond : _sleepCond;
+	const auto &queued = realtime ? _lanes[static_cast<size_t>(TaskPriority::kRealtime)].queued : _queued;
+
+	while (!_finished) {
+		Runnable task;
+		TaskPriority priority;
+		if (takeTask(index, task, priority)) {
+			runTask(task, priority);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepAccess);
+		sleeping++;
+		cond.wait(lock, [&] { return queued > 0 || _finished; });
+		sleeping--;
 	}
 }
 
-}
\ No newline at end of file
+TimerId ThreadPool::addTimer(
+	std::chrono::steady_clock::duration delay,
+	std::chrono::steady_clock::duration interval,
+	Runnable runnable,
+	TaskPriority priority
+) {
+	if (!runnable)
+		throw CreateException("Invalid runnable object given");
+
+	auto timer = std::make_shared<Timer>();
+	timer->priority = priority;
+	timer->interval = interval;
+	timer->runnable = std::move(runnable);
+
+	const auto due = std::chrono::steady_clock::now() + delay;
+
+	std::lock_guard<std::mutex> l(_timerAccess);
+	timer->id = _nextTimerId++;
+	_timers[timer->id] = timer;
+
+	// Only wake the timer thread if the new timer has to fire before the one it is waiting for
+	const bool earliest = _timerQueue.empty() || due < _timerQueue.top().first;
+	_timerQueue.emplace(due, timer);
+	if (earliest)
+		_timerCond.notify_one();
+
+	return timer->id;
+}
+
+void ThreadPool::runTimers() {
+	PROFILE_THREAD_NAME("Timer Thread");
+
+	std::unique_lock<std::mutex> lock(_timerAccess);
+	while (!_finished) {
+		if (_timerQueue.empty()) {
+			_timerCond.wait(lock);
+			continue;
+		}
+
+		const auto due = _timerQueue.top().first;
+		if (std::chrono::steady_clock::now() < due) {
+			_timerCond.wait_until(lock, due);
+			continue;
+		}
+
+		const auto timer = _timerQueue.top().second;
+		_timerQueue.pop();
+		if (timer->cancelled)
+			continue;
+
+		timer->active = true;
+		add([this, timer]() { runTimer(timer); }, timer->priority);
+	}
+}
+
+void ThreadPool::runTimer(const std::shared_ptr<Timer> &timer) {
+	// The run is finished even if the task throws, so that cancelling the timer doesn't wait forever. Timer tasks
+	// might run other timer tasks while waiting for a task group, so the previous timer is restored afterwards.
+	struct TimerGuard {
+		ThreadPool &pool;
+		const std::shared_ptr<Timer> &timer;
+		const TimerId previousTimer;
+
+		~TimerGuard() {
+			tCurrentTimer = previousTimer;
+			pool.finishTimer(timer);
+		}
+	} guard{*this, timer, tCurrentTimer};
+
+	tCurrentTimer = timer->id;
+	timer->runnable();
+}
+
+void ThreadPool::finishTimer(const std::shared_ptr<Timer> &timer) {
+	std::lock_guard<std::mutex> l(_timerAccess);
+	timer->active = false;
+
+	if (timer->interval > std::chrono::steady_clock::duration::zero() && !timer->cancelled) {
+		const auto due = std::chrono::steady_clock::now() + timer->interval;
+		const bool earliest = _timerQueue.empty() || due < _timerQueue.top().first;
+		_timerQueue.emplace(due, timer);
+		if (earliest)
+			_timerCond.notify_one();
+	} else {
+		_timers.erase(timer->id);
+		timer->runnable = nullptr;
+	}
+
+	_timerDone.notify_all();
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool) : _pool(pool), _pending(0) {
+}
+
+TaskGroup::~TaskGroup() {
+	try {
+		wait();
+	} catch (...) {
+	}
+}
+
+void TaskGroup::run(Runnable runnable) {
+	if (!runnable)
+		throw CreateException("Invalid runnable object given");
+
+	_pending++;
+	_pool.add([this, runnable = std::move(runnable)]() {
+		std::exception_ptr error;
+		try {
+			runnable();
+		} catch (...) {
+			error = std::current_exception();
+		}
+
+		// The group might be destroyed as soon as the lock is released after the last task
+		std::lock_guard<std::mutex> l(_access);
+		if (error && !_error)
+			_error = error;
+		if (--_pending == 0)
+			_done.notify_all();
+	});
+}
+
+void TaskGroup::wait() {
+	// Workers help with queued tasks instead of blocking, so that waiting from inside of tasks can't block the pool.
+	// Other threads only wait, so that they don't run unrelated tasks.
+	const bool helping = _pool.getCurrentWorker() < _pool._workers.size();
+
+	while (true) {
+		{
+			std::lock_guard<std::mutex> l(_access);
+			if (_pending == 0)
+				break;
+		}
+
+		if (helping && _pool.runPendingTask())
+			continue;
+
+		// All remaining tasks are running, but they might add new tasks while we wait
+		std::unique_lock<std::mutex> lock(_access);
+		if (helping)
+			_done.wait_for(lock, std::chrono::milliseconds(1), [&] { return _pending == 0; });
+		else
+			_done.wait(lock, [&] { return _pending == 0; });
+	}
+
+	std::lock_guard<std::mutex> l(_access);
+	if (_error) {
+		const auto error = _error;
+		_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+}
@@ -24,10 +24,18 @@
 #include <thread>
 #include <atomic>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
+#include <future>
+#include <exception>
+#include <type_traits>
+#include <chrono>
+#include <queue>
+#include <unordered_map>
+#include <cstdint>
 
 #include "src/common/singleton.h"
 
@@ -35,25 +43,305 @@ namespace Common {
 
 typedef std::function<void()> Runnable;
 
+/*!
+ * Identifier of a delayed or periodic task, 0 is never used as identifier
+ */
+typedef uint64_t TimerId;
+
+/*!
+ * Priority classes of tasks. Workers always take tasks of a higher priority
+ * first and a number of workers is reserved for realtime tasks, so that
+ * long running tasks can't delay them.
+ */
+enum class TaskPriority {
+	kRealtime, //!< Tasks which have to finish in time, like refilling audio buffers
+	kInteractive, //!< Tasks the user is waiting for, like decoding video frames
+	kBackground //!< Long running tasks like loading levels or prefetching files
+};
+
+/*!
+ * \brief Pool of worker threads with work stealing
+ *
+ * Every worker has its own task deque. Tasks added from a worker are pushed
+ * to its own deque and taken from there in last in, first out order, while
+ * tasks added from other threads are distributed over all deques. Idle
+ * workers steal the oldest tasks from the deques of the other workers, so
+ * that the workers only contend on a lock if they are working on the same
+ * deque.
+ *
+ * Delayed and periodic tasks are kept in a timer heap by a separate timer
+ * thread, which sleeps until the next task is due and then adds it to the
+ * workers, so that waiting tasks don't occupy a worker.
+ *
+ * Every deque is split into lanes for the task priorities. Additionally to
+ * the normal workers, which take tasks of all priorities, there are workers
+ * which only take realtime tasks.
+ */
 class ThreadPool : public Common::Singleton<ThreadPool> {
 public:
 	ThreadPool();
 	~ThreadPool();
 
+	/*!
+	 * Add a task with the priority of the task calling this method. If it
+	 * is called from outside of the pool, the task is interactive.
+	 * \param runnable The task to run
+	 */
 	void add(Runnable runnable);
+
+	/*!
+	 * Add a task with a specific priority
+	 * \param runnable The task to run
+	 * \param priority The priority of the task
+	 */
+	void add(Runnable runnable, TaskPriority priority);
+
+	/*!
+	 * Add a function to the pool and get a future for its result. If the
+	 * function throws, the exception is stored in the future.
+	 * \param function The function to run
+	 * \return A future receiving the result of the function
+	 */
+	template<typename F>
+	std::future<std::invoke_result_t<F>> submit(F &&function) {
+		typedef std::invoke_result_t<F> Result;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+		auto future = task->get_future();
+		add([task]() { (*task)(); });
+		return future;
+	}
+
+	/*!
+	 * Run a function for every index from 0 to count - 1 in parallel and
+	 * wait until all calls are finished. The calling thread takes part in
+	 * the work, so this method finishes even if all workers are busy and it
+	 * can be called from inside of a worker thread. If any call throws an
+	 * exception, the first exception is rethrown after all calls finished.
+	 * \param count The number of indices to run the function for
+	 * \param function The function to call with every index
+	 */
+	void parallelFor(size_t count, const std::function<void(size_t)> &function);
+
+	/*!
+	 * Split the range from begin to end into chunks of grain indices and run
+	 * a function for every chunk in parallel, with the same guarantees as
+	 * the index based parallelFor. Larger grains reduce the scheduling
+	 * overhead for cheap functions.
+	 * \param begin The first index of the range
+	 * \param end The index behind the last index of the range
+	 * \param grain The maximum number of indices per chunk
+	 * \param function The function to call with the begin and end of every chunk
+	 */
+	void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &function);
+
+	/*!
+	 * Add a task which is run once after a delay
+	 * \param delay The time after which the task is added to the workers
+	 * \param runnable The task to run
+	 * \param priority The priority of the task
+	 * \return The id of the timer, which can be used to cancel the task
+	 */
+	TimerId addAfter(
+		std::chrono::steady_clock::duration delay,
+		Runnable runnable,
+		TaskPriority priority = TaskPriority::kInteractive
+	);
+
+	/*!
+	 * Add a task which is run repeatedly until it is cancelled. The
+	 * interval is measured from the end of one run to the start of the
+	 * next one, so a periodic task never runs concurrently with itself.
+	 * \param interval The time between two runs of the task
+	 * \param runnable The task to run
+	 * \param priority The priority of the task
+	 * \return The id of the timer, which can be used to cancel the task
+	 */
+	TimerId addPeriodic(
+		std::chrono::steady_clock::duration interval,
+		Runnable runnable,
+		TaskPriority priority = TaskPriority::kInteractive
+	);
+
+	/*!
+	 * Cancel a delayed or periodic task. If a run of the task is already
+	 * queued or running, this method waits until it finished, so that the
+	 * task is never called after this method returned. Other tasks are not
+	 * run by the calling thread meanwhile. When called from the task itself,
+	 * only further runs are prevented.
+	 * \param id The id of the timer to cancel
+	 * \return If the timer was still active
+	 */
+	bool cancel(TimerId id);
+
 	bool empty() const;
 	size_t getQueuedTasks() const;
 	size_t getNumWorkerThreads() const;
+	size_t getNumRealtimeWorkerThreads() const;
+
+	/*!
+	 * Get the number of tasks of a priority waiting for a worker
+	 * \param priority The priority of the tasks
+	 * \return The number of queued tasks
+	 */
+	size_t getQueuedTasks(TaskPriority priority) const;
+
+	/*!
+	 * Get the number of tasks of a priority which were started so far
+	 * \param priority The priority of the tasks
+	 * \return The number of started tasks
+	 */
+	size_t getStartedTasks(TaskPriority priority) const;
+
+	/*!
+	 * Get the summed time tasks of a priority waited until they were started
+	 * \param priority The priority of the tasks
+	 * \return The total waiting time
+	 */
+	std::chrono::nanoseconds getWaitTime(TaskPriority priority) const;
+
+	/*!
+	 * Get the longest time a task of a priority waited until it was started
+	 * \param priority The priority of the tasks
+	 * \return The maximum waiting time
+	 */
+	std::chrono::nanoseconds getMaxWaitTime(TaskPriority priority) const;
 
 private:
-	void run();
+	friend class TaskGroup;
+
+	static const size_t kNumPriorities = 3;
+
+	struct Task {
+		Runnable runnable;
+		std::chrono::steady_clock::time_point added;
+	};
+
+	struct Worker {
+		std::mutex access;
+		std::deque<Task> tasks[kNumPriorities];
+		std::thread thread;
+		bool realtime{false};
+	};
+
+	struct Lane {
+		std::atomic_size_t queued{0};
+		std::atomic_size_t started{0};
+		std::atomic_uint64_t waitTime{0};
+		std::atomic_uint64_t maxWaitTime{0};
+	};
+
+	struct Timer {
+		TimerId id;
+		TaskPriority priority;
+		std::chrono::steady_clock::duration interval;
+		Runnable runnable;
+		bool cancelled{false};
+		bool active{false};
+	};
+
+	typedef std::pair<std::chrono::steady_clock::time_point, std::shared_ptr<Timer>> TimerEntry;
+
+	void run(size_t index);
+	void runTimers();
+	void runTimer(const std::shared_ptr<Timer> &timer);
+
+	/*!
+	 * Mark the run of a timer as finished and queue its next run, if it is periodic and not cancelled
+	 * \param timer The timer whose run finished
+	 */
+	void finishTimer(const std::shared_ptr<Timer> &timer);
+	TimerId addTimer(
+		std::chrono::steady_clock::duration delay,
+		std::chrono::steady_clock::duration interval,
+		Runnable runnable,
+		TaskPriority priority
+	);
+
+	/*!
+	 * Take a task from the deque of the given worker or steal one from the
+	 * other workers, trying the higher priorities first
+	 * \param index The index of the worker or the number of workers for threads outside of the pool
+	 * \param task The task which was taken
+	 * \param priority The priority of the task which was taken
+	 * \return If a task was found
+	 */
+	bool takeTask(size_t index, Runnable &task, TaskPriority &priority);
+
+	/*!
+	 * Run a task taken from the deques and update the counters
+	 * \param task The task to run
+	 * \param priority The priority of the task
+	 */
+	void runTask(Runnable &task, TaskPriority priority);
+
+	/*!
+	 * Run a single queued task on the calling thread, if there is any
+	 * \return If a task was run
+	 */
+	bool runPendingTask();
+
+	/*!
+	 * Get the index of the worker of this pool running on the calling thread
+	 * \return The index of the worker or the number of workers for threads outside of the pool
+	 */
+	size_t getCurrentWorker() const;
 
 	std::atomic_bool _finished;
-	std::atomic_uint _running;
-	std::condition_variable _taskCond;
-	mutable std::mutex _taskAccess;
-	std::queue<Runnable> _tasks;
-	std::vector<std::thread> _threads;
+	std::atomic_size_t _running;
+	std::atomic_size_t _queued;
+	std::atomic_size_t _sleeping;
+	std::atomic_size_t _sleepingRealtime;
+	std::atomic_size_t _nextWorker;
+	std::mutex _sleepAccess;
+	std::condition_variable _sleepCond;
+	std::condition_variable _realtimeCond;
+	std::vector<std::unique_ptr<Worker>> _workers;
+	size_t _numWorkers;
+	Lane _lanes[kNumPriorities];
+
+	TimerId _nextTimerId;
+	std::mutex _timerAccess;
+	std::condition_variable _timerCond;
+	std::condition_variable _timerDone;
+	std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<>> _timerQueue;
+	std::unordered_map<TimerId, std::shared_ptr<Timer>> _timers;
+	std::thread _timerThread;
+};
+
+/*!
+ * \brief Group of tasks which can be waited on together
+ *
+ * Tasks are run on a thread pool. Waiting for the group from inside of a
+ * worker thread runs queued tasks of the pool on the waiting worker, so it
+ * doesn't block the pool. Other threads block until the group is finished.
+ */
+class TaskGroup : Common::Noncopyable {
+public:
+	explicit TaskGroup(ThreadPool &pool = ThreadPool::instance());
+
+	/*!
+	 * Wait for all remaining tasks. Exceptions of the tasks are discarded.
+	 */
+	~TaskGroup();
+
+	/*!
+	 * Add a task to the group
+	 * \param runnable The task to run
+	 */
+	void run(Runnable runnable);
+
+	/*!
+	 * Wait until all tasks of the group are finished. If any task threw an
+	 * exception, the first one is rethrown.
+	 */
+	void wait();
+
+private:
+	ThreadPool &_pool;
+	std::atomic_size_t _pending;
+	std::mutex _access;
+	std::condition_variable _done;
+	std::exception_ptr _error;
 };
 
 }
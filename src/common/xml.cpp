@@ -18,7 +18,6 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <regex>
 #include <iostream>
 #include <sstream>
 
@@ -92,7 +91,7 @@ glm::vec3 XML::Node::getVec3(const std::string &attribute) const {
 	if (iter == properties.end())
 		throw CreateException("Property {} not found in tag", attribute);
 
-	const auto valueStrings = Common::split(iter->second, std::regex(" "));
+	const auto valueStrings = Common::split(iter->second, ' ');
 
 	if (valueStrings.size() != 3)
 		throw CreateException("Incorrect number of values detected, expected 3, got {}", valueStrings.size());
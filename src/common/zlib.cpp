@@ -20,6 +20,7 @@
 
 #include <array>
 #include <memory>
+#include <algorithm>
 
 #include <zlib.h>
 
@@ -31,30 +32,14 @@
 namespace Common {
 
 ReadStream *decompressZLIB(const byte *data, size_t compressedSize, size_t decompressedSize) {
-	byte *uncompressedData = new byte[decompressedSize];
-
-	z_stream stream;
-
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-
-	stream.avail_in = compressedSize;
-	stream.next_in = const_cast<byte *>(data);
-	stream.avail_out = decompressedSize;
-	stream.next_out = uncompressedData;
-
-	int result = inflateInit(&stream);
-	if (result != Z_OK)
-		throw CreateException("Error initializing z_stream: {}", zError(result));
-
-	result = inflate(&stream, Z_FINISH);
-	if (result != Z_STREAM_END)
-		throw CreateException("Error inflating: {}", zError(result));
-
-	inflateEnd(&stream);
+	std::unique_ptr<byte[]> decompressedData(new byte[decompressedSize]);
+	decompressZLIB({data, compressedSize}, {decompressedData.get(), decompressedSize});
+	return new MemoryReadStream(decompressedData.release(), decompressedSize);
+}
 
-	return new MemoryReadStream(uncompressedData, decompressedSize);
+size_t decompressZLIB(std::span<const byte> input, std::span<byte> output) {
+	thread_local ZLIBInflater inflater;
+	return inflater.inflate(input, output);
 }
 
 ReadStream *compressZLIB(byte *data, size_t decompressedSize) {
@@ -99,4 +84,109 @@ ReadStream *compressZLIB(byte *data, size_t decompressedSize) {
 	return new MemoryReadStream(writer.getData(), writer.getLength());
 }
 
+size_t getZLIBCompressBound(size_t decompressedSize) {
+	return compressBound(decompressedSize);
+}
+
+size_t compressZLIB(std::span<const byte> input, std::span<byte> output) {
+	z_stream stream;
+
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+
+	int zResult = deflateInit2(
+			&stream,
+			Z_BEST_COMPRESSION,
+			Z_DEFLATED,
+			15,
+			9,
+			Z_DEFAULT_STRATEGY
+	);
+
+	if (zResult != Z_OK)
+		throw CreateException("Error when initializing zlib deflate: {}", zError(zResult));
+
+	stream.avail_in = input.size();
+	stream.next_in = const_cast<byte *>(input.data());
+	stream.avail_out = output.size();
+	stream.next_out = output.data();
+
+	zResult = deflate(&stream, Z_FINISH);
+	const size_t compressedSize = stream.total_out;
+	deflateEnd(&stream);
+
+	if (zResult != Z_STREAM_END)
+		throw CreateException("Compressed data exceeds the output buffer of {} bytes", output.size());
+
+	return compressedSize;
+}
+
+ZLIBInflater::ZLIBInflater() :
+	_stream(std::make_unique<z_stream>()), _decompressedSize(0), _initialized(false), _finished(true) {
+	_stream->zalloc = Z_NULL;
+	_stream->zfree = Z_NULL;
+	_stream->opaque = Z_NULL;
+}
+
+ZLIBInflater::ZLIBInflater(const byte *data, size_t compressedSize, byte *output, size_t decompressedSize) :
+	ZLIBInflater() {
+	reset({data, compressedSize}, {output, decompressedSize});
+}
+
+ZLIBInflater::~ZLIBInflater() {
+	if (_initialized)
+		inflateEnd(_stream.get());
+}
+
+void ZLIBInflater::reset(std::span<const byte> input, std::span<byte> output) {
+	_stream->avail_in = input.size();
+	_stream->next_in = const_cast<byte *>(input.data());
+	_stream->avail_out = 0;
+	_stream->next_out = output.data();
+
+	const int result = _initialized ? inflateReset(_stream.get()) : inflateInit(_stream.get());
+	if (result != Z_OK)
+		throw CreateException("Error initializing z_stream: {}", zError(result));
+
+	_initialized = true;
+	_decompressedSize = output.size();
+	_finished = false;
+}
+
+size_t ZLIBInflater::inflate(std::span<const byte> input, std::span<byte> output) {
+	reset(input, output);
+
+	_stream->avail_out = output.size();
+	const int result = ::inflate(_stream.get(), Z_FINISH);
+	_finished = true;
+	if (result != Z_STREAM_END)
+		throw CreateException("Error inflating: {}", zError(result));
+
+	return getInflatedSize();
+}
+
+size_t ZLIBInflater::inflateUntil(size_t length) {
+	length = std::min(length, _decompressedSize);
+
+	while (!_finished && getInflatedSize() < length) {
+		_stream->avail_out = length - getInflatedSize();
+
+		const int result = ::inflate(_stream.get(), Z_SYNC_FLUSH);
+		if (result == Z_STREAM_END)
+			_finished = true;
+		else if (result != Z_OK)
+			throw CreateException("Error inflating: {}", zError(result));
+	}
+
+	if (getInflatedSize() < length)
+		throw CreateException("Unexpected end of zlib stream after {} of {} bytes", getInflatedSize(), length);
+
+	return getInflatedSize();
+}
+
+size_t ZLIBInflater::getInflatedSize() const {
+	return _stream->total_out;
+}
+
 } // End of namespace Common
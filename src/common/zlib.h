@@ -21,13 +21,106 @@
 #ifndef SRC_COMMON_ZLIB_H
 #define SRC_COMMON_ZLIB_H
 
+#include <memory>
+#include <span>
+
 #include "src/common/readstream.h"
 
+struct z_stream_s;
+
 namespace Common {
 
 ReadStream *decompressZLIB(const byte *data, size_t compressedSize, size_t decompressedSize);
 ReadStream *compressZLIB(byte *data, size_t decompressedSize);
 
+/*!
+ * Decompress a complete zlib stream into a buffer owned by the caller. The
+ * inflate state is reused between calls on the same thread.
+ * \param input The compressed zlib stream
+ * \param output The buffer receiving the decompressed data
+ * \return The number of bytes decompressed
+ */
+size_t decompressZLIB(std::span<const byte> input, std::span<byte> output);
+
+/*!
+ * Get the maximum size of zlib compressed data for data of a given size
+ * \param decompressedSize The size of the data to compress
+ * \return The size an output buffer for compressZLIB should have
+ */
+size_t getZLIBCompressBound(size_t decompressedSize);
+
+/*!
+ * Compress data as zlib stream into a buffer owned by the caller
+ * \param input The data to compress
+ * \param output The buffer receiving the compressed data, see getZLIBCompressBound
+ * \return The size of the compressed data
+ */
+size_t compressZLIB(std::span<const byte> input, std::span<byte> output);
+
+/*!
+ * \brief Incremental zlib decompression into a fixed output buffer
+ *
+ * This class inflates a zlib stream piece by piece into an output buffer,
+ * so that only as much data is decompressed as is actually needed. Neither
+ * the compressed data nor the output buffer are owned by the inflater and
+ * both have to stay valid as long as it is used. An inflater can be reset
+ * to new data, which reuses its internal state instead of allocating it
+ * again for every stream.
+ */
+class ZLIBInflater : Noncopyable {
+public:
+	/*!
+	 * Create a new inflater without data, which has to be given by reset
+	 * before inflating
+	 */
+	ZLIBInflater();
+
+	/*!
+	 * Create a new inflater for the given compressed data
+	 * \param data The compressed zlib stream
+	 * \param compressedSize The size of the compressed data
+	 * \param output The buffer receiving the decompressed data
+	 * \param decompressedSize The size of the decompressed data
+	 */
+	ZLIBInflater(const byte *data, size_t compressedSize, byte *output, size_t decompressedSize);
+	~ZLIBInflater();
+
+	/*!
+	 * Start inflating new data, reusing the state of the inflater
+	 * \param input The compressed zlib stream
+	 * \param output The buffer receiving the decompressed data
+	 */
+	void reset(std::span<const byte> input, std::span<byte> output);
+
+	/*!
+	 * Inflate a complete zlib stream at once
+	 * \param input The compressed zlib stream
+	 * \param output The buffer receiving the decompressed data
+	 * \return The number of bytes decompressed
+	 */
+	size_t inflate(std::span<const byte> input, std::span<byte> output);
+
+	/*!
+	 * Inflate the data until at least the given number of bytes are
+	 * decompressed or the end of the output is reached.
+	 * \param length The number of bytes which should be available
+	 * \return The number of bytes decompressed so far
+	 */
+	size_t inflateUntil(size_t length);
+
+	/*!
+	 * Get the number of bytes decompressed so far
+	 * \return The number of bytes decompressed
+	 */
+	size_t getInflatedSize() const;
+
+private:
+	std::unique_ptr<z_stream_s> _stream;
+	size_t _decompressedSize;
+	bool _initialized;
+	bool _finished;
+};
+
 } // End of namespace Common
 
 #endif // SRC_COMMON_ZLIB_H
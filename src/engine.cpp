@@ -93,8 +93,8 @@ Configuration &Engine::getConfiguration() {
 void Engine::loadEpisode(const std::string &data) {
 	_doneLoading = false;
 	Threads.add([this, data](){
-		std::vector<std::string> parameters = Common::split(data, std::regex(" "));
-		std::vector<std::string> episode = Common::split(parameters.back(), std::regex(":"));
+		std::vector<std::string> parameters = Common::split(data, ' ');
+		std::vector<std::string> episode = Common::split(parameters.back(), ':');
 
 		std::string worldName = episode[0];
 		std::string episodeName = episode[1];
@@ -108,7 +108,7 @@ void Engine::loadEpisode(const std::string &data) {
 
 		_doneLoading = true;
 		_started = false;
-	});
+	}, Common::TaskPriority::kBackground);
 }
 
 void Engine::clearWorld() {
@@ -53,13 +53,13 @@ unsigned int Engine::getStoryModeRound() const {
 }
 
 void Engine::loadEpisode(const std::string &data) {
-	const std::vector<std::string> parameters = Common::split(data, std::regex(" "));
-	const std::vector<std::string> episode = Common::split(parameters.back(), std::regex(":"));
+	const std::vector<std::string> parameters = Common::split(data, ' ');
+	const std::vector<std::string> episode = Common::split(parameters.back(), ':');
 
 	::Engine::loadEpisode(parameters.back());
 
 	// Parse story mode round
-	const std::vector<std::string> split = Common::split(parameters.front(), std::regex(":"));
+	const std::vector<std::string> split = Common::split(parameters.front(), ':');
 	if (split[0] == "round") {
 		_storyModeRound = std::stoul(split[1]);
 	} else {
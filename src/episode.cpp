@@ -33,105 +33,110 @@ Episode::Episode(entt::registry &registry, entt::scheduler<double> &scheduler, c
 	_world(world) {
 	std::string episodeFolder = std::format("worlds/{}/episodes/{}", world, id);
 
-	loadGIDRegistry(ResMan.getResource(std::format("{}/GIDRegistry.txt", episodeFolder)));
+	auto gidRegistryRequest = ResMan.getResourceAsync(std::format("{}/GIDRegistry.txt", episodeFolder), 1);
+	auto episodeRequest = ResMan.getBINArchiveAsync(std::format("{}/episode.bin", episodeFolder), 1);
 
-	std::unique_ptr<Common::ReadStream> episodeStream(ResMan.getResource(std::format("{}/episode.bin", episodeFolder)));
-	AWE::BINArchive episode(*episodeStream);
-	std::shared_ptr<DPFile> dp = std::make_shared<DPFile>(episode.getResource("dp_episode.bin"));
-
-	spdlog::info("Loading task definitions for {}", id);
-	load(episode.getResource("cid_taskdefinition.bin"), kTaskDefinition, dp);
-
-	const auto archives = ResMan.getDirectoryResources(episodeFolder);
-
-	for (const auto &archive: archives) {
+	// Request all task archives up front, so that they are loaded while the previous ones are processed
+	std::vector<std::pair<std::string, std::future<std::shared_ptr<AWE::BINArchive>>>> taskRequests;
+	for (const auto &archive: ResMan.getDirectoryResources(episodeFolder)) {
 		if (
 			!std::regex_match(archive, std::regex(".*\\.bin$")) ||
 			std::regex_match(archive, std::regex(".*episode\\.bin$"))
 		)
 			continue;
 
+		taskRequests.emplace_back(archive, ResMan.getBINArchiveAsync(archive));
+	}
+
+	loadGIDRegistry(gidRegistryRequest.get().release());
+
+	const std::shared_ptr<AWE::BINArchive> episode = episodeRequest.get();
+	std::shared_ptr<DPFile> dp = std::make_shared<DPFile>(episode->getResource("dp_episode.bin"));
+
+	spdlog::info("Loading task definitions for {}", id);
+	load(episode->getResource("cid_taskdefinition.bin"), kTaskDefinition, dp);
+
+	for (auto &[archive, request] : taskRequests) {
 		spdlog::info("Loading {}", archive);
 
-		std::unique_ptr<Common::ReadStream> tasksStream(ResMan.getResource(archive));
-		AWE::BINArchive tasks(*tasksStream);
+		const std::shared_ptr<AWE::BINArchive> tasks = request.get();
 
-		if (tasks.hasResource("dp_bytecode.bin") && tasks.hasResource("dp_bytecodeparameters.bin"))
+		if (tasks->hasResource("dp_bytecode.bin") && tasks->hasResource("dp_bytecodeparameters.bin"))
 			loadBytecode(
-				tasks.getResource("dp_bytecode.bin"),
-				tasks.getResource("dp_bytecodeparameters.bin")
+				tasks->getResource("dp_bytecode.bin"),
+				tasks->getResource("dp_bytecodeparameters.bin")
 			);
 
 		// Search for a dp file
-		for (const auto &item: tasks.getDirectoryResources("")) {
-			const auto filename = tasks.getResourcePath(item);
+		for (const auto &item: tasks->getDirectoryResources("")) {
+			const auto filename = tasks->getResourcePath(item);
 			if (std::regex_match(filename, std::regex("dp_[a-z]*\\.bin")) && !std::regex_match(filename, std::regex(".*bytecode(parameters)?.*")))
-				dp = std::make_shared<DPFile>(tasks.getResource(filename));
+				dp = std::make_shared<DPFile>(tasks->getResource(filename));
 		}
 
 		spdlog::info("Loading attachment containers for {}", id);
-		load(tasks.getResource("cid_attachmentcontainer.bin"), kAttachmentContainer, dp);
+		load(tasks->getResource("cid_attachmentcontainer.bin"), kAttachmentContainer, dp);
 
 		// ,--- Load Possible attachment container entities
 		spdlog::info("Loading script instances for {}", id);
-		load(tasks.getResource("cid_scriptinstance.bin"), kScriptInstance, dp);
-		load(tasks.getResource("cid_scriptinstancescript.bin"), kScript, dp);
+		load(tasks->getResource("cid_scriptinstance.bin"), kScriptInstance, dp);
+		load(tasks->getResource("cid_scriptinstancescript.bin"), kScript, dp);
 
 		spdlog::info("Loading Point Lights for {}", id);
-		load(tasks.getResource("cid_pointlight.bin"), kPointLight, dp);
+		load(tasks->getResource("cid_pointlight.bin"), kPointLight, dp);
 
 		spdlog::info("Loading ambient lights for {}", id);
-		load(tasks.getResource("cid_ambientlight.bin"), kAmbientLight, dp);
-		load(tasks.getResource("cid_ambientlightscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_ambientlight.bin"), kAmbientLight, dp);
+		load(tasks->getResource("cid_ambientlightscript.bin"), kScript, dp);
 
 		spdlog::info("Loading Triggers for {}", id);
-		load(tasks.getResource("cid_trigger.bin"), kTrigger, dp);
-		load(tasks.getResource("cid_triggerscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_trigger.bin"), kTrigger, dp);
+		load(tasks->getResource("cid_triggerscript.bin"), kScript, dp);
 		// '---
 
 		spdlog::info("Loading static objects for {}", id);
-		load(tasks.getResource("cid_staticobject.bin"), kStaticObject, dp);
+		load(tasks->getResource("cid_staticobject.bin"), kStaticObject, dp);
 
 		spdlog::info("Loading dynamic objects for {}", id);
-		load(tasks.getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
-		load(tasks.getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
+		load(tasks->getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
+		load(tasks->getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
 
 		spdlog::info("Loading characters for {}", id);
-		load(tasks.getResource("cid_character.bin"), kCharacter, dp);
-		load(tasks.getResource("cid_characterscript.bin"), kCharacterScript, dp);
+		load(tasks->getResource("cid_character.bin"), kCharacter, dp);
+		load(tasks->getResource("cid_characterscript.bin"), kCharacterScript, dp);
 
 		spdlog::info("Loading Spot Lights for {}", id);
-		load(tasks.getResource("cid_spotlight.bin"), kSpotLight, dp);
+		load(tasks->getResource("cid_spotlight.bin"), kSpotLight, dp);
 
 		spdlog::info("Loading Floating Scripts for {}", id);
-		load(tasks.getResource("cid_floatingscript.bin"), kFloatingScript, dp);
+		load(tasks->getResource("cid_floatingscript.bin"), kFloatingScript, dp);
 
 		spdlog::info("Loading area triggers for {}", id);
-		load(tasks.getResource("cid_areatrigger.bin"), kAreaTrigger, dp);
-		load(tasks.getResource("cid_areatriggerscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_areatrigger.bin"), kAreaTrigger, dp);
+		load(tasks->getResource("cid_areatriggerscript.bin"), kScript, dp);
 
-		load(tasks.getResource("cid_taskcontent.bin"), kTaskContent, dp);
+		load(tasks->getResource("cid_taskcontent.bin"), kTaskContent, dp);
 
 		spdlog::info("Loading task scripts for {}", id);
-		load(tasks.getResource("cid_taskscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_taskscript.bin"), kScript, dp);
 
 		spdlog::info("Loading waypoints for {}", id);
-		load(tasks.getResource("cid_waypoint.bin"), kWaypoint, dp);
-		load(tasks.getResource("cid_waypointscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_waypoint.bin"), kWaypoint, dp);
+		load(tasks->getResource("cid_waypointscript.bin"), kScript, dp);
 
 		spdlog::info("Loading key frames for {}", id);
-		load(tasks.getResource("cid_keyframe.bin"), kKeyframe, dp);
+		load(tasks->getResource("cid_keyframe.bin"), kKeyframe, dp);
 
 		spdlog::info("Loading key frame animations for {}", id);
-		load(tasks.getResource("cid_keyframeanimation.bin"), kKeyframeAnimation, dp);
+		load(tasks->getResource("cid_keyframeanimation.bin"), kKeyframeAnimation, dp);
 
 		spdlog::info("Loading key framers for {}", id);
-		load(tasks.getResource("cid_keyframer.bin"), kKeyframer, dp);
-		load(tasks.getResource("cid_keyframerscript.bin"), kScript, dp);
+		load(tasks->getResource("cid_keyframer.bin"), kKeyframer, dp);
+		load(tasks->getResource("cid_keyframerscript.bin"), kScript, dp);
 
 		spdlog::info("Loading key framed objects for {}", id);
-		load(tasks.getResource("cid_keyframedobject.bin"), kKeyframedObject, dp);
-		load(tasks.getResource("cid_keyframedobjectscript.bin"), kDynamicObjectScript, dp);
+		load(tasks->getResource("cid_keyframedobject.bin"), kKeyframedObject, dp);
+		load(tasks->getResource("cid_keyframedobjectscript.bin"), kDynamicObjectScript, dp);
 	}
 }
 
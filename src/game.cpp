@@ -18,6 +18,7 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 
@@ -29,6 +30,7 @@
 #include "src/common/exception.h"
 #include "src/common/platform.h"
 #include "src/common/cpuinfo.h"
+#include "src/common/profiler.h"
 
 #include "src/awe/resman.h"
 #include "src/awe/cidfile.h"
@@ -99,6 +101,21 @@ bool Game::parseArguments(int argc, char **argv) {
 		"Additional data paths for adding and overriding resources")
 		->check(CLI::ExistingDirectory);
 
+	app.add_flag("--verify-archives", _verifyArchives, "Verify the checksums of all resources read from archives");
+	app.add_option("--resource-cache", _resourceCacheSize,
+		"The size of the cache for decoded resources in MiB, 0 disables the cache")
+		->default_val(0);
+	app.add_option("--resource-trace", _resourceTracePath,
+		"Directory of resource access traces, which are used for reading resources ahead while loading")
+		->check(CLI::ExistingDirectory);
+	app.add_flag("--record-resource-trace", _recordResourceTrace,
+		"Record the resources accessed while loading into the trace directory instead of replaying them");
+
+#if defined(WITH_TRACE_EVENTS)
+	app.add_option("--profile", _profilerTracePath,
+		"Record a profile of the engine as chrome trace events into the given json file");
+#endif
+
 	_physicsDebugDraw = false;
 	app.add_flag("--debug-physics", _physicsDebugDraw, "Draw physics bodies for debugging");
 	app.add_flag("--force-x11", _forceX11, "Force the window to use X11 rather than wayland (Only usable on linux systems)");
@@ -111,6 +128,11 @@ bool Game::parseArguments(int argc, char **argv) {
 }
 
 void Game::init() {
+	PROFILE_THREAD_NAME("Main Thread");
+
+	if (!_profilerTracePath.empty())
+		Common::TraceProfiler::instance().start(_profilerTracePath);
+
 	spdlog::debug("OS: {}", Common::getOSName());
 	spdlog::debug("CPU Vendor: {}", Common::getCPUVendor());
 	spdlog::debug("CPU Name: {}",   Common::getCPUName());
@@ -131,6 +153,14 @@ void Game::init() {
 	std::vector<std::string> identifiers;
 
 	ResMan.setRootPath(_path);
+	ResMan.setCacheBudget(_resourceCacheSize * 1024 * 1024);
+	ResMan.setVerifyArchives(_verifyArchives);
+
+	if (!_resourceTracePath.empty())
+		ResMan.setTraceMode(
+			_recordResourceTrace ? AWE::RessourceManager::kTraceRecord : AWE::RessourceManager::kTraceReplay,
+			_resourceTracePath
+		);
 
 	// Add additional data paths
 	for (const auto &path: _additionalPaths) {
@@ -138,7 +168,20 @@ void Game::init() {
 		ResMan.addPath(path);
 	}
 
+	// Index repacked archives first, so that they take precedence over the original archives
+	std::vector<std::string> packIdentifiers;
+	for (const auto &path : std::filesystem::directory_iterator(_path)) {
+		if (!path.is_regular_file() || path.path().extension() != ".awepack")
+			continue;
+
+		packIdentifiers.emplace_back(path.path().filename().stem().string());
+
+		spdlog::info("Indexing pack {}", path.path().filename().string());
+		ResMan.indexArchive(path.path().string());
+	}
+
 	// Index rmdp archives
+	std::vector<std::pair<std::string, std::string>> archiveFiles;
 	for (const auto &path : std::filesystem::directory_iterator(_path)) {
 		if (!path.is_regular_file())
 			continue;
@@ -152,12 +195,19 @@ void Game::init() {
 		identifiers.emplace_back(path.path().filename().stem().string());
 
 		spdlog::info("Indexing archive {}", path.path().filename().string());
-		//Threads.add([=](){ResMan.indexArchive(binFile, rmdpFile);});
-		ResMan.indexArchive(binFile, rmdpFile);
+		archiveFiles.emplace_back(binFile, rmdpFile);
+	}
+
+	// The archives are loaded in parallel, but merged in the order they were found
+	ResMan.indexArchives(archiveFiles);
+
+	for (const auto &identifier : packIdentifiers) {
+		if (std::find(identifiers.begin(), identifiers.end(), identifier) == identifiers.end())
+			identifiers.emplace_back(identifier);
 	}
 
 	if (identifiers.empty())
-		throw CreateException("No .rmdp files found in the set data path.");
+		throw CreateException("No .rmdp or .awepack files found in the set data path.");
 
 	GameEngine engine;
 
@@ -186,31 +236,28 @@ void Game::init() {
 
 	// Check if the resources have packmeta files and load them and if not load streamed resources
 	if (engine == kAlanWakesAmericanNightmare) {
+		std::vector<std::string> packmetaFiles;
 		for (const auto &identifier : identifiers) {
 			spdlog::info("Indexing packmeta file {}", identifier + ".packmeta");
-			ResMan.indexPackmeta(identifier + ".packmeta");
+			packmetaFiles.emplace_back(identifier + ".packmeta");
 		}
+		ResMan.indexPackmetas(packmetaFiles);
 	} else if (engine == kAlanWake) {
-		spdlog::info("Indexing streamed resource file cid_streamedcloth.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedcloth.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedcollisionpackage.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedcollisionpackage.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedfacefxactor.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedfacefxactor.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedfacefxanimset.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedfacefxanimset.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedfoliagemesh.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedfoliagemesh.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedhavokanimation.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedhavokanimation.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedmesh.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedmesh.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedparticlesystem.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedparticlesystem.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedsound.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedsound.bin");
-		spdlog::info("Indexing streamed resource file cid_streamedtexture.bin");
-		ResMan.indexStreamedResource("resourcedb/cid_streamedtexture.bin");
+		const std::vector<std::string> resourcedbFiles = {
+			"resourcedb/cid_streamedcloth.bin",
+			"resourcedb/cid_streamedcollisionpackage.bin",
+			"resourcedb/cid_streamedfacefxactor.bin",
+			"resourcedb/cid_streamedfacefxanimset.bin",
+			"resourcedb/cid_streamedfoliagemesh.bin",
+			"resourcedb/cid_streamedhavokanimation.bin",
+			"resourcedb/cid_streamedmesh.bin",
+			"resourcedb/cid_streamedparticlesystem.bin",
+			"resourcedb/cid_streamedsound.bin",
+			"resourcedb/cid_streamedtexture.bin",
+		};
+		for (const auto &resourcedbFile : resourcedbFiles)
+			spdlog::info("Indexing streamed resource file {}", std::filesystem::path(resourcedbFile).filename().string());
+		ResMan.indexStreamedResources(resourcedbFiles);
 	}
 
 	_platform.forceX11(_forceX11);
@@ -268,6 +315,8 @@ void Game::init() {
 	_window->setTitle(_engine->getName());
 
 	Threads.add([this](){
+		PROFILE_ZONE("Load Level");
+
 		const auto start = std::chrono::steady_clock::now();
 		_global = std::make_unique<Global>(_registry, _engine->getScheduler());
 
@@ -275,7 +324,7 @@ void Game::init() {
 
 		const auto finished = std::chrono::steady_clock::now();
 		spdlog::info("Loading level took {} seconds", std::chrono::duration_cast<std::chrono::milliseconds>(finished - start).count());
-	});
+	}, Common::TaskPriority::kBackground);
 }
 
 void Game::start() {
@@ -351,10 +400,15 @@ void Game::start() {
 	bool exit = false;
 	std::chrono::system_clock::time_point last, now;
 	while (!exit) {
+		PROFILE_ZONE("Game Loop");
+
 		double time = _platform.getTime();
 
-		_engine->update(time);
-		_engine->getScheduler().update(time);
+		{
+			PROFILE_ZONE("Update Engine");
+			_engine->update(time);
+			_engine->getScheduler().update(time);
+		}
 
 		/*
 		 * Update child transforms if a parent transform is changed
@@ -407,6 +461,9 @@ void Game::start() {
 			exit = true;
 
 		lastTime = time;
+
+		PROFILE_COUNTER("Queued Tasks", Threads.getQueuedTasks());
+		PROFILE_FRAME();
 	}
 
 	transformRelationshipObserver.disconnect();
@@ -427,4 +484,6 @@ void Game::start() {
 
 	_window.reset();
 	_platform.terminate();
+
+	Common::TraceProfiler::instance().stop();
 }
@@ -49,7 +49,10 @@ public:
 private:
 	bool _physicsDebugDraw{};
 	bool _forceX11{};
-	std::string _path, _shaderPath;
+	bool _recordResourceTrace{};
+	bool _verifyArchives{};
+	size_t _resourceCacheSize{};
+	std::string _path, _shaderPath, _resourceTracePath, _profilerTracePath;
 	std::vector<std::string> _additionalPaths;
 	Common::Language _language;
 
@@ -86,7 +86,7 @@ AmbianceState::AmbianceState(Common::ReadStream &ambianceState) {
 }
 
 glm::vec3 AmbianceState::parseVec3(const std::string &str) {
-	const auto values = Common::split(str, std::regex(" "));
+	const auto values = Common::split(str, ' ');
 	return glm::vec3(
 			Common::parse<float>(values[0]),
 			Common::parse<float>(values[1]),
@@ -51,7 +51,7 @@ void AnimationTree::load(Common::ReadStream &tree) {
 	std::map<std::string, boost::dynamic_bitset<uint8_t>> flags;
 	for (const Common::XML::Node &animationFlags : root.getNodes("Object_AnimationFlags")) {
 		const auto flagsName = animationFlags.getNode("Name").content;
-		const auto flagsData = Common::split(animationFlags.getNode("Flags").content, std::regex(","));
+		const auto flagsData = Common::split(animationFlags.getNode("Flags").content, ',');
 		const auto noFlagNames = _flagNames.empty();
 
 		assert(flagsData.size() % 2 == 0);
@@ -74,7 +74,7 @@ void AnimationTree::load(Common::ReadStream &tree) {
 	std::map<std::string, std::vector<float>> weightSets;
 	for (const Common::XML::Node &blendWeights: root.getNodes("Object_AnimationBlendWeights")) {
 		const auto weightsName = blendWeights.getNode("Name").content;
-		const auto weights = Common::split(blendWeights.getNode("Weights").content, std::regex(","));
+		const auto weights = Common::split(blendWeights.getNode("Weights").content, ',');
 
 		assert(weights.size() % 2 == 0);
 
@@ -19,13 +19,13 @@
  */
 
 #include <stdexcept>
-#include <regex>
 #include <filesystem>
 
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
 #include "src/common/exception.h"
+#include "src/common/profiler.h"
 
 #include "src/awe/resman.h"
 
@@ -45,10 +45,26 @@ MeshManager::MeshManager() {
 		throw std::runtime_error("No broken mesh mesh found!");
 }
 
+void MeshManager::requestMesh(rid_t rid, int priority) {
+	if (_meshRegistry.contains(rid) || _requests.contains(rid))
+		return;
+
+	_requests.emplace(rid, ResMan.getResourceAsync(rid, priority));
+}
+
+void MeshManager::requestMesh(const std::string &path, int priority) {
+	if (_meshRegistry.contains(path) || _requests.contains(path))
+		return;
+
+	_requests.emplace(path, ResMan.getResourceAsync(path, priority));
+}
+
 MeshPtr MeshManager::getMesh(rid_t rid) {
 	auto iter = _meshRegistry.find(rid);
 	if (iter == _meshRegistry.end()) {
-		std::unique_ptr<Common::ReadStream> meshResource(ResMan.getResource(rid));
+		PROFILE_ZONE("Load Mesh");
+
+		std::unique_ptr<Common::ReadStream> meshResource = getMeshResource(rid);
 		if (!meshResource) {
 			spdlog::error("Mesh {} is missing. Falling back to MissingMesh mesh.", rid);
 			return getMissingMesh();
@@ -69,7 +85,9 @@ MeshPtr MeshManager::getMesh(rid_t rid) {
 MeshPtr MeshManager::getMesh(const std::string &path) {
 	auto iter = _meshRegistry.find(path);
 	if (iter == _meshRegistry.end()) {
-		std::unique_ptr<Common::ReadStream> meshResource(ResMan.getResource(path));
+		PROFILE_ZONE("Load Mesh");
+
+		std::unique_ptr<Common::ReadStream> meshResource = getMeshResource(path);
 		if (!meshResource) {
 			spdlog::error("Mesh {} is missing. Falling back to MissingMesh mesh.", path);
 			return getMissingMesh();
@@ -92,7 +110,9 @@ MeshPtr MeshManager::getMesh(const std::string &path) {
 MeshPtr MeshManager::getMesh(const std::string &path, std::initializer_list<std::string> stages) {
 	auto iter = _meshRegistry.find(path);
 	if (iter == _meshRegistry.end()) {
-		std::unique_ptr<Common::ReadStream> meshResource(ResMan.getResource(path));
+		PROFILE_ZONE("Load Mesh");
+
+		std::unique_ptr<Common::ReadStream> meshResource = getMeshResource(path);
 		if (!meshResource) {
 			spdlog::error("Mesh {} is missing. Falling back to MissingMesh mesh.", path);
 			return getMissingMesh();
@@ -114,6 +134,7 @@ MeshPtr MeshManager::getMesh(const std::string &path, std::initializer_list<std:
 
 void MeshManager::clear() {
 	_meshRegistry.clear();
+	_requests.clear();
 }
 
 MeshPtr MeshManager::getMissingMesh() {
@@ -124,6 +145,19 @@ MeshPtr MeshManager::getBrokenMesh() {
 	return getMesh(_brokenMeshPath);
 }
 
+std::unique_ptr<Common::ReadStream> MeshManager::getMeshResource(const MeshKey &key) {
+	auto request = _requests.find(key);
+	if (request == _requests.end())
+		return std::visit(
+			[](const auto &resource) { return std::unique_ptr<Common::ReadStream>(ResMan.getResource(resource)); },
+			key
+		);
+
+	std::unique_ptr<Common::ReadStream> resource = request->second.get();
+	_requests.erase(request);
+	return resource;
+}
+
 const MeshLoader &MeshManager::getMeshLoader(const std::string &extension) {
 	const auto loaderIter = std::find_if(
 		_loaders.begin(),
@@ -21,9 +21,12 @@
 #ifndef AWE_MESHMANAGER_H
 #define AWE_MESHMANAGER_H
 
+#include <future>
 #include <map>
+#include <memory>
 #include <variant>
 
+#include "src/common/readstream.h"
 #include "src/common/singleton.h"
 
 #include "src/graphics/mesh.h"
@@ -68,6 +71,18 @@ public:
 		_loaders.emplace_back(std::make_unique<T>(std::forward<Params>(args)...));
 	}
 
+	/*!
+	 * Request the data of a mesh to be read asynchronously, so that it is
+	 * already available when the mesh is created by getMesh(). Requesting
+	 * every mesh needed at once allows the reads to be ordered by their
+	 * location in the archives. Meshes which are already loaded or requested
+	 * are ignored.
+	 * @param rid The rid of the mesh
+	 * @param priority The priority of the request
+	 */
+	void requestMesh(rid_t rid, int priority = 0);
+	void requestMesh(const std::string &path, int priority = 0);
+
 	MeshPtr getMesh(rid_t rid);
 	MeshPtr getMesh(const std::string &path);
 	MeshPtr getMesh(const std::string &path, std::initializer_list<std::string> stages);
@@ -75,6 +90,15 @@ public:
 	void clear();
 
 private:
+	typedef std::variant<rid_t, std::string> MeshKey;
+
+	/*!
+	 * Get the data of a mesh, either from a pending request or by reading it directly
+	 * @param key The rid or path of the mesh
+	 * @return The stream of the mesh data or nullptr if it does not exist
+	 */
+	std::unique_ptr<Common::ReadStream> getMeshResource(const MeshKey &key);
+
 	MeshPtr getMissingMesh();
 	MeshPtr getBrokenMesh();
 
@@ -84,7 +108,8 @@ private:
 
 	std::string _missingMeshPath, _brokenMeshPath;
 
-	std::map<std::variant<rid_t, std::string>, MeshPtr> _meshRegistry;
+	std::map<MeshKey, MeshPtr> _meshRegistry;
+	std::map<MeshKey, std::future<std::unique_ptr<Common::ReadStream>>> _requests;
 };
 
 } // End of namespace Graphics
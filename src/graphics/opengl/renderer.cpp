@@ -40,6 +40,7 @@
 #include "src/common/uuid.h"
 #include "src/common/writefile.h"
 #include "src/common/exception.h"
+#include "src/common/profiler.h"
 #include "src/common/strutil.h"
 #include "src/common/readfile.h"
 #include "src/common/sh.h"
@@ -328,6 +329,8 @@ Renderer::~Renderer() {
 }
 
 void Renderer::drawFrame() {
+	PROFILE_ZONE("Draw Frame");
+
 	_window.makeCurrent();
 
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -352,6 +355,8 @@ void Renderer::drawFrame() {
 }
 
 void Renderer::update() {
+	PROFILE_ZONE("Update Renderer");
+
 	Graphics::Renderer::update();
 
 	_window.makeCurrent();
@@ -364,6 +369,8 @@ void Renderer::update() {
 }
 
 void Renderer::drawWorld(const std::string &stage) {
+	PROFILE_ZONE("Draw World");
+
 	glm::mat4 vp = _projection * _view;
 	glm::mat4 viewToWorldMat = glm::inverse(_view);
 
@@ -411,8 +418,11 @@ void Renderer::drawWorld(const std::string &stage) {
 			currentShader->setUniformSampler(*lightBuffer, textureSlotShader++);
 		}
 
-		for (const auto &task: pass.renderTasks) {
-			if (!task.model->isVisible())
+		cullRenderTasks(pass, mirrorZ);
+
+		for (size_t taskIndex = 0; taskIndex < pass.renderTasks.size(); ++taskIndex) {
+			const auto &task = pass.renderTasks[taskIndex];
+			if (!task.model->isVisible() || !Common::Frustrum::isVisible(_visibleTasks, taskIndex))
 				continue;
 
 			glm::mat4 m = mirrorZ * task.model->getTransform();
@@ -421,12 +431,6 @@ void Renderer::drawWorld(const std::string &stage) {
 			glm::mat4 mvp = vp * m;
 
 			const MeshPtr mesh = task.model->getMesh();
-			if (task.model->hasBoundSphere()) {
-				auto boundingSphere = task.model->getBoundSphere();
-				boundingSphere.position = m * glm::vec4(boundingSphere.position, 1.0f);
-				if (!_frustrum.test(boundingSphere))
-					continue;
-			}
 
 			if (task.partMeshsToRender.empty())
 				continue;
@@ -580,6 +584,8 @@ void Renderer::drawWorld(const std::string &stage) {
 }
 
 void Renderer::drawLights() {
+	PROFILE_ZONE("Draw Lights");
+
 	pushDebugMarker("Draw Lights");
 
 	auto stencilProgram = getProgram("deferredlight", "render_stencil", 0);
@@ -685,6 +691,8 @@ void Renderer::drawLights() {
 }
 
 void Renderer::drawGUI() {
+	PROFILE_ZONE("Draw GUI");
+
 	glm::mat4 vp = glm::ortho(0.0f, 1920.0f, 0.0f, 1080.0f, -1000.0f, 1000.0f);
 
 	pushDebugMarker("Draw GUI");
@@ -736,6 +744,8 @@ void Renderer::drawSky() {
 	if (!_sky)
 		return;
 
+	PROFILE_ZONE("Draw Sky");
+
 	pushDebugMarker("Draw Sky");
 
 	glBindVertexArray(0);
@@ -813,6 +823,8 @@ void Renderer::drawSky() {
 }
 
 void Renderer::drawImGui() {
+	PROFILE_ZONE("Draw ImGui");
+
 	pushDebugMarker("Draw ImGui");
 
 	ImGui_ImplOpenGL3_NewFrame();
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 
 #include "renderer.h"
 
@@ -136,6 +137,36 @@ void Graphics::Renderer::setSky(Graphics::SkyPtr sky) {
 	_sky = sky;
 }
 
+void Graphics::Renderer::cullRenderTasks(const RenderPass &pass, const glm::mat4 &worldTransform) {
+	const size_t numTasks = pass.renderTasks.size();
+
+	_cullX.resize(numTasks);
+	_cullY.resize(numTasks);
+	_cullZ.resize(numTasks);
+	_cullRadius.resize(numTasks);
+	_visibleTasks.resize(Common::Frustrum::getMaskSize(numTasks));
+
+	for (size_t i = 0; i < numTasks; ++i) {
+		const Model *model = pass.renderTasks[i].model;
+
+		// An infinite radius lets every position pass the test
+		if (!model->hasBoundSphere()) {
+			_cullX[i] = _cullY[i] = _cullZ[i] = 0.0f;
+			_cullRadius[i] = std::numeric_limits<float>::infinity();
+			continue;
+		}
+
+		const auto &boundSphere = model->getBoundSphere();
+		const glm::vec3 position(worldTransform * model->getTransform() * glm::vec4(boundSphere.position, 1.0f));
+		_cullX[i] = position.x;
+		_cullY[i] = position.y;
+		_cullZ[i] = position.z;
+		_cullRadius[i] = boundSphere.radius;
+	}
+
+	_frustrum.test(_cullX, _cullY, _cullZ, _cullRadius, _visibleTasks);
+}
+
 void Graphics::Renderer::update() {
 	_view = _camera ? (*_camera).get().getLookAt() : glm::identity<glm::mat4>();
 	_frustrum.setViewMatrix(_view);
@@ -142,6 +142,16 @@ protected:
 		}
 	};
 
+	/*!
+	 * Test the bounding spheres of all render tasks of a pass against the frustrum in one batch. Afterwards the
+	 * visibility of every task can be retrieved with Common::Frustrum::isVisible from _visibleTasks. Tasks whose
+	 * model has no bounding sphere are always visible.
+	 *
+	 * \param pass The pass whose render tasks should be culled
+	 * \param worldTransform An additional transformation applied to the transform of every model
+	 */
+	void cullRenderTasks(const RenderPass &pass, const glm::mat4 &worldTransform);
+
 	glm::mat4 _view;
 	glm::mat4 _projection;
 
@@ -154,6 +164,10 @@ protected:
 
 	Common::Frustrum _frustrum;
 
+	// Bounding spheres of the render tasks which are culled in one batch, kept to avoid reallocations every frame
+	std::vector<float> _cullX, _cullY, _cullZ, _cullRadius;
+	std::vector<uint64_t> _visibleTasks;
+
 	std::vector<RenderPass> _renderPasses;
 	std::vector<ImGuiElement *> _imguiElements;
 	std::vector<GUIElement *> _guiElements;
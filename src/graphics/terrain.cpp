@@ -85,6 +85,10 @@ void Terrain::loadTerrainData(Common::ReadStream *terrainDataFile, std::vector<g
 	const auto &tilesets = terrainData.getTilesets();
 	const auto &blendMaps = terrainData.getBlendMaps();
 
+	// Request all textures at once, so that they are read in the order they are stored
+	for (const auto &texture : terrainData.getTextures())
+		TextureMan.requestTexture(texture);
+
 	std::vector<TexturePtr> localTextures;
 	for (const auto &texture : terrainData.getTextures()) {
 		localTextures.emplace_back(TextureMan.getTexture(texture));
@@ -23,6 +23,7 @@
 #include <filesystem>
 
 #include "src/common/exception.h"
+#include "src/common/profiler.h"
 
 #include "src/awe/resman.h"
 
@@ -33,6 +34,13 @@
 
 namespace Graphics {
 
+void TextureManager::requestTexture(const std::string &path, int priority) {
+	if (_textures.contains(path) || _requests.contains(path))
+		return;
+
+	_requests.emplace(path, ResMan.getResourceAsync(path, priority));
+}
+
 TexturePtr TextureManager::getTexture(const std::string &path) {
 	if (!std::regex_match(path, std::regex(".*(\\.tex|\\.tex_lo)$")))
 		throw Common::Exception("Invalid texture file {}", path);
@@ -40,7 +48,16 @@ TexturePtr TextureManager::getTexture(const std::string &path) {
 	if (_textures.find(path) != _textures.end())
 		return _textures[path];
 
-	std::unique_ptr<Common::ReadStream> stream(ResMan.getResource(path));
+	PROFILE_ZONE("Load Texture");
+
+	std::unique_ptr<Common::ReadStream> stream;
+	const auto request = _requests.find(path);
+	if (request != _requests.end()) {
+		stream = request->second.get();
+		_requests.erase(request);
+	} else {
+		stream.reset(ResMan.getResource(path));
+	}
 
 	std::unique_ptr<ImageDecoder> decoder;
 	// In Quantum break (and probably above) .tex files are actually dds files
@@ -21,10 +21,13 @@
 #ifndef AWE_TEXTUREMAN_H
 #define AWE_TEXTUREMAN_H
 
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
 #include <variant>
 
+#include "src/common/readstream.h"
 #include "src/common/singleton.h"
 #include "src/common/uuid.h"
 
@@ -36,6 +39,14 @@ namespace Graphics {
 
 class TextureManager : public Common::Singleton<TextureManager> {
 public:
+	/*!
+	 * Request the data of a texture to be read asynchronously, so that it is already available when the texture is
+	 * created by getTexture(). Textures which are already loaded or requested are ignored
+	 * \param path The path from which the texture is loaded
+	 * \param priority The priority of the request
+	 */
+	void requestTexture(const std::string &path, int priority = 0);
+
     /*!
      * Get a new texture decribed by a path. The texture will be cached to prevent multiple objects with the same
      * texture content
@@ -46,6 +57,7 @@ public:
 
 private:
 	std::map<std::variant<std::string, rid_t>, TexturePtr> _textures;
+	std::map<std::string, std::future<std::unique_ptr<Common::ReadStream>>> _requests;
 };
 
 }
@@ -36,93 +36,114 @@ Level::Level(entt::registry &registry, entt::scheduler<double> &scheduler, const
 
 	_terrain->setLabel(std::format("terrain_{}", _id));
 
-	loadGIDRegistry(ResMan.getResource(std::format("{}/GIDRegistry.txt", levelFolder)));
+	// Request the level archives at once, so that they can be read in the order they are stored
+	auto gidRegistryRequest = ResMan.getResourceAsync(std::format("{}/GIDRegistry.txt", levelFolder), 1);
+	auto globalRequest = ResMan.getBINArchiveAsync(std::format("{}/Global.bin", levelFolder), 1);
+	auto persistentRequest = ResMan.getBINArchiveAsync(std::format("{}/Persistent.bin", levelFolder), 1);
 
-	std::unique_ptr<Common::ReadStream> globalStream(ResMan.getResource(std::format("{}/Global.bin", levelFolder)));
-	AWE::BINArchive global(*globalStream);
+	loadGIDRegistry(gidRegistryRequest.get().release());
 
-	std::unique_ptr<Common::ReadStream> persistentStream(ResMan.getResource(std::format("{}/Persistent.bin", levelFolder)));
-	AWE::BINArchive persistent(*persistentStream);
+	const std::shared_ptr<AWE::BINArchive> global = globalRequest.get();
+
+	// The cell archives are requested with a lower priority, so they are loaded while the persistent objects are
+	// being created
+	struct CellRequests {
+		std::future<std::shared_ptr<AWE::BINArchive>> ldCell, hdCell, ldCellResources, hdCellResources;
+		std::future<std::unique_ptr<Common::ReadStream>> terrainCollisions;
+	};
+
+	const auto cellInfo = loadCellInfo(global->getResource("cid_cellinfo.bin"));
+	std::vector<CellRequests> cellRequests;
+	for (const auto &info : cellInfo) {
+		const std::string ldName = std::format("LD{:0>3}_{:0>3}", info.x, info.y);
+		const std::string hdName = std::format("HD{:0>3}_{:0>3}", info.x, info.y);
+
+		cellRequests.emplace_back(CellRequests{
+			ResMan.getBINArchiveAsync(std::format("{}/{}.bin", levelFolder, ldName)),
+			ResMan.getBINArchiveAsync(std::format("{}/{}.bin", levelFolder, hdName)),
+			ResMan.getBINArchiveAsync(std::format("{}/{}.resources", levelFolder, ldName)),
+			ResMan.getBINArchiveAsync(std::format("{}/{}.resources", levelFolder, hdName)),
+			ResMan.getResourceAsync(std::format("{}/{}.collisions", levelFolder, hdName)),
+		});
+	}
+
+	const std::shared_ptr<AWE::BINArchive> persistent = persistentRequest.get();
 
 	loadBytecode(
-			persistent.getResource("dp_bytecode.bin"),
-			persistent.getResource("dp_bytecodeparameters.bin")
+			persistent->getResource("dp_bytecode.bin"),
+			persistent->getResource("dp_bytecodeparameters.bin")
 	);
 
-	auto dp = std::make_shared<DPFile>(persistent.getResource("dp_persistent.bin"));
+	auto dp = std::make_shared<DPFile>(persistent->getResource("dp_persistent.bin"));
 
 	spdlog::info("Loading attachment containers for {}", id);
-	load(persistent.getResource("cid_attachmentcontainer.bin"), kAttachmentContainer, dp);
+	load(persistent->getResource("cid_attachmentcontainer.bin"), kAttachmentContainer, dp);
 
 	// ,--- Load Possible attachment container resources
 	spdlog::info("Loading script instances for {}", id);
-	load(persistent.getResource("cid_scriptinstance.bin"), kScriptInstance, dp);
-	load(persistent.getResource("cid_scriptinstancescript.bin"), kScript, dp);
+	load(persistent->getResource("cid_scriptinstance.bin"), kScriptInstance, dp);
+	load(persistent->getResource("cid_scriptinstancescript.bin"), kScript, dp);
 
 	spdlog::info("Loading Point Lights for {}", id);
-	load(persistent.getResource("cid_pointlight.bin"), kPointLight, dp);
+	load(persistent->getResource("cid_pointlight.bin"), kPointLight, dp);
 
 	spdlog::info("Loading ambient lights for {}", id);
-	load(persistent.getResource("cid_ambientlight.bin"), kAmbientLight, dp);
-	load(persistent.getResource("cid_ambientlightscript.bin"), kScript, dp);
+	load(persistent->getResource("cid_ambientlight.bin"), kAmbientLight, dp);
+	load(persistent->getResource("cid_ambientlightscript.bin"), kScript, dp);
 
 	spdlog::info("Loading Triggers for {}", id);
-	load(persistent.getResource("cid_trigger.bin"), kTrigger, dp);
-	load(persistent.getResource("cid_triggerscript.bin"), kScript, dp);
+	load(persistent->getResource("cid_trigger.bin"), kTrigger, dp);
+	load(persistent->getResource("cid_triggerscript.bin"), kScript, dp);
 	// '---
 
 	spdlog::info("Loading static objects for {}", id);
-	load(global.getResource("cid_staticobject.bin"), kStaticObject);
+	load(global->getResource("cid_staticobject.bin"), kStaticObject);
 
 	spdlog::info("Loading dynamic objects for {}", id);
-	load(persistent.getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
-	load(persistent.getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
+	load(persistent->getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
+	load(persistent->getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
 
 	spdlog::info("Loading characters for {}", id);
-	load(persistent.getResource("cid_character.bin"), kCharacter, dp);
-	load(persistent.getResource("cid_characterscript.bin"), kCharacterScript, dp);
+	load(persistent->getResource("cid_character.bin"), kCharacter, dp);
+	load(persistent->getResource("cid_characterscript.bin"), kCharacterScript, dp);
 
 	spdlog::info("Loading floating scripts for {}", id);
-	load(persistent.getResource("cid_floatingscript.bin"), kFloatingScript, dp);
+	load(persistent->getResource("cid_floatingscript.bin"), kFloatingScript, dp);
 
 	spdlog::info("Loading key frames for {}", id);
-	load(persistent.getResource("cid_keyframe.bin"), kKeyframe, dp);
+	load(persistent->getResource("cid_keyframe.bin"), kKeyframe, dp);
 
 	spdlog::info("Loading key frame animations for {}", id);
-	load(persistent.getResource("cid_keyframeanimation.bin"), kKeyframeAnimation, dp);
+	load(persistent->getResource("cid_keyframeanimation.bin"), kKeyframeAnimation, dp);
 
 	spdlog::info("Loading key framers for {}", id);
-	load(persistent.getResource("cid_keyframer.bin"), kKeyframer, dp);
-	load(persistent.getResource("cid_keyframerscript.bin"), kScript, dp);
+	load(persistent->getResource("cid_keyframer.bin"), kKeyframer, dp);
+	load(persistent->getResource("cid_keyframerscript.bin"), kScript, dp);
 
 	spdlog::info("Loading key framed objects for {}", id);
-	load(persistent.getResource("cid_keyframedobject.bin"), kKeyframedObject, dp);
-	load(persistent.getResource("cid_keyframedobjectscript.bin"), kDynamicObjectScript, dp);
-
-	const auto cellInfo = loadCellInfo(global.getResource("cid_cellinfo.bin"));
-	for (const auto &info : cellInfo) {
-		const std::string ldName = std::format("LD{:0>3}_{:0>3}", info.x, info.y);
-		const std::string hdName = std::format("HD{:0>3}_{:0>3}", info.x, info.y);
+	load(persistent->getResource("cid_keyframedobject.bin"), kKeyframedObject, dp);
+	load(persistent->getResource("cid_keyframedobjectscript.bin"), kDynamicObjectScript, dp);
 
-		AWE::BINArchive ldCell(std::format("{}/{}.bin", levelFolder, ldName));
-		AWE::BINArchive hdCell(std::format("{}/{}.bin", levelFolder, hdName));
-		AWE::BINArchive ldCellResources(std::format("{}/{}.resources", levelFolder, ldName));
-		AWE::BINArchive hdCellResources(std::format("{}/{}.resources", levelFolder, hdName));
+	for (auto &requests : cellRequests) {
+		const std::shared_ptr<AWE::BINArchive> ldCell = requests.ldCell.get();
+		const std::shared_ptr<AWE::BINArchive> hdCell = requests.hdCell.get();
+		const std::shared_ptr<AWE::BINArchive> ldCellResources = requests.ldCellResources.get();
+		const std::shared_ptr<AWE::BINArchive> hdCellResources = requests.hdCellResources.get();
 
 		//DPFile dphd(persistent.getResource("dp_hdcell.bin"));
-		load(hdCell.getResource("cid_staticobject.bin"), kStaticObject);
-		load(ldCell.getResource("cid_staticobject.bin"), kStaticObject);
+		load(hdCell->getResource("cid_staticobject.bin"), kStaticObject);
+		load(ldCell->getResource("cid_staticobject.bin"), kStaticObject);
 		loadTerrainData(
-			ldCell.getResource("cid_terraindata.bin"),
-			hdCell.getResource("cid_terraindata.bin")
+			ldCell->getResource("cid_terraindata.bin"),
+			hdCell->getResource("cid_terraindata.bin")
 		);
 
-		std::unique_ptr<Common::ReadStream> terrainCollisions(ResMan.getResource(std::format("{}/{}.collisions", levelFolder, hdName)));
+		std::unique_ptr<Common::ReadStream> terrainCollisions = requests.terrainCollisions.get();
 		assert(terrainCollisions);
 		loadTerrainCollisions(terrainCollisions.get());
 
-		loadFoliageData(hdCell.getResource("cid_foliagedata.bin"));
-		loadFoliageData(ldCell.getResource("cid_foliagedata.bin"));
+		loadFoliageData(hdCell->getResource("cid_foliagedata.bin"));
+		loadFoliageData(ldCell->getResource("cid_foliagedata.bin"));
 	}
 
 	_terrain->finalize();
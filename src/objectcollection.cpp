@@ -95,6 +95,7 @@ void ObjectCollection::load(Common::ReadStream *stream, ObjectType type) {
 	std::unique_ptr<Common::ReadStream> cidStream(stream);
 	AWE::CIDFile cid(*cidStream, type, nullptr);
 
+	requestMeshes(cid.getContainers(), type);
 	for (const auto &container : cid.getContainers()) {
 		load(container, type);
 	}
@@ -107,12 +108,35 @@ void ObjectCollection::load(Common::ReadStream *stream, ObjectType type, std::sh
 	std::unique_ptr<Common::ReadStream> cidStream(stream);
 	AWE::CIDFile cid(*cidStream, type, dp);
 
+	requestMeshes(cid.getContainers(), type);
 	for (const auto &container : cid.getContainers()) {
 		load(container, type);
 	}
 }
 
-void ObjectCollection::loadFoliageData(Common::ReadStream *foliageData) {
+void ObjectCollection::requestMeshes(const std::vector<AWE::Object> &containers, ObjectType type) {
+	// Request the meshes of all objects at once, so that they are read in the order they are stored
+	for (const auto &container : containers) {
+		switch (type) {
+			case kStaticObject:
+				MeshMan.requestMesh(std::any_cast<AWE::Templates::StaticObject>(container).meshResource);
+				break;
+			case kDynamicObject:
+				MeshMan.requestMesh(std::any_cast<AWE::Templates::DynamicObject>(container).meshResource);
+				break;
+			case kCharacter:
+				MeshMan.requestMesh(std::any_cast<AWE::Templates::Character>(container).meshResource);
+				break;
+			case kKeyframedObject:
+				MeshMan.requestMesh(std::any_cast<AWE::Templates::KeyFramedObject>(container).meshResource);
+				break;
+			default:
+				return;
+		}
+	}
+}
+
+Common::ReadStream *foliageData) {
 	std::unique_ptr<Common::ReadStream> foliageDataStream(foliageData);
 	AWE::FoliageDataFile foliageDataFile(*foliageDataStream);
 
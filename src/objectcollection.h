@@ -57,6 +57,8 @@ protected:
 private:
 	void load(const AWE::Object &container, ObjectType type);
 
+	void requestMeshes(const std::vector<AWE::Object> &containers, ObjectType type);
+
 	void loadSkeleton(const AWE::Object &container);
 	void loadAnimation(const AWE::Object &container);
 	void loadNotebookPage(const AWE::Object &container);
@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "src/common/profiler.h"
+
 #include "physicsman.h"
 #include "src/physics/debugdraw.h"
 
@@ -50,9 +52,13 @@ void PhysicsManager::setDebugDraw(bool enable) {
 }
 
 void PhysicsManager::update(float delta) {
+	PROFILE_ZONE("Physics Step");
+
 	_world->stepSimulation(delta, 20);
-	if (_debugDraw)
+	if (_debugDraw) {
+		PROFILE_ZONE("Physics Debug Draw");
 		_world->debugDrawWorld();
+	}
 }
 
 void PhysicsManager::add(btCollisionObject *collisionObject) {
@@ -20,6 +20,8 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <chrono>
+#include <algorithm>
 
 #include "src/common/threadpool.h"
 
@@ -28,13 +30,17 @@
 
 namespace Sound {
 
+static const size_t kNumBuffers = 32;
+static const size_t kSamplesPerBuffer = 4096;
+
 Stream::Stream(Codecs::AudioStream *stream) :
 	_format(getAudioFormat(stream->getChannelCount(), stream->getBitsPerSample())),
+	_timer(0),
 	_stream(stream),
 	_playing(false) {
 	setRelative(true);
-	_buffers.resize(32);
-	alGenBuffers(32, _buffers.data());
+	_buffers.resize(kNumBuffers);
+	alGenBuffers(kNumBuffers, _buffers.data());
 	for (const auto &buffer: _buffers) {
 		_availableBuffers.push_back(buffer);
 	}
@@ -43,40 +49,76 @@ Stream::Stream(Codecs::AudioStream *stream) :
 Stream::~Stream() {
 	if (isPlaying())
 		stop();
+	Threads.cancel(_timer);
 
 	// Unqueue all used buffers to delete them
 	for (const auto &usedBuffer: _usedBuffers)
 		unqueueBuffer(usedBuffer);
 
-	alDeleteBuffers(32, _buffers.data());
+	alDeleteBuffers(kNumBuffers, _buffers.data());
 }
 
 void Stream::play() {
+	std::lock_guard<std::mutex> l(_access);
+	if (_playing)
+		return;
+
 	_playing = true;
 	update();
 	Source::play();
+
+	/*
+	 * Wake up whenever a quarter of the buffers could have been played. The
+	 * interval assumes every sample of every channel to take a sample
+	 * period, so it rather is too short than too long.
+	 */
+	const auto samplesPerSecond = _stream->getSampleRate() * _stream->getChannelCount();
+	const auto interval = std::chrono::microseconds(
+		kSamplesPerBuffer * (kNumBuffers / 4) * 1000000 / std::max<size_t>(samplesPerSecond, 1)
+	);
+	_timer = Threads.addPeriodic(interval, [this]{ tick(); }, Common::TaskPriority::kRealtime);
 }
 
 void Stream::stop() {
-	_stopped.lock();
-	_playing = false;
+	{
+		std::lock_guard<std::mutex> l(_access);
+		_playing = false;
+	}
+
+	// Wait for a running update, it can't be called anymore afterwards
+	Threads.cancel(_timer);
+	_timer = 0;
+
 	Source::stop();
-	_stopped.lock();
-	_stopped.unlock();
 }
 
-void Stream::update() {
-	if (!_playing) {
-		_stopped.unlock();
+void Stream::tick() {
+	std::lock_guard<std::mutex> l(_access);
+	if (!_playing)
 		return;
+
+	if (!update()) {
+		_playing = false;
+		Threads.cancel(_timer);
 	}
+}
 
-	// Try to fill as many buffers as possible
+bool Stream::update() {
+	// Unqueue buffers already played
+	const unsigned int buffersProcessed = getBuffersProcessed();
+	for (unsigned int i = 0; i < buffersProcessed; ++i) {
+		ALuint nextBuffer = _usedBuffers.front();
+		_usedBuffers.pop_front();
+		unqueueBuffer(nextBuffer);
+		_availableBuffers.push_back(nextBuffer);
+	}
+
+	// And try to fill as many buffers as possible
 	while (!_availableBuffers.empty() && !_stream->eos()) {
 		ALuint nextBuffer = _availableBuffers.front();
 		_availableBuffers.pop_front();
 
-		const auto sampleData = _stream->read(4096);
+		const auto sampleData = _stream->read(kSamplesPerBuffer);
 		alBufferData(
 			nextBuffer,
 			_format,
@@ -89,21 +131,8 @@ void Stream::update() {
 		_usedBuffers.push_back(nextBuffer);
 	}
 
-	// And unqueue buffers already played
-	for (unsigned int i = 0; i < getBuffersProcessed(); ++i) {
-		ALuint nextBuffer = _usedBuffers.front();
-		_usedBuffers.pop_front();
-		unqueueBuffer(nextBuffer);
-		_availableBuffers.push_back(nextBuffer);
-	}
-
 	// If there are no more used buffers and the stream is at its end, stop the whole thing
-	if (_usedBuffers.empty() && _stream->eos()) {
-		_playing = false;
-		return;
-	}
-
-	Threads.add([this]{ update(); });
+	return !_usedBuffers.empty() || !_stream->eos();
 }
 
 LoopableStream::LoopableStream(Codecs::SeekableAudioStream *stream) :
@@ -118,18 +147,22 @@ void LoopableStream::setLoopRange(unsigned int start, unsigned int end) {
 	_loopEnd = end;
 }
 
-void LoopableStream::update() {
-	if (!_playing) {
-		_stopped.unlock();
-		return;
+bool LoopableStream::update() {
+	// Unqueue buffers already played
+	const unsigned int buffersProcessed = getBuffersProcessed();
+	for (unsigned int i = 0; i < buffersProcessed; ++i) {
+		ALuint nextBuffer = _usedBuffers.front();
+		_usedBuffers.pop_front();
+		unqueueBuffer(nextBuffer);
+		_availableBuffers.push_back(nextBuffer);
 	}
 
-	// Try to fill as many buffers as possible
+	// And try to fill as many buffers as possible
 	while (!_availableBuffers.empty()) {
 		ALuint nextBuffer = _availableBuffers.front();
 		_availableBuffers.pop_front();
 
-		const auto samplesToRead = std::min<size_t>(std::min<size_t>(_seekableStream->getTotalSamples(), _loopEnd) - _stream->pos(), 4096);
+		const auto samplesToRead = std::min<size_t>(std::min<size_t>(_seekableStream->getTotalSamples(), _loopEnd) - _stream->pos(), kSamplesPerBuffer);
 		const auto sampleData = _stream->read(samplesToRead);
 		alBufferData(
 			nextBuffer,
@@ -146,15 +179,7 @@ void LoopableStream::update() {
 		_usedBuffers.push_back(nextBuffer);
 	}
 
-	// And unqueue buffers already played
-	for (unsigned int i = 0; i < getBuffersProcessed(); ++i) {
-		ALuint nextBuffer = _usedBuffers.front();
-		_usedBuffers.pop_front();
-		unqueueBuffer(nextBuffer);
-		_availableBuffers.push_back(nextBuffer);
-	}
-
-	Threads.add([this]{ update(); });
+	return true;
 }
 
 } // End of namespace Sound
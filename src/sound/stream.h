@@ -25,6 +25,8 @@
 #include <memory>
 #include <mutex>
 
+#include "src/common/threadpool.h"
+
 #include "src/codecs/audiostream.h"
 
 #include "src/sound/source.h"
@@ -41,17 +43,26 @@ public:
 	void stop() override;
 
 protected:
-	virtual void update();
+	/*!
+	 * Unqueue the already played buffers and fill all available buffers
+	 * \return If the stream has more data to play
+	 */
+	virtual bool update();
 
 	const ALenum _format;
 
-	std::mutex _stopped;
+	/** Guards the playing state against the periodic updates */
+	std::mutex _access;
+	Common::TimerId _timer;
 	std::unique_ptr<Codecs::AudioStream> _stream;
 	std::vector<ALuint> _buffers;
 	std::deque<ALuint> _availableBuffers;
 	std::deque<ALuint> _usedBuffers;
 
 	bool _playing;
+
+private:
+	void tick();
 };
 
 class LoopableStream : public Stream {
@@ -61,7 +72,7 @@ public:
 	void setLoopRange(unsigned int start, unsigned int end);
 
 protected:
-	void update() override;
+	bool update() override;
 
 	Codecs::SeekableAudioStream *_seekableStream;
 	size_t _loopStart, _loopEnd;
@@ -42,6 +42,7 @@ namespace Video {
 Player::Player() :
 		_ssse3(Common::hasSSSE3()),
 		_playing(false),
+		_preloadTimer(0),
 		_proxyTexture(GfxMan.createProxyTexture()) {
 
 }
@@ -49,6 +50,7 @@ Player::Player() :
 Player::~Player() {
 	if (_playing)
 		stop();
+	Threads.cancel(_preloadTimer);
 }
 
 void Player::setAudioTracks(std::initializer_list<unsigned int> ids) {
@@ -125,18 +127,19 @@ void Player::play() {
 		stream->play();
 	}
 
-	Threads.add([this](){ preloadLoop(); });
+	// Decode new frames whenever a few frames could have been shown
+	_preloadTimer = Threads.addPeriodic(_frameDuration * 4, [this](){ preloadLoop(); });
 }
 
 void Player::stop() {
-	_stopped.lock();
 	_playing = false;
 	for (auto &stream: _streams) {
 		stream->stop();
 	}
 
-	_stopped.lock();
-	_stopped.unlock();
+	// Wait until a running preloading step is finished
+	Threads.cancel(_preloadTimer);
+	_preloadTimer = 0;
 }
 
 bool Player::isPlaying() const {
@@ -177,8 +180,11 @@ void Player::update() {
 		_preparedTextures.pop_front();
 	}
 
-	if (_preparedTextures.empty() && _video->eos())
+	if (_preparedTextures.empty() && _video->eos()) {
 		_playing = false;
+		Threads.cancel(_preloadTimer);
+		_preloadTimer = 0;
+	}
 }
 
 void Player::prepareTextures() {
@@ -220,14 +226,10 @@ void Player::prepareSurfaces() {
 }
 
 void Player::preloadLoop() {
-	if (!_playing) {
-		_stopped.unlock();
+	if (!_playing)
 		return;
-	}
 
 	prepareSurfaces();
-
-	Threads.add([this](){ preloadLoop(); });
 }
 
 }
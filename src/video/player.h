@@ -29,6 +29,7 @@
 #include <atomic>
 
 #include "src/common/uuid.h"
+#include "src/common/threadpool.h"
 
 #include "src/graphics/texture.h"
 #include "src/graphics/images/surface.h"
@@ -68,8 +69,8 @@ private:
 
 	std::atomic_bool _playing;
 
-	/** Variable to wait until the preloading step is successfully stopped */
-	std::mutex _stopped;
+	/** Periodic task decoding the next frames while playing */
+	Common::TimerId _preloadTimer;
 
 	Codecs::YCbCrBuffer _ycbcr;
 
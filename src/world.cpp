@@ -73,35 +73,39 @@ void World::loadGlobal() {
 	else
 		throw std::runtime_error("global world archive not found");
 
-	AWE::BINArchive tasks(globalArchive);
+	const std::shared_ptr<AWE::BINArchive> tasks = ResMan.getBINArchive(globalArchive);
 
-	auto dp = std::make_shared<DPFile>(tasks.getResource("dp_task.bin"));
+	auto dp = std::make_shared<DPFile>(tasks->getResource("dp_task.bin"));
 
 	loadBytecode(
-			tasks.getResource("dp_bytecode.bin"),
-			tasks.getResource("dp_bytecodeparameters.bin")
+			tasks->getResource("dp_bytecode.bin"),
+			tasks->getResource("dp_bytecodeparameters.bin")
 	);
 
 	spdlog::info("Loading static objects for {}", _name);
-	load(tasks.getResource("cid_staticobject.bin"), kStaticObject, dp);
+	load(tasks->getResource("cid_staticobject.bin"), kStaticObject, dp);
 
 	spdlog::info("Loading dynamic objects for {}", _name);
-	load(tasks.getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
-	load(tasks.getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
+	load(tasks->getResource("cid_dynamicobject.bin"), kDynamicObject, dp);
+	load(tasks->getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp);
 
 	spdlog::info("Loading characters for {}", _name);
-	load(tasks.getResource("cid_character.bin"), kCharacter, dp);
-	load(tasks.getResource("cid_characterscript.bin"), kCharacterScript, dp);
+	load(tasks->getResource("cid_character.bin"), kCharacter, dp);
+	load(tasks->getResource("cid_characterscript.bin"), kCharacterScript, dp);
 }
 
 void World::loadEpisode(const std::string &id) {
 	spdlog::info("Loading episode {} from {}", id, _name);
 	WorldFile::Level level = _world->getLevel(id);
 
+	ResMan.beginSession(std::format("{}_{}", _name, id));
+
 	_currentEpisode = std::make_unique<Episode>(_registry, _scheduler, _name, id);
 	for (const auto &fileName : level.fileNames) {
 		_currentEpisode->loadLevel(fileName);
 	}
+
+	ResMan.endSession();
 }
 
 void World::setVisible(bool visible) {
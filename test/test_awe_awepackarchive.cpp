@@ -0,0 +1,179 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/common/mappedfile.h"
+#include "src/common/memreadstream.h"
+#include "src/common/readfile.h"
+
+#include "src/awe/awepackarchive.h"
+#include "src/awe/awepackwriter.h"
+
+#if WITH_LZ4
+static const bool kHasLZ4 = true;
+#else
+static const bool kHasLZ4 = false;
+#endif
+
+static std::vector<byte> createData(size_t size, byte seed, bool compressible) {
+	std::vector<byte> data(size);
+	uint32_t state = seed;
+	for (size_t i = 0; i < size; ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		data[i] = compressible ? static_cast<byte>((i / 64) + seed) : static_cast<byte>(state);
+	}
+	return data;
+}
+
+static std::vector<byte> readAll(Common::ReadStream &stream) {
+	std::vector<byte> data(stream.size());
+	EXPECT_EQ(stream.read(data.data(), data.size()), data.size());
+	return data;
+}
+
+class AWEPackArchive : public testing::Test {
+protected:
+	void SetUp() override {
+		_filename = std::tmpnam(nullptr);
+
+		_data1 = createData(5000, 1, true);
+		_data2 = createData(100, 2, false);
+		_data3 = createData(20000, 3, true);
+
+		AWE::AWEPackWriter writer(_filename, 4096);
+		writer.add("d:/data/Textures/a.tex", _data1, false);
+		writer.add("d:/data/textures/b.tex", _data2, true);
+		writer.add("d:/data/meshes/sub/c.binmsh", _data3, kHasLZ4);
+		writer.add("d:/data/empty.txt", {}, false);
+		EXPECT_ANY_THROW(writer.add("d:/data/TEXTURES/A.TEX", _data1, false));
+		writer.finish();
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(_filename);
+	}
+
+	void checkArchive(const AWE::AWEPackArchive &archive) {
+		ASSERT_EQ(archive.getNumResources(), 4);
+
+		// Resources keep the order in which they were added and are stored in lower case
+		EXPECT_EQ(archive.getResourcePath(0), "d:/data/textures/a.tex");
+		EXPECT_EQ(archive.getResourcePath(1), "d:/data/textures/b.tex");
+		EXPECT_EQ(archive.getResourcePath(2), "d:/data/meshes/sub/c.binmsh");
+		EXPECT_EQ(archive.getResourcePath(3), "d:/data/empty.txt");
+
+		EXPECT_EQ(archive.findResource("d:/data/textures/b.tex"), 1);
+		EXPECT_FALSE(archive.findResource("d:/data/textures/c.tex"));
+		EXPECT_TRUE(archive.hasResource("d:/data/meshes/sub/c.binmsh"));
+		EXPECT_FALSE(archive.hasResource("d:/data/meshes/sub"));
+
+		std::unique_ptr<Common::ReadStream> stream1(archive.getResource("d:/data/textures/a.tex"));
+		std::unique_ptr<Common::ReadStream> stream2(archive.getResource("d:/data/textures/b.tex"));
+		std::unique_ptr<Common::ReadStream> stream3(archive.getResourceByIndex(2));
+		std::unique_ptr<Common::ReadStream> stream4(archive.getResourceByIndex(3));
+		ASSERT_TRUE(stream1 && stream2 && stream3 && stream4);
+		EXPECT_EQ(readAll(*stream1), _data1);
+		EXPECT_EQ(readAll(*stream2), _data2);
+		EXPECT_EQ(readAll(*stream3), _data3);
+		EXPECT_EQ(stream4->size(), 0);
+
+		EXPECT_EQ(archive.getResource("d:/data/missing"), nullptr);
+		EXPECT_EQ(archive.getResourceByIndex(4), nullptr);
+
+		// Every resource starts at a page boundary
+		for (size_t i = 0; i < archive.getNumResources(); ++i) {
+			const auto range = archive.getResourceRange(i);
+			ASSERT_TRUE(range);
+			EXPECT_EQ(range->offset % 4096, 0);
+		}
+		EXPECT_EQ(archive.getResourceRange(0)->size, _data1.size());
+		EXPECT_LT(archive.getResourceRange(0)->offset, archive.getResourceRange(1)->offset);
+		EXPECT_LT(archive.getResourceRange(1)->offset, archive.getResourceRange(2)->offset);
+	}
+
+	std::string _filename;
+	std::vector<byte> _data1, _data2, _data3;
+};
+
+TEST_F(AWEPackArchive, readMapped) {
+	AWE::AWEPackArchive archive(new Common::MappedFile(_filename));
+	checkArchive(archive);
+
+	// Incompressible data is stored uncompressed
+	EXPECT_EQ(archive.getResourceRange(1)->size, _data2.size());
+	EXPECT_EQ(archive.isMemoryBacked(), !kHasLZ4);
+}
+
+TEST_F(AWEPackArchive, readFile) {
+	AWE::AWEPackArchive archive(new Common::ReadFile(_filename));
+	checkArchive(archive);
+
+	EXPECT_FALSE(archive.isMemoryBacked());
+}
+
+TEST_F(AWEPackArchive, directories) {
+	AWE::AWEPackArchive archive(new Common::MappedFile(_filename));
+
+	EXPECT_TRUE(archive.hasDirectory("d:/data"));
+	EXPECT_TRUE(archive.hasDirectory("d:/data/meshes"));
+	EXPECT_TRUE(archive.hasDirectory("d:/data/Textures/"));
+	EXPECT_FALSE(archive.hasDirectory("d:/data/tex"));
+
+	EXPECT_EQ(archive.getDirectoryResources("d:/data/textures"), (std::vector<size_t>{0, 1}));
+	EXPECT_EQ(archive.getDirectoryResources("d:/data"), (std::vector<size_t>{3}));
+	EXPECT_TRUE(archive.getDirectoryResources("d:/data/meshes").empty());
+}
+
+TEST_F(AWEPackArchive, invalidFile) {
+	static const byte kData[64] = {};
+	EXPECT_ANY_THROW(AWE::AWEPackArchive archive(new Common::MemoryReadStream(kData, sizeof(kData))));
+}
+
+TEST_F(AWEPackArchive, fullIndex) {
+	std::ifstream in(_filename, std::ios::binary);
+	std::vector<byte> pack{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+	ASSERT_GE(pack.size(), sizeof(AWE::AWEPackArchive::Header));
+
+	AWE::AWEPackArchive::Header header;
+	std::memcpy(&header, pack.data(), sizeof(header));
+
+	// Fill every free slot of the index with a duplicate of the first entry
+	const size_t indexOffset = header.tablesOffset + header.numEntries * sizeof(AWE::AWEPackArchive::Entry);
+	for (size_t i = 0; i < header.indexSize; ++i) {
+		AWE::AWEPackArchive::IndexEntry indexEntry;
+		byte *slot = pack.data() + indexOffset + i * sizeof(indexEntry);
+		std::memcpy(&indexEntry, slot, sizeof(indexEntry));
+		if (indexEntry.entryIndex == AWE::AWEPackArchive::kInvalidIndex)
+			indexEntry.entryIndex = 0;
+		std::memcpy(slot, &indexEntry, sizeof(indexEntry));
+	}
+
+	EXPECT_ANY_THROW(AWE::AWEPackArchive archive(new Common::MemoryReadStream(pack.data(), pack.size(), false)));
+}
@@ -185,3 +185,25 @@ TEST(BINArchive, MultipleFiles) {
 	EXPECT_STREQ(test2Text.c_str(), "Hello World :D");
 	EXPECT_STREQ(test3Text.c_str(), kLipsum);
 }
+
+TEST(BINArchive, OutOfOrderAccess) {
+	Common::MemoryReadStream bin(kMultipleFilesBin, sizeof(kMultipleFilesBin));
+
+	AWE::BINArchive binArchive(bin);
+
+	// The data is inflated on demand, so accessing entries in any order has to work
+	std::unique_ptr<Common::ReadStream> test3(binArchive.getResource("test3.txt"));
+	std::unique_ptr<Common::ReadStream> test1(binArchive.getResource("test.txt"));
+	std::unique_ptr<Common::ReadStream> test3Again(binArchive.getResource("test3.txt"));
+	std::unique_ptr<Common::ReadStream> test2(binArchive.getResource("test2.txt"));
+
+	ASSERT_TRUE(test1);
+	ASSERT_TRUE(test2);
+	ASSERT_TRUE(test3);
+	ASSERT_TRUE(test3Again);
+
+	EXPECT_STREQ(test1->readNullTerminatedString().c_str(), "Hello World!");
+	EXPECT_STREQ(test2->readNullTerminatedString().c_str(), "Hello World :D");
+	EXPECT_STREQ(test3->readNullTerminatedString().c_str(), kLipsum);
+	EXPECT_STREQ(test3Again->readNullTerminatedString().c_str(), kLipsum);
+}
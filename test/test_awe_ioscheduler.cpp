@@ -0,0 +1,177 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <mutex>
+#include <future>
+#include <stdexcept>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memreadstream.h"
+
+#include "src/awe/ioscheduler.h"
+
+/*!
+ * Archive with fixed resource ranges, which records the order in which
+ * resources are created and ranges are prefetched. The first resource
+ * blocks, until it is released by the test.
+ */
+class RecordingArchive : public AWE::Archive {
+public:
+	RecordingArchive(std::vector<ResourceRange> ranges) : _ranges(std::move(ranges)) {
+	}
+
+	size_t getNumResources() const override {
+		return _ranges.size();
+	}
+
+	std::vector<size_t> getDirectoryResources(const std::string &directory) override {
+		return {};
+	}
+
+	std::string getResourcePath(size_t index) const override {
+		return std::to_string(index);
+	}
+
+	Common::ReadStream *getResource(const std::string &rid) const override {
+		return nullptr;
+	}
+
+	Common::ReadStream *getResourceByIndex(size_t index) const override {
+		if (index == 0) {
+			entered.set_value();
+			release.get_future().wait();
+		}
+
+		if (index >= _ranges.size())
+			throw std::runtime_error("Invalid index");
+
+		std::lock_guard<std::mutex> l(_access);
+		created.emplace_back(index);
+		static const byte kData[] = {0};
+		return new Common::MemoryReadStream(kData, sizeof(kData));
+	}
+
+	std::optional<ResourceRange> getResourceRange(size_t index) const override {
+		if (index == invalidRange)
+			throw std::logic_error("Invalid range");
+		if (index >= _ranges.size())
+			return std::nullopt;
+		return _ranges[index];
+	}
+
+	void prefetch(const ResourceRange &range) const override {
+		std::lock_guard<std::mutex> l(_access);
+		prefetched.emplace_back(range);
+	}
+
+	bool hasResource(const std::string &rid) const override {
+		return false;
+	}
+
+	bool hasDirectory(const std::string &directory) const override {
+		return false;
+	}
+
+	mutable std::promise<void> entered, release;
+	mutable std::vector<size_t> created;
+	mutable std::vector<ResourceRange> prefetched;
+	size_t invalidRange{std::numeric_limits<size_t>::max()};
+
+private:
+	mutable std::mutex _access;
+	std::vector<ResourceRange> _ranges;
+};
+
+TEST(IOScheduler, orderByPriorityAndOffset) {
+	RecordingArchive archive({
+		{5000000, 10},
+		{100, 10},
+		{200, 10},
+		{300, 10},
+		{10000000, 10},
+		{0, 10},
+	});
+
+	std::vector<std::future<std::unique_ptr<Common::ReadStream>>> requests;
+
+	{
+		AWE::IOScheduler scheduler;
+
+		// Block the io thread, so that the following requests are collected
+		requests.emplace_back(scheduler.request(&archive, 0));
+		archive.entered.get_future().wait();
+
+		requests.emplace_back(scheduler.request(&archive, 3));
+		requests.emplace_back(scheduler.request(&archive, 1));
+		requests.emplace_back(scheduler.request(&archive, 4));
+		requests.emplace_back(scheduler.request(&archive, 2));
+		requests.emplace_back(scheduler.request(&archive, 5, 1));
+		EXPECT_EQ(scheduler.getNumPendingRequests(), 5);
+
+		archive.release.set_value();
+
+		for (auto &request : requests)
+			EXPECT_TRUE(request.get());
+	}
+
+	const std::vector<size_t> expectedOrder{0, 5, 1, 2, 3, 4};
+	EXPECT_EQ(archive.created, expectedOrder);
+
+	// The close ranges of the second batch are merged into one prefetch
+	ASSERT_EQ(archive.prefetched.size(), 4);
+	EXPECT_EQ(archive.prefetched[0].offset, 5000000);
+	EXPECT_EQ(archive.prefetched[0].size, 10);
+	EXPECT_EQ(archive.prefetched[1].offset, 0);
+	EXPECT_EQ(archive.prefetched[1].size, 10);
+	EXPECT_EQ(archive.prefetched[2].offset, 100);
+	EXPECT_EQ(archive.prefetched[2].size, 210);
+	EXPECT_EQ(archive.prefetched[3].offset, 10000000);
+	EXPECT_EQ(archive.prefetched[3].size, 10);
+}
+
+TEST(IOScheduler, propagateExceptions) {
+	RecordingArchive archive({{0, 10}});
+	archive.release.set_value();
+
+	AWE::IOScheduler scheduler;
+	auto invalidIndex = scheduler.request(&archive, 1);
+	auto invalidFile = scheduler.request("nonexistent/file.bin");
+
+	EXPECT_THROW(invalidIndex.get(), std::runtime_error);
+	EXPECT_ANY_THROW(invalidFile.get());
+	EXPECT_THROW(scheduler.request(nullptr, 0), std::exception);
+}
+
+TEST(IOScheduler, propagateRangeExceptions) {
+	RecordingArchive archive({{0, 10}, {100, 10}});
+	archive.invalidRange = 1;
+	archive.release.set_value();
+
+	AWE::IOScheduler scheduler;
+	auto valid = scheduler.request(&archive, 0);
+	auto invalidRange = scheduler.request(&archive, 1);
+
+	EXPECT_TRUE(valid.get());
+	EXPECT_THROW(invalidRange.get(), std::logic_error);
+	EXPECT_EQ(archive.created, std::vector<size_t>{0});
+}
@@ -0,0 +1,222 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include <gtest/gtest.h>
+
+#include "src/common/mappedfile.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/awepackarchive.h"
+#include "src/awe/awepackwriter.h"
+#include "src/awe/binarchive.h"
+#include "src/awe/resman.h"
+
+static void writeFile(const std::filesystem::path &path, const std::string &content) {
+	std::filesystem::create_directories(path.parent_path());
+	std::ofstream(path, std::ios::binary) << content;
+}
+
+static std::string readResource(const std::string &path) {
+	std::unique_ptr<Common::ReadStream> stream(ResMan.getResource(path));
+	if (!stream)
+		return "";
+	return stream->readFixedSizeString(stream->size());
+}
+
+/*!
+ * Create a bin archive containing a single file
+ */
+static std::vector<byte> createBIN(const std::string &name, const std::string &content) {
+	Common::DynamicMemoryWriteStream bin(true);
+	bin.writeUint32LE(1);
+	bin.writeUint32LE(name.size());
+	bin.writeString(name);
+	bin.writeUint32LE(content.size());
+
+	uLongf compressedSize = compressBound(content.size());
+	std::vector<byte> compressed(compressedSize);
+	EXPECT_EQ(
+		compress(compressed.data(), &compressedSize, reinterpret_cast<const Bytef *>(content.data()), content.size()),
+		Z_OK
+	);
+	bin.write(compressed.data(), compressedSize);
+
+	return {bin.getData(), bin.getData() + bin.getLength()};
+}
+
+TEST(RessourceManager, cacheBINArchiveFromMappedArchive) {
+	const std::string packFile = std::tmpnam(nullptr);
+	const std::string content = "The bin archive is only inflated once";
+
+	AWE::AWEPackWriter writer(packFile);
+	writer.add("resmantest/cache.bin", createBIN("content.txt", content), false);
+	writer.finish();
+
+	// The pack file is mapped and stores the bin archive uncompressed, so the plain resource is not cached
+	ASSERT_TRUE(AWE::AWEPackArchive(new Common::MappedFile(packFile)).isMemoryBacked());
+
+	ResMan.indexArchive(packFile);
+	ResMan.setCacheBudget(1024 * 1024);
+
+	const auto statistics = ResMan.getCacheStatistics();
+
+	const auto first = ResMan.getBINArchive("resmantest/cache.bin");
+	ASSERT_TRUE(first);
+	std::unique_ptr<Common::ReadStream> stream(first->getResource("content.txt"));
+	ASSERT_TRUE(stream);
+	EXPECT_EQ(stream->readFixedSizeString(content.size()), content);
+
+	const auto second = ResMan.getBINArchive("resmantest/cache.bin");
+	EXPECT_EQ(second, first);
+
+	const auto hitStatistics = ResMan.getCacheStatistics();
+	EXPECT_EQ(hitStatistics.hits, statistics.hits + 1);
+	EXPECT_EQ(hitStatistics.misses, statistics.misses + 1);
+	EXPECT_EQ(hitStatistics.entries, statistics.entries + 1);
+	EXPECT_EQ(hitStatistics.size, statistics.size + content.size());
+
+	EXPECT_FALSE(ResMan.getBINArchive("resmantest/missing.bin"));
+
+	ResMan.setCacheBudget(0);
+	std::filesystem::remove(packFile);
+}
+
+TEST(RessourceManager, looseFilePrecedence) {
+	const std::filesystem::path rootPath = std::tmpnam(nullptr);
+	const std::filesystem::path extraPath = std::tmpnam(nullptr);
+	const std::string packFile = std::tmpnam(nullptr);
+
+	writeFile(rootPath / "precedence/a.txt", "root");
+	writeFile(rootPath / "precedence/b.txt", "root");
+	writeFile(extraPath / "precedence/a.txt", "extra");
+	writeFile(extraPath / "precedence/c.txt", "extra");
+
+	const std::string archiveContent = "archive";
+	const std::vector<byte> archiveData(archiveContent.begin(), archiveContent.end());
+	AWE::AWEPackWriter writer(packFile);
+	writer.add("precedence/a.txt", archiveData, false);
+	writer.add("precedence/c.txt", archiveData, false);
+	writer.add("precedence/d.txt", archiveData, false);
+	writer.finish();
+
+	ResMan.indexArchive(packFile);
+	ResMan.setRootPath(rootPath.string());
+	ResMan.addPath(extraPath.string());
+
+	// The root path takes precedence over additional paths, which take precedence over archives
+	EXPECT_EQ(readResource("precedence/a.txt"), "root");
+	EXPECT_EQ(readResource("precedence/b.txt"), "root");
+	EXPECT_EQ(readResource("precedence/c.txt"), "extra");
+	EXPECT_EQ(readResource("precedence/d.txt"), "archive");
+	EXPECT_TRUE(ResMan.hasDirectory("precedence"));
+
+	// Loose files are found with paths which are not normalized
+	EXPECT_EQ(readResource("./precedence//a.txt"), "root");
+	EXPECT_EQ(readResource("/precedence/a.txt"), "root");
+	EXPECT_TRUE(ResMan.hasResource("precedence/./b.txt"));
+	EXPECT_TRUE(ResMan.hasDirectory("precedence/"));
+
+	// New files are only found after rescanning
+	writeFile(rootPath / "precedence/d.txt", "root");
+	EXPECT_EQ(readResource("precedence/d.txt"), "archive");
+	ResMan.rescanLooseFiles();
+	EXPECT_EQ(readResource("precedence/d.txt"), "root");
+
+	std::filesystem::remove_all(rootPath);
+	std::filesystem::remove_all(extraPath);
+	std::filesystem::remove(packFile);
+
+	ResMan.setRootPath("");
+	EXPECT_FALSE(ResMan.hasResource("precedence/b.txt"));
+	EXPECT_EQ(readResource("precedence/a.txt"), "archive");
+}
+
+TEST(RessourceManager, recordAndReplayTrace) {
+	const std::filesystem::path traceDirectory = std::tmpnam(nullptr);
+	const std::string packFile = std::tmpnam(nullptr);
+	std::filesystem::create_directories(traceDirectory);
+
+	const std::string content = "trace";
+	const std::vector<byte> data(content.begin(), content.end());
+	AWE::AWEPackWriter writer(packFile);
+	writer.add("tracetest/a b.txt", data, false);
+	writer.add("tracetest/c.txt", data, false);
+	writer.finish();
+
+	ResMan.indexArchive(packFile);
+
+	// Every resource is recorded once together with its range in the pack
+	ResMan.setTraceMode(AWE::RessourceManager::kTraceRecord, traceDirectory.string());
+	ResMan.beginSession("trace/test");
+	EXPECT_EQ(readResource("tracetest/a b.txt"), content);
+	EXPECT_EQ(readResource("tracetest/c.txt"), content);
+	EXPECT_EQ(readResource("tracetest/a b.txt"), content);
+	ResMan.endSession();
+
+	const std::filesystem::path traceFile = traceDirectory / "trace_test.trace";
+	std::vector<std::string> lines;
+	{
+		std::ifstream in(traceFile);
+		std::string line;
+		while (std::getline(in, line))
+			lines.emplace_back(line);
+	}
+	ASSERT_EQ(lines.size(), 2);
+	EXPECT_TRUE(lines[0].ends_with(" tracetest/a b.txt"));
+	EXPECT_TRUE(lines[1].ends_with(" tracetest/c.txt"));
+
+	// Move the second entry and add entries which are missing or cannot be parsed
+	size_t offset, size;
+	std::istringstream(lines[1]) >> offset >> size;
+	{
+		std::ofstream out(traceFile, std::ios::trunc);
+		out << lines[0] << "\n";
+		out << (offset + 1) << " " << size << " tracetest/c.txt\n";
+		out << "0 5 tracetest/missing.txt\n";
+		out << "garbage line\n";
+		out << "12\n";
+		out << "0 5 \n";
+	}
+
+	ResMan.setTraceMode(AWE::RessourceManager::kTraceReplay, traceDirectory.string());
+	ResMan.beginSession("trace/test");
+	const auto statistics = ResMan.getTraceStatistics();
+	EXPECT_EQ(statistics.prefetched, 1);
+	EXPECT_EQ(statistics.stale, 2);
+	ResMan.endSession();
+
+	// Sessions without a trace do not prefetch anything
+	ResMan.beginSession("trace/missing");
+	EXPECT_EQ(ResMan.getTraceStatistics().prefetched, 0);
+	ResMan.endSession();
+
+	ResMan.setTraceMode(AWE::RessourceManager::kTraceDisabled, "");
+	std::filesystem::remove_all(traceDirectory);
+	std::filesystem::remove(packFile);
+}
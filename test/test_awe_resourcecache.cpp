@@ -0,0 +1,161 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memreadstream.h"
+
+#include "src/awe/binarchive.h"
+#include "src/awe/resourcecache.h"
+
+static AWE::ResourceCache::Entry insertBytes(AWE::ResourceCache &cache, const std::string &key, size_t size) {
+	std::string data(size, key[0]);
+	Common::MemoryReadStream stream(data.data(), data.size());
+	return cache.insert(key, stream);
+}
+
+TEST(ResourceCache, hitsAndMisses) {
+	AWE::ResourceCache cache(1024);
+
+	EXPECT_FALSE(cache.find("a"));
+	const auto inserted = insertBytes(cache, "a", 100);
+	ASSERT_EQ(inserted.size, 100);
+	EXPECT_EQ(inserted.data[99], 'a');
+
+	const auto found = cache.find("a");
+	ASSERT_TRUE(found);
+	EXPECT_EQ(found->data, inserted.data);
+	EXPECT_EQ(found->size, 100);
+
+	const auto statistics = cache.getStatistics();
+	EXPECT_EQ(statistics.hits, 1);
+	EXPECT_EQ(statistics.misses, 1);
+	EXPECT_EQ(statistics.evictions, 0);
+	EXPECT_EQ(statistics.entries, 1);
+	EXPECT_EQ(statistics.size, 100);
+}
+
+TEST(ResourceCache, evictLeastRecentlyUsed) {
+	AWE::ResourceCache cache(300);
+
+	insertBytes(cache, "a", 100);
+	insertBytes(cache, "b", 100);
+	insertBytes(cache, "c", 100);
+
+	// Use a and c, so that b is the least recently used entry
+	const auto evicted = cache.find("b");
+	ASSERT_TRUE(evicted);
+	EXPECT_TRUE(cache.find("a"));
+	EXPECT_TRUE(cache.find("c"));
+
+	insertBytes(cache, "d", 100);
+	EXPECT_FALSE(cache.find("b"));
+	EXPECT_TRUE(cache.find("a"));
+	EXPECT_TRUE(cache.find("c"));
+	EXPECT_TRUE(cache.find("d"));
+	EXPECT_EQ(cache.getStatistics().evictions, 1);
+	EXPECT_EQ(cache.getStatistics().size, 300);
+
+	// Evicted buffers stay valid while they are in use
+	EXPECT_EQ(evicted->data[0], 'b');
+
+	// Resources larger than the budget are handed out, but not cached
+	const auto large = insertBytes(cache, "e", 400);
+	EXPECT_EQ(large.size, 400);
+	EXPECT_FALSE(cache.find("e"));
+	EXPECT_EQ(cache.getStatistics().entries, 3);
+
+	// Shrinking the budget keeps only the most recently used entries
+	cache.setBudget(100);
+	EXPECT_EQ(cache.getStatistics().entries, 1);
+	EXPECT_EQ(cache.getStatistics().size, 100);
+	EXPECT_TRUE(cache.find("d"));
+
+	cache.setBudget(0);
+	EXPECT_FALSE(cache.isEnabled());
+}
+
+/*!
+ * A stream which claims to be larger than the data it actually delivers
+ */
+class TruncatedReadStream : public Common::ReadStream {
+public:
+	size_t read(void *data, size_t length) override {
+		const size_t readLength = std::min(length, kAvailable - _pos);
+		std::memset(data, 'x', readLength);
+		_pos += readLength;
+		return readLength;
+	}
+
+	void seek(ptrdiff_t length, SeekOrigin origin) override {
+		_pos = origin == BEGIN ? length : (origin == CURRENT ? _pos + length : size() + length);
+	}
+
+	size_t pos() const override { return _pos; }
+	bool eos() const override { return _pos >= kAvailable; }
+	size_t size() const override { return 100; }
+
+private:
+	static const size_t kAvailable = 50;
+	size_t _pos{0};
+};
+
+TEST(ResourceCache, shortRead) {
+	AWE::ResourceCache cache(1024);
+
+	TruncatedReadStream stream;
+	EXPECT_THROW(cache.insert("a", stream), std::exception);
+	EXPECT_FALSE(cache.find("a"));
+	EXPECT_EQ(cache.getStatistics().size, 0);
+}
+
+TEST(ResourceCache, archives) {
+	static const byte kEmptyBin[] = {
+		0x00, 0x00, 0x00, 0x00, 0x78, 0x9c, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01
+	};
+
+	AWE::ResourceCache cache(300);
+
+	Common::MemoryReadStream bin(kEmptyBin, sizeof(kEmptyBin));
+	const auto archive = std::make_shared<AWE::BINArchive>(bin);
+
+	// Archives and resource data use separate keys, but share the budget
+	EXPECT_FALSE(cache.findArchive("a"));
+	insertBytes(cache, "a", 100);
+	EXPECT_FALSE(cache.findArchive("a"));
+	cache.insertArchive("a", archive, 200);
+	EXPECT_EQ(cache.findArchive("a"), archive);
+	EXPECT_TRUE(cache.find("a"));
+	EXPECT_EQ(cache.getStatistics().entries, 2);
+	EXPECT_EQ(cache.getStatistics().size, 300);
+
+	// The archive is the least recently used entry now
+	insertBytes(cache, "b", 100);
+	EXPECT_FALSE(cache.findArchive("a"));
+	EXPECT_TRUE(cache.find("a"));
+	EXPECT_EQ(cache.getStatistics().evictions, 1);
+
+	cache.insertArchive("c", archive, 400);
+	EXPECT_FALSE(cache.findArchive("c"));
+}
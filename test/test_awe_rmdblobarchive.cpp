@@ -0,0 +1,311 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if WITH_LZ4
+
+#include <cstring>
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memreadstream.h"
+#include "src/common/memwritestream.h"
+#include "src/common/readfile.h"
+
+#include "src/awe/rmdblobarchive.h"
+
+/*!
+ * Encode data as a lz4 block only consisting of literals, which is a valid
+ * lz4 block without needing a compressor
+ */
+static std::vector<byte> encodeLZ4Literals(const std::vector<byte> &data) {
+	std::vector<byte> block;
+	if (data.size() < 15) {
+		block.emplace_back(data.size() << 4);
+	} else {
+		block.emplace_back(0xF0);
+		size_t length = data.size() - 15;
+		while (length >= 255) {
+			block.emplace_back(255);
+			length -= 255;
+		}
+		block.emplace_back(length);
+	}
+	block.insert(block.end(), data.begin(), data.end());
+	return block;
+}
+
+static std::vector<byte> createChunk(size_t size, byte seed) {
+	std::vector<byte> chunk(size);
+	for (size_t i = 0; i < size; ++i)
+		chunk[i] = static_cast<byte>(i * 7 + seed);
+	return chunk;
+}
+
+class RMDBlobArchive : public testing::Test {
+protected:
+	void SetUp() override {
+		_directory = std::tmpnam(nullptr);
+		std::filesystem::create_directories(_directory);
+
+		// Create the blob file containing alternating compressed and uncompressed chunks
+		Common::DynamicMemoryWriteStream blob(true);
+		Common::DynamicMemoryWriteStream compressionTable(true);
+		for (byte i = 0; i < 8; ++i) {
+			const auto chunk = createChunk(1000 + i, i);
+			_file1.insert(_file1.end(), chunk.begin(), chunk.end());
+
+			const auto data = i % 2 == 0 ? encodeLZ4Literals(chunk) : chunk;
+			compressionTable.writeByte(i % 2 == 0 ? 16 : 0);
+			compressionTable.writeByte(0);
+			compressionTable.writeZeros(1);
+			compressionTable.writeUint32LE(blob.getLength());
+			compressionTable.writeByte(0);
+			compressionTable.writeUint32LE(chunk.size());
+			compressionTable.writeUint32LE(data.size());
+			blob.write(data.data(), data.size());
+		}
+
+		_file2 = createChunk(200, 42);
+		compressionTable.writeByte(0);
+		compressionTable.writeByte(0);
+		compressionTable.writeZeros(1);
+		compressionTable.writeUint32LE(blob.getLength());
+		compressionTable.writeByte(0);
+		compressionTable.writeUint32LE(_file2.size());
+		compressionTable.writeUint32LE(_file2.size());
+		blob.write(_file2.data(), _file2.size());
+
+		std::ofstream(_directory + "/test.rmdblob", std::ios::binary)
+			.write(reinterpret_cast<char *>(blob.getData()), blob.getLength());
+
+		const std::string names = "data/test.rmdblobfolderfile1.binfile2.bin";
+
+		// Create the uncompressed toc with one blob, the root folder, one sub folder and two files
+		Common::DynamicMemoryWriteStream toc(true);
+		toc.writeUint32LE(0);
+		toc.writeUint32LE(17);
+		toc.writeZeros(8);
+
+		const auto folderTableOffset = toc.getLength();
+		for (const auto value : {0, 1, 1, 0, 0, 0, 0})
+			toc.writeUint32LE(value);
+		for (const auto value : {1, 0, 0, 0, 2, 17, 6})
+			toc.writeUint32LE(value);
+
+		const auto fileTableOffset = toc.getLength();
+		for (const auto value : {0u, 128u, 0u, 23u, 9u, static_cast<unsigned int>(_file1.size()), 0u, 0u})
+			toc.writeUint32LE(value);
+		for (const auto value : {128u, 16u, 1u, 32u, 9u, static_cast<unsigned int>(_file2.size()), 0u, 0u})
+			toc.writeUint32LE(value);
+
+		const auto nameTableOffset = toc.getLength();
+		toc.writeString(names);
+
+		const auto compressionTableOffset = toc.getLength();
+		toc.write(compressionTable.getData(), compressionTable.getLength());
+
+		const std::vector<byte> tocData(toc.getData(), toc.getData() + toc.getLength());
+		const auto compressedToc = encodeLZ4Literals(tocData);
+
+		Common::DynamicMemoryWriteStream rmdtoc(true);
+		rmdtoc.writeUint32LE(MKTAG('R', 'T', 'O', 'C'));
+		rmdtoc.writeUint32LE(2);
+		rmdtoc.writeUint32LE(88);
+		rmdtoc.writeUint32LE(16);
+		rmdtoc.writeUint32LE(0);
+		rmdtoc.writeUint32LE(1);
+		rmdtoc.writeUint32LE(folderTableOffset);
+		rmdtoc.writeUint32LE(2);
+		rmdtoc.writeUint32LE(fileTableOffset);
+		rmdtoc.writeUint32LE(2);
+		rmdtoc.writeUint32LE(nameTableOffset);
+		rmdtoc.writeUint32LE(names.size());
+		rmdtoc.writeZeros(32);
+		rmdtoc.writeUint32LE(compressionTableOffset);
+		rmdtoc.writeUint32LE(compressionTable.getLength());
+
+		rmdtoc.writeByte(16);
+		rmdtoc.writeZeros(2);
+		rmdtoc.writeUint32LE(104);
+		rmdtoc.writeZeros(1);
+		rmdtoc.writeUint32LE(tocData.size());
+		rmdtoc.writeUint32LE(compressedToc.size());
+		rmdtoc.write(compressedToc.data(), compressedToc.size());
+
+		_rmdtoc.assign(rmdtoc.getData(), rmdtoc.getData() + rmdtoc.getLength());
+
+		// The toc is stored as literals, so the folder table can be patched directly in the rmdtoc data
+		_folderTableOffset = 104 + (compressedToc.size() - tocData.size()) + folderTableOffset;
+	}
+
+	void patchFolder(size_t index, const std::vector<uint32_t> &values) {
+		std::memcpy(
+			_rmdtoc.data() + _folderTableOffset + index * 7 * sizeof(uint32_t),
+			values.data(),
+			values.size() * sizeof(uint32_t)
+		);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(_directory);
+	}
+
+	void checkArchive(AWE::RMDBlobArchive &archive) {
+		ASSERT_EQ(archive.getNumResources(), 2);
+		EXPECT_EQ(archive.getResourcePath(0), "folder/file1.bin");
+		EXPECT_EQ(archive.getResourcePath(1), "folder/file2.bin");
+
+		EXPECT_TRUE(archive.hasDirectory("folder"));
+		EXPECT_FALSE(archive.hasDirectory("file"));
+		EXPECT_TRUE(archive.hasResource("folder/file1.bin"));
+		EXPECT_TRUE(archive.hasResource("folder/file2.bin"));
+		EXPECT_FALSE(archive.hasResource("folder/file3.bin"));
+		EXPECT_EQ(archive.getDirectoryResources("folder"), std::vector<size_t>({0, 1}));
+
+		EXPECT_EQ(archive.getResource("folder/file3.bin"), nullptr);
+
+		std::unique_ptr<Common::ReadStream> file1(archive.getResource("folder/file1.bin"));
+		ASSERT_TRUE(file1);
+		ASSERT_EQ(file1->size(), _file1.size());
+		std::vector<byte> data1(file1->size());
+		file1->read(data1.data(), data1.size());
+		EXPECT_EQ(data1, _file1);
+
+		std::unique_ptr<Common::ReadStream> file2(archive.getResource("folder/file2.bin"));
+		ASSERT_TRUE(file2);
+		ASSERT_EQ(file2->size(), _file2.size());
+		std::vector<byte> data2(file2->size());
+		file2->read(data2.data(), data2.size());
+		EXPECT_EQ(data2, _file2);
+
+		EXPECT_EQ(archive.getResourceByIndex(2), nullptr);
+
+		std::unique_ptr<Common::ReadStream> file1ByIndex(archive.getResourceByIndex(0));
+		ASSERT_TRUE(file1ByIndex);
+		ASSERT_EQ(file1ByIndex->size(), _file1.size());
+		std::vector<byte> data1ByIndex(file1ByIndex->size());
+		file1ByIndex->read(data1ByIndex.data(), data1ByIndex.size());
+		EXPECT_EQ(data1ByIndex, _file1);
+	}
+
+	std::string _directory;
+	std::vector<byte> _rmdtoc, _file1, _file2;
+	size_t _folderTableOffset;
+};
+
+TEST_F(RMDBlobArchive, readResources) {
+	Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+	AWE::RMDBlobArchive archive(rmdtoc, _directory);
+	checkArchive(archive);
+}
+
+TEST_F(RMDBlobArchive, tocCache) {
+	const std::string cacheFile = _directory + "/test.rmdtoc.cache";
+
+	{
+		Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+		AWE::RMDBlobArchive archive(rmdtoc, _directory, cacheFile);
+		checkArchive(archive);
+	}
+
+	ASSERT_TRUE(std::filesystem::is_regular_file(cacheFile));
+	const auto cacheSize = std::filesystem::file_size(cacheFile);
+
+	// Load the archive from the cache
+	{
+		Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+		AWE::RMDBlobArchive archive(rmdtoc, _directory, cacheFile);
+		checkArchive(archive);
+	}
+
+	// A corrupted cache has to be ignored and rebuilt
+	std::filesystem::resize_file(cacheFile, cacheSize / 2);
+	{
+		Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+		AWE::RMDBlobArchive archive(rmdtoc, _directory, cacheFile);
+		checkArchive(archive);
+	}
+	EXPECT_EQ(std::filesystem::file_size(cacheFile), cacheSize);
+
+	// A cache of a different rmdtoc file has to be ignored and rebuilt
+	std::vector<byte> changedRMDToc = _rmdtoc;
+	changedRMDToc.emplace_back(0);
+	{
+		Common::MemoryReadStream rmdtoc(changedRMDToc.data(), changedRMDToc.size(), false);
+		AWE::RMDBlobArchive archive(rmdtoc, _directory, cacheFile);
+		checkArchive(archive);
+	}
+	EXPECT_EQ(std::filesystem::file_size(cacheFile), cacheSize);
+}
+
+TEST_F(RMDBlobArchive, tocCacheFile) {
+	const std::string rmdtocFile = _directory + "/test.rmdtoc";
+	const std::string cacheFile = _directory + "/test.rmdtoc.cache";
+
+	std::ofstream(rmdtocFile, std::ios::binary)
+		.write(reinterpret_cast<char *>(_rmdtoc.data()), _rmdtoc.size());
+	const auto rmdtocTime = std::filesystem::last_write_time(rmdtocFile);
+
+	{
+		AWE::RMDBlobArchive archive(rmdtocFile, cacheFile);
+		checkArchive(archive);
+	}
+	ASSERT_TRUE(std::filesystem::is_regular_file(cacheFile));
+
+	// Replace the rmdtoc file with garbage while keeping its size and modification time, only the cache can
+	// provide the tables now, since the rmdtoc file is not read when size and modification time match
+	const std::vector<byte> garbage(_rmdtoc.size(), 0);
+	std::ofstream(rmdtocFile, std::ios::binary)
+		.write(reinterpret_cast<const char *>(garbage.data()), garbage.size());
+	std::filesystem::last_write_time(rmdtocFile, rmdtocTime);
+
+	{
+		AWE::RMDBlobArchive archive(rmdtocFile, cacheFile);
+		checkArchive(archive);
+	}
+
+	// Verifying the hash detects the changed contents and tries to parse the garbage
+	EXPECT_ANY_THROW(AWE::RMDBlobArchive(rmdtocFile, cacheFile, true));
+
+	// A changed modification time invalidates the cache as well
+	std::filesystem::last_write_time(rmdtocFile, rmdtocTime + std::chrono::seconds(1));
+	EXPECT_ANY_THROW(AWE::RMDBlobArchive(rmdtocFile, cacheFile));
+}
+
+TEST_F(RMDBlobArchive, cyclicDirectories) {
+	// Let the sub folder be its own parent
+	patchFolder(1, {1, 1, 1});
+
+	Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+	EXPECT_ANY_THROW(AWE::RMDBlobArchive(rmdtoc, _directory));
+}
+
+TEST_F(RMDBlobArchive, rootAsChildDirectory) {
+	// Let the root folder list itself as its sub folder
+	patchFolder(0, {0, 0, 1});
+
+	Common::MemoryReadStream rmdtoc(_rmdtoc.data(), _rmdtoc.size(), false);
+	EXPECT_ANY_THROW(AWE::RMDBlobArchive(rmdtoc, _directory));
+}
+
+#endif // WITH_LZ4
@@ -18,9 +18,17 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+
 #include <gtest/gtest.h>
 
 #include "src/common/memreadstream.h"
+#include "src/common/readfile.h"
+#include "src/common/crc32.h"
+#include "src/common/strutil.h"
 
 #include "src/awe/rmdparchive.h"
 
@@ -2057,3 +2065,128 @@ TEST(RMDPArchive, MultipleFilesArchiveV8) {
 	EXPECT_STREQ(test3Text.c_str(), kLipsum);
 }
 
+TEST(RMDPArchive, ConcurrentReadsV2) {
+	const std::string filename = std::tmpnam(nullptr);
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	out.write(reinterpret_cast<const char *>(kMultipleFilesRmdpV2), sizeof(kMultipleFilesRmdpV2));
+	out.close();
+
+	Common::ReadStream *bin = new Common::MemoryReadStream(
+		kMultipleFilesBinV2,
+		sizeof(kMultipleFilesBinV2),
+		false
+	);
+	Common::ReadStream *rmdp = new Common::ReadFile(filename);
+	ASSERT_TRUE(rmdp->isConcurrent());
+
+	AWE::RMDPArchive rmdpArchive(bin, rmdp);
+
+	const std::vector<std::string> paths = {
+		"test.txt",
+		"test2.txt",
+		"test3.txt",
+		"upper_test_folder/lower_test_folder/test.txt",
+		"upper_test_folder/lower_test_folder/test2.txt",
+		"upper_test_folder/lower_test_folder/test3.txt",
+	};
+
+	// Get the reference checksums with a single sequential read
+	std::vector<uint32_t> checksums;
+	for (const auto &path : paths) {
+		std::unique_ptr<Common::ReadStream> stream(rmdpArchive.getResource(path));
+		ASSERT_TRUE(stream);
+
+		std::vector<byte> data(stream->size());
+		stream->read(data.data(), data.size());
+		checksums.emplace_back(Common::crc32(data.data(), data.size()));
+	}
+
+	// Read the resources from a fixed number of threads and compare the checksums
+	constexpr unsigned int kNumThreads = 4;
+	constexpr unsigned int kIterations = 100;
+	std::atomic_uint failures(0);
+
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < kNumThreads; ++t) {
+		threads.emplace_back([&, t]() {
+			for (unsigned int i = 0; i < kIterations; ++i) {
+				const size_t index = (i + t) % paths.size();
+				std::unique_ptr<Common::ReadStream> stream(rmdpArchive.getResource(paths[index]));
+				if (!stream) {
+					failures++;
+					continue;
+				}
+
+				std::vector<byte> data(stream->size());
+				if (stream->read(data.data(), data.size()) != data.size() || Common::crc32(data.data(), data.size()) != checksums[index])
+					failures++;
+			}
+		});
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+
+	EXPECT_EQ(failures.load(), 0);
+
+	std::filesystem::remove(filename);
+}
+
+static void testPathIndex(byte *binData, size_t binSize, const byte *rmdpData, size_t rmdpSize) {
+	Common::ReadStream *bin = new Common::MemoryReadStream(binData, binSize, false);
+	Common::ReadStream *rmdp = new Common::MemoryReadStream(rmdpData, rmdpSize);
+
+	AWE::RMDPArchive rmdpArchive(bin, rmdp);
+
+	for (size_t i = 0; i < rmdpArchive.getNumResources(); ++i) {
+		const std::string path = Common::toLower(rmdpArchive.getResourcePath(i));
+
+		const auto index = rmdpArchive.findResource(path);
+		const auto treeIndex = rmdpArchive.findResourceInTree(path);
+
+		ASSERT_TRUE(index);
+		ASSERT_TRUE(treeIndex);
+		EXPECT_EQ(*index, *treeIndex);
+		EXPECT_EQ(Common::toLower(rmdpArchive.getResourcePath(*index)), path);
+	}
+
+	for (const auto &path : {"test4.txt", "upper_test_folder", "upper_test_folder/test.txt", "", "/"}) {
+		EXPECT_FALSE(rmdpArchive.findResource(path));
+		EXPECT_FALSE(rmdpArchive.findResourceInTree(path));
+	}
+}
+
+TEST(RMDPArchive, PathIndex) {
+	testPathIndex(kMultipleFilesBinV2, sizeof(kMultipleFilesBinV2), kMultipleFilesRmdpV2, sizeof(kMultipleFilesRmdpV2));
+	testPathIndex(kMultipleFilesBinV2AWR, sizeof(kMultipleFilesBinV2AWR), kMultipleFilesRmdpV2AWR, sizeof(kMultipleFilesRmdpV2AWR));
+	testPathIndex(kMultipleFilesBinV7, sizeof(kMultipleFilesBinV7), kMultipleFilesRmdpV7, sizeof(kMultipleFilesRmdpV7));
+	testPathIndex(kMultipleFilesBinV8, sizeof(kMultipleFilesBinV8), kMultipleFilesRmdpV8, sizeof(kMultipleFilesRmdpV8));
+}
+
+TEST(RMDPArchive, VerifyData) {
+	std::vector<byte> rmdpData(kMultipleFilesRmdpV8, kMultipleFilesRmdpV8 + sizeof(kMultipleFilesRmdpV8));
+
+	AWE::RMDPArchive rmdpArchive(
+		new Common::MemoryReadStream(kMultipleFilesBinV8, sizeof(kMultipleFilesBinV8), false),
+		new Common::MemoryReadStream(rmdpData.data(), rmdpData.size(), false)
+	);
+	rmdpArchive.setVerifyData(true);
+
+	for (size_t i = 0; i < rmdpArchive.getNumResources(); ++i) {
+		std::unique_ptr<Common::ReadStream> resource(rmdpArchive.getResourceByIndex(i));
+		EXPECT_TRUE(resource);
+	}
+
+	// Corrupt the data of the first resource
+	const auto range = rmdpArchive.getResourceRange(0);
+	ASSERT_TRUE(range);
+	ASSERT_GT(range->size, 0);
+	rmdpData[range->offset] ^= 0xFF;
+
+	EXPECT_THROW(std::unique_ptr<Common::ReadStream>(rmdpArchive.getResourceByIndex(0)), std::exception);
+
+	// Without verification the data is handed out unchecked
+	rmdpArchive.setVerifyData(false);
+	std::unique_ptr<Common::ReadStream> resource(rmdpArchive.getResourceByIndex(0));
+	EXPECT_TRUE(resource);
+}
@@ -20,6 +20,7 @@
 
 #include <gtest/gtest.h>
 #include <bitset>
+#include <vector>
 
 #include "src/common/memreadstream.h"
 #include "src/common/bitstream.h"
@@ -255,3 +256,125 @@ TEST(BitStream, readBits_32LELSB) {
 	EXPECT_EQ(bits.read(2), 2);
 }
 
+
+/*!
+ * The previous bit by bit implementation of the bitstream, used as reference
+ * for the cache based implementation
+ */
+template<typename T, bool le, bool msb>
+class ReferenceBitStream {
+public:
+	explicit ReferenceBitStream(Common::ReadStream &bits) : _curValue(0), _remainingBits(0), _bits(bits) {}
+
+	uint32_t read(size_t n) {
+		uint32_t newValue = 0;
+		if constexpr (msb)
+			for (size_t i = 0; i < n; ++i) {
+				newValue = (read() ? 1 : 0) | (newValue << 1);
+			}
+		else
+			for (size_t i = 0; i < n; ++i) {
+				newValue |= (read() ? 1u : 0u) << i;
+			}
+
+		return newValue;
+	}
+
+	bool read() {
+		if (_remainingBits == 0) {
+			_curValue = _bits.read<T>();
+			if constexpr (!le && sizeof(T) > 1 && std::endian::native == std::endian::little)
+				_curValue = Common::swapBytes(_curValue);
+			if constexpr (le && sizeof(T) > 1 && std::endian::native == std::endian::big)
+				_curValue = Common::swapBytes(_curValue);
+			_remainingBits = sizeof(T) * 8;
+		}
+
+		bool value;
+		if constexpr (msb) {
+			value = _curValue & (T(1) << (sizeof(T) * 8 - 1));
+			_curValue <<= 1;
+		} else {
+			value = _curValue & 1;
+			_curValue >>= 1;
+		}
+
+		_remainingBits--;
+		return value;
+	}
+
+private:
+	T _curValue;
+	unsigned short _remainingBits;
+	Common::ReadStream &_bits;
+};
+
+template<typename T, bool le, bool msb>
+static void testEquivalence() {
+	std::vector<uint8_t> data(1024);
+	uint32_t state = 0x12345678;
+	for (auto &byte : data) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		byte = state;
+	}
+
+	// Every read width at every bit offset of a value
+	for (size_t offset = 0; offset < 64; ++offset) {
+		for (size_t n = 0; n <= 32; ++n) {
+			Common::MemoryReadStream testStream(data.data(), data.size(), false);
+			Common::MemoryReadStream referenceStream(data.data(), data.size(), false);
+			Common::BitStream<T, le, msb> bits(testStream);
+			ReferenceBitStream<T, le, msb> referenceBits(referenceStream);
+
+			bits.skip(offset);
+			referenceBits.read(offset);
+			ASSERT_EQ(bits.read(n), referenceBits.read(n)) << "at offset " << offset << " with " << n << " bits";
+			ASSERT_EQ(testStream.pos(), referenceStream.pos()) << "at offset " << offset << " with " << n << " bits";
+		}
+	}
+
+	// A long sequence of mixed reads
+	Common::MemoryReadStream testStream(data.data(), data.size(), false);
+	Common::MemoryReadStream referenceStream(data.data(), data.size(), false);
+	Common::BitStream<T, le, msb> bits(testStream);
+	ReferenceBitStream<T, le, msb> referenceBits(referenceStream);
+
+	size_t remaining = (data.size() - sizeof(T)) * 8;
+	while (remaining > 33) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		if (state % 5 == 0) {
+			ASSERT_EQ(bits.read(), referenceBits.read());
+			remaining -= 1;
+		} else {
+			const size_t n = state % 33;
+			ASSERT_EQ(bits.read(n), referenceBits.read(n));
+			remaining -= n;
+		}
+		ASSERT_EQ(testStream.pos(), referenceStream.pos());
+	}
+}
+
+TEST(BitStream, equivalence) {
+	testEquivalence<uint8_t, false, true>();
+	testEquivalence<uint8_t, false, false>();
+
+	testEquivalence<uint16_t, true, true>();
+	testEquivalence<uint16_t, true, false>();
+	testEquivalence<uint16_t, false, true>();
+	testEquivalence<uint16_t, false, false>();
+
+	testEquivalence<uint32_t, true, true>();
+	testEquivalence<uint32_t, true, false>();
+	testEquivalence<uint32_t, false, true>();
+	testEquivalence<uint32_t, false, false>();
+
+	testEquivalence<uint64_t, true, true>();
+	testEquivalence<uint64_t, true, false>();
+	testEquivalence<uint64_t, false, true>();
+	testEquivalence<uint64_t, false, false>();
+}
@@ -20,6 +20,7 @@
 
 #include <string>
 #include <cstring>
+#include <vector>
 
 /*
  * All tested values need to be compatible with zlibs crc32 implementation
@@ -56,3 +57,46 @@ TEST(CRC32, complexValues) {
 
 	EXPECT_EQ(Common::crc32(kLipsum), testHashLipsum);
 }
+
+static_assert(Common::crc32("Hello World!") == 0x1C291CA3, "crc32 has to be usable at compile time");
+
+TEST(CRC32, runtimeLengthsAndAlignments) {
+	std::vector<byte> data(1024 + 16);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<byte>(i * 131 + 7);
+
+	// Cover the table lookup, slice-by-8 and folding paths with unaligned starts and remainders
+	for (size_t offset = 0; offset < 16; ++offset) {
+		for (size_t length = 0; length <= 1024; length += (length < 300 ? 1 : 61)) {
+			const byte *start = data.data() + offset;
+			const auto expected = ::crc32(0, start, length);
+
+			EXPECT_EQ(Common::crc32Runtime(start, length), expected) << "offset " << offset << " length " << length;
+			EXPECT_EQ(Common::crc32(start, length), expected) << "offset " << offset << " length " << length;
+		}
+	}
+}
+
+TEST(CRC32, runtimeIncremental) {
+	const auto *lipsum = reinterpret_cast<const byte *>(kLipsum);
+	const size_t length = std::strlen(kLipsum);
+
+	for (size_t split = 0; split <= length; split += 37) {
+		const auto first = Common::crc32Runtime(lipsum, split);
+		EXPECT_EQ(Common::crc32Runtime(lipsum + split, length - split, first), ::crc32(0, lipsum, length));
+	}
+}
+
+TEST(CRC32, matchesTableLookup) {
+	// Use an odd size, so that the folded blocks and the remaining tail are both covered
+	std::vector<byte> data(64 * 1024 + 13);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<byte>(i ^ (i >> 8));
+
+	uint32_t tableHash = 0xFFFFFFFF;
+	for (const byte value : data)
+		tableHash = Common::kCRC32Table[(tableHash ^ value) & 0xFF] ^ (tableHash >> 8);
+	tableHash ^= 0xFFFFFFFF;
+
+	EXPECT_EQ(Common::crc32Runtime(data.data(), data.size()), tableHash);
+}
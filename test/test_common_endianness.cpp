@@ -19,6 +19,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -43,3 +44,40 @@ TEST(Endianness, swapBytesManual) {
 	EXPECT_EQ(MANUAL_BSWAP_32(test32bit), 0x78563412);
 	EXPECT_EQ(MANUAL_BSWAP_64(test64bit), 0xEFCDAB9078563412);
 }
+
+TEST(Endianness, swapBytesArray) {
+	// Use odd sizes to cover both the vectorized part and the remaining tail
+	std::vector<uint16_t> values16(37);
+	std::vector<uint32_t> values32(19);
+	std::vector<uint64_t> values64(11);
+	std::vector<float> valuesFloat(13);
+
+	for (size_t i = 0; i < values16.size(); ++i)
+		values16[i] = static_cast<uint16_t>(0x0102 * (i + 1));
+	for (size_t i = 0; i < values32.size(); ++i)
+		values32[i] = static_cast<uint32_t>(0x01020304 * (i + 1));
+	for (size_t i = 0; i < values64.size(); ++i)
+		values64[i] = 0x0102030405060708 * (i + 1);
+	for (size_t i = 0; i < valuesFloat.size(); ++i)
+		valuesFloat[i] = static_cast<float>(i) * 1.5f;
+
+	const auto expected16 = values16;
+	const auto expected32 = values32;
+	const auto expected64 = values64;
+	const auto expectedFloat = valuesFloat;
+
+	Common::swapBytes(std::span(values16));
+	Common::swapBytes(std::span(values32));
+	Common::swapBytes(std::span(values64));
+	Common::swapBytesArray(std::span(valuesFloat));
+
+	for (size_t i = 0; i < values16.size(); ++i)
+		EXPECT_EQ(values16[i], Common::swapBytes(expected16[i]));
+	for (size_t i = 0; i < values32.size(); ++i)
+		EXPECT_EQ(values32[i], Common::swapBytes(expected32[i]));
+	for (size_t i = 0; i < values64.size(); ++i)
+		EXPECT_EQ(values64[i], Common::swapBytes(expected64[i]));
+
+	Common::swapBytesArray(std::span(valuesFloat));
+	EXPECT_EQ(valuesFloat, expectedFloat);
+}
@@ -20,6 +20,9 @@
 
 #include "src/common/frustrum.h"
 
+#include <limits>
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include <glm/glm.hpp>
@@ -100,3 +103,118 @@ TEST(Frustrum, simpleShape) {
 	EXPECT_TRUE(frustrum.test(sphere5));
 	EXPECT_FALSE(frustrum.test(sphere6));
 }
+
+static Common::Frustrum createBatchFrustrum() {
+	const glm::mat4 view = glm::lookAt(
+		glm::vec3(1.0f, 2.0f, 3.0f),
+		glm::vec3(4.0f, 1.0f, -5.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f)
+	);
+	const glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 50.0f);
+	return Common::Frustrum(view, projection);
+}
+
+/*
+ * The batch tests have to agree exactly with the single tests. This relies on frustrum.cpp being compiled without
+ * floating point contraction, otherwise the single tests could use fused multiply add instructions.
+ */
+TEST(Frustrum, batchSpheres) {
+	const Common::Frustrum frustrum = createBatchFrustrum();
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> radius(0.0f, 5.0f);
+
+	// Test multiple counts to cover the vectorized part as well as the scalar tail
+	for (const size_t count : {0, 1, 3, 4, 7, 8, 9, 63, 64, 65, 1000}) {
+		std::vector<float> x(count), y(count), z(count), r(count);
+		for (size_t i = 0; i < count; ++i) {
+			x[i] = position(random);
+			y[i] = position(random);
+			z[i] = position(random);
+			r[i] = radius(random);
+		}
+
+		// Add spheres exactly touching the planes and with invalid values
+		if (count > 3) {
+			x[0] = y[0] = z[0] = 1.0f;
+			r[0] = 0.0f;
+			r[1] = std::numeric_limits<float>::infinity();
+			r[2] = std::numeric_limits<float>::quiet_NaN();
+		}
+
+		// Fill the mask with garbage to check that it is completely overwritten
+		std::vector<uint64_t> visible(Common::Frustrum::getMaskSize(count) + 1, ~0ull);
+		frustrum.test(x, y, z, r, visible);
+
+		size_t numVisible = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const bool expected = frustrum.test(Common::BoundSphere{glm::vec3(x[i], y[i], z[i]), r[i]});
+			EXPECT_EQ(Common::Frustrum::isVisible(visible, i), expected) << "Sphere " << i << " of " << count;
+			numVisible += expected;
+		}
+
+		// Bits after the last sphere have to be cleared, but the values after the mask have to be untouched
+		if (count % 64 != 0)
+			EXPECT_EQ(visible[count / 64] >> (count % 64), 0u);
+		EXPECT_EQ(visible.back(), ~0ull);
+
+		if (count == 1000) {
+			EXPECT_GT(numVisible, 0u);
+			EXPECT_LT(numVisible, count);
+		}
+	}
+}
+
+TEST(Frustrum, batchBoxes) {
+	const Common::Frustrum frustrum = createBatchFrustrum();
+
+	std::mt19937 random(1337);
+	std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> size(0.0f, 10.0f);
+
+	for (const size_t count : {0, 1, 5, 8, 64, 100, 1000}) {
+		std::vector<float> xmin(count), ymin(count), zmin(count), xmax(count), ymax(count), zmax(count);
+		for (size_t i = 0; i < count; ++i) {
+			xmin[i] = position(random);
+			ymin[i] = position(random);
+			zmin[i] = position(random);
+			xmax[i] = xmin[i] + size(random);
+			ymax[i] = ymin[i] + size(random);
+			zmax[i] = zmin[i] + size(random);
+		}
+
+		std::vector<uint64_t> visible(Common::Frustrum::getMaskSize(count), ~0ull);
+		frustrum.test(xmin, ymin, zmin, xmax, ymax, zmax, visible);
+
+		size_t numVisible = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const Common::BoundBox box(glm::vec3(xmin[i], ymin[i], zmin[i]), glm::vec3(xmax[i], ymax[i], zmax[i]));
+			const bool expected = frustrum.test(box);
+			EXPECT_EQ(Common::Frustrum::isVisible(visible, i), expected) << "Box " << i << " of " << count;
+			numVisible += expected;
+		}
+
+		if (count == 1000) {
+			EXPECT_GT(numVisible, 0u);
+			EXPECT_LT(numVisible, count);
+		}
+	}
+
+	// A box containing the whole frustrum and one far behind the camera
+	EXPECT_TRUE(frustrum.test(Common::BoundBox(glm::vec3(-100.0f), glm::vec3(100.0f))));
+	EXPECT_FALSE(frustrum.test(Common::BoundBox(glm::vec3(-20.0f, -20.0f, 50.0f), glm::vec3(-10.0f, -10.0f, 60.0f))));
+}
+
+TEST(Frustrum, batchInvalidSizes) {
+	const Common::Frustrum frustrum;
+
+	std::vector<float> a(10), b(9);
+	std::vector<uint64_t> visible(1);
+	std::vector<uint64_t> noVisible;
+
+	EXPECT_THROW(frustrum.test(a, a, b, a, visible), std::exception);
+	EXPECT_THROW(frustrum.test(a, a, a, a, noVisible), std::exception);
+	EXPECT_THROW(frustrum.test(a, a, a, a, a, b, visible), std::exception);
+	EXPECT_NO_THROW(frustrum.test(a, a, a, a, visible));
+}
@@ -0,0 +1,146 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "src/common/mappedfile.h"
+
+class MappedFile : public testing::Test {
+protected:
+	void SetUp() override {
+		_filename = std::tmpnam(nullptr);
+		std::ofstream out(_filename, std::ios::out | std::ios::binary);
+
+		// Make 256 byte forwards and backwards
+		for (int i = 0; i < 256; ++i) {
+			data1[i] = i;
+			data2[i] = 255 - i;
+		}
+
+		out.write(reinterpret_cast<char*>(data1), 256);
+		out.write(reinterpret_cast<char*>(data2), 256);
+		out.close();
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(_filename);
+	}
+
+	byte data1[256], data2[256];
+
+	std::string _filename;
+};
+
+TEST_F(MappedFile, read) {
+	Common::MappedFile mappedFile(_filename);
+
+	EXPECT_EQ(mappedFile.pos(), 0);
+	EXPECT_FALSE(mappedFile.eos());
+
+	byte testData[256];
+	EXPECT_EQ(mappedFile.read(testData, 256), 256);
+	EXPECT_EQ(mappedFile.pos(), 256);
+	EXPECT_FALSE(mappedFile.eos());
+	for (int i = 0; i < 256; ++i) {
+		EXPECT_EQ(data1[i], testData[i]);
+	}
+
+	EXPECT_EQ(mappedFile.read(testData, 256), 256);
+	EXPECT_EQ(mappedFile.pos(), 512);
+	EXPECT_TRUE(mappedFile.eos());
+	for (int i = 0; i < 256; ++i) {
+		EXPECT_EQ(data2[i], testData[i]);
+	}
+
+	EXPECT_EQ(mappedFile.read(testData, 256), 0);
+	EXPECT_EQ(mappedFile.pos(), 512);
+	EXPECT_TRUE(mappedFile.eos());
+}
+
+TEST_F(MappedFile, readAt) {
+	Common::MappedFile mappedFile(_filename);
+
+	EXPECT_TRUE(mappedFile.isConcurrent());
+
+	byte testData[256];
+	EXPECT_EQ(mappedFile.readAt(256, testData, 256), 256);
+	EXPECT_EQ(mappedFile.pos(), 0);
+	for (int i = 0; i < 256; ++i) {
+		EXPECT_EQ(data2[i], testData[i]);
+	}
+
+	EXPECT_EQ(mappedFile.readAt(500, testData, 256), 12);
+	EXPECT_EQ(mappedFile.readAt(512, testData, 256), 0);
+}
+
+TEST_F(MappedFile, getView) {
+	Common::MappedFile mappedFile(_filename);
+
+	const auto view = mappedFile.getView(250, 10);
+	ASSERT_EQ(view.size(), 10);
+	for (int i = 0; i < 6; ++i) {
+		EXPECT_EQ(view[i], data1[250 + i]);
+	}
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_EQ(view[6 + i], data2[i]);
+	}
+
+	EXPECT_EQ(mappedFile.getView(0, 512).size(), 512);
+	EXPECT_TRUE(mappedFile.getView(500, 13).empty());
+	EXPECT_TRUE(mappedFile.getView(513, 0).empty());
+}
+
+TEST_F(MappedFile, seek) {
+	Common::MappedFile mappedFile(_filename);
+
+	mappedFile.seek(10, Common::ReadStream::BEGIN);
+	EXPECT_EQ(mappedFile.pos(), 10);
+	EXPECT_FALSE(mappedFile.eos());
+
+	mappedFile.seek(5, Common::ReadStream::CURRENT);
+	EXPECT_EQ(mappedFile.pos(), 15);
+
+	mappedFile.seek(-5, Common::ReadStream::CURRENT);
+	EXPECT_EQ(mappedFile.pos(), 10);
+
+	mappedFile.seek(-5, Common::ReadStream::END);
+	EXPECT_EQ(mappedFile.pos(), 507);
+	EXPECT_EQ(mappedFile.readByte(), data2[251]);
+
+	mappedFile.seek(0, Common::ReadStream::END);
+	EXPECT_EQ(mappedFile.pos(), 512);
+	EXPECT_TRUE(mappedFile.eos());
+
+	EXPECT_ANY_THROW(mappedFile.seek(5, Common::ReadStream::END));
+	EXPECT_ANY_THROW(mappedFile.seek(-1, Common::ReadStream::BEGIN));
+}
+
+TEST_F(MappedFile, size) {
+	Common::MappedFile mappedFile(_filename);
+
+	EXPECT_EQ(mappedFile.size(), 512);
+}
+
+TEST_F(MappedFile, invalidFile) {
+	EXPECT_ANY_THROW(Common::MappedFile mappedFile(_filename + "_invalid"));
+}
@@ -18,9 +18,13 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bit>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "src/common/memreadstream.h"
+#include "src/common/endianreadstream.h"
 
 #include "lipsum.h"
 
@@ -636,3 +640,45 @@ TEST(MemoryReadStream, size) {
 	EXPECT_EQ(memoryReadStream1.size(), 42);
 	EXPECT_EQ(memoryReadStream2.size(), 46);
 }
+
+TEST(MemoryReadStream, readArray) {
+	static const byte data[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x09, 0x0A, 0x0B, 0x0C, 0x00, 0x00, 0x80, 0x3F,
+		0x3F, 0x80, 0x00, 0x00, 0xFF
+	};
+
+	Common::MemoryReadStream stream(data, sizeof(data));
+
+	uint16_t values16LE[3];
+	EXPECT_EQ(stream.readArrayLE(std::span(values16LE)), 3);
+	EXPECT_EQ(values16LE[0], 0x0201);
+	EXPECT_EQ(values16LE[1], 0x0403);
+	EXPECT_EQ(values16LE[2], 0x0605);
+
+	stream.seek(0);
+	uint32_t values32BE[3];
+	EXPECT_EQ(stream.readArrayBE(std::span(values32BE)), 3);
+	EXPECT_EQ(values32BE[0], 0x01020304);
+	EXPECT_EQ(values32BE[1], 0x05060708);
+	EXPECT_EQ(values32BE[2], 0x090A0B0C);
+
+	stream.seek(0);
+	uint64_t value64LE[1];
+	EXPECT_EQ(stream.readArrayLE(std::span(value64LE)), 1);
+	EXPECT_EQ(value64LE[0], 0x0807060504030201);
+
+	stream.seek(12);
+	float floatLE[1], floatBE[1];
+	EXPECT_EQ(stream.readArrayLE(std::span(floatLE)), 1);
+	EXPECT_EQ(stream.readArrayBE(std::span(floatBE)), 1);
+	EXPECT_FLOAT_EQ(floatLE[0], 1.0f);
+	EXPECT_FLOAT_EQ(floatBE[0], 1.0f);
+
+	stream.seek(0);
+	std::vector<glm::vec2> vectors(1);
+	Common::EndianReadStream endianStream(&stream, true);
+	EXPECT_EQ(endianStream.readArray(std::span(vectors)), 1);
+	EXPECT_EQ(std::bit_cast<uint32_t>(vectors[0].x), 0x01020304);
+	EXPECT_EQ(std::bit_cast<uint32_t>(vectors[0].y), 0x05060708);
+}
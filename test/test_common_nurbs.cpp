@@ -0,0 +1,128 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "src/common/nurbs.h"
+#include "src/common/types.h"
+
+/*!
+ * The previous allocating implementation of the basis functions, used as
+ * reference for the interpolated values
+ */
+template<typename T>
+static T referenceInterpolate(
+	const std::vector<T> &controlPoints,
+	const std::vector<uint8_t> &knots,
+	unsigned int degree,
+	unsigned int t
+) {
+	size_t span;
+	if (t >= knots[controlPoints.size()]) {
+		span = controlPoints.size() - 1;
+	} else {
+		span = degree;
+		while (t < knots[span] || t >= knots[span + 1])
+			span++;
+	}
+
+	std::vector<float> N(degree + 1, 0.0f);
+	N[0] = 1.0f;
+	for (unsigned int i = 0; i < degree; ++i) {
+		for (int j = i; j >= 0; --j) {
+			float a = (static_cast<float>(t) - knots[span - j]) / (knots[span + i + 1 - j] - knots[span - j]);
+			float tmp = N[j] * a;
+			N[j + 1] += N[j] - tmp;
+			N[j] = tmp;
+		}
+	}
+
+	T value(0);
+	for (unsigned int i = 0; i <= degree; ++i)
+		value += controlPoints[span - i] * N[i];
+
+	return value;
+}
+
+/*!
+ * Generate a curve like the havok spline compressed animations, with the
+ * first and last knots repeated degree + 1 times
+ */
+static std::vector<uint8_t> generateKnots(std::mt19937 &random, size_t numControlPoints, unsigned int degree, uint8_t end) {
+	std::vector<uint8_t> knots(numControlPoints + degree + 1);
+	std::uniform_int_distribution<unsigned int> distribution(1, end - 1);
+
+	for (unsigned int i = 0; i <= degree; ++i) {
+		knots[i] = 0;
+		knots[knots.size() - 1 - i] = end;
+	}
+
+	for (size_t i = degree + 1; i < numControlPoints; ++i)
+		knots[i] = distribution(random);
+	std::sort(knots.begin() + degree + 1, knots.begin() + numControlPoints);
+
+	return knots;
+}
+
+TEST(NURBS, interpolate) {
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+	for (unsigned int degree = 1; degree <= Common::NURBS<float>::kMaxDegree; ++degree) {
+		for (size_t numControlPoints = degree + 1; numControlPoints < 24; ++numControlPoints) {
+			std::vector<glm::vec3> controlPoints(numControlPoints);
+			for (auto &controlPoint : controlPoints)
+				controlPoint = glm::vec3(distribution(random), distribution(random), distribution(random));
+
+			const auto knots = generateKnots(random, numControlPoints, degree, 64);
+			const Common::NURBS<glm::vec3> nurbs(controlPoints, knots, degree);
+
+			// Interpolate every time on its own and the whole range at once, including times behind the last knot
+			std::vector<glm::vec3> values(72);
+			nurbs.interpolate(0, values);
+
+			for (unsigned int t = 0; t < values.size(); ++t) {
+				const auto expected = referenceInterpolate(controlPoints, knots, degree, t);
+				const auto single = nurbs.interpolate(t);
+				for (int i = 0; i < 3; ++i) {
+					EXPECT_NEAR(single[i], expected[i], 1e-4f) << "degree " << degree << ", time " << t;
+					EXPECT_NEAR(values[t][i], expected[i], 1e-4f) << "degree " << degree << ", time " << t;
+				}
+			}
+
+			// Ranges can start at any time
+			std::vector<glm::vec3> offsetValues(20);
+			nurbs.interpolate(30, offsetValues);
+			for (unsigned int i = 0; i < offsetValues.size(); ++i)
+				EXPECT_EQ(offsetValues[i], values[30 + i]);
+		}
+	}
+}
+
+TEST(NURBS, invalidCurves) {
+	EXPECT_THROW(Common::NURBS<float>({1.0f, 2.0f, 3.0f, 4.0f, 5.0f}, {0, 0, 0, 0, 0, 1, 1, 1, 1, 1}, 4), std::exception);
+	EXPECT_THROW(Common::NURBS<float>({1.0f, 2.0f}, {0, 0, 1}, 2), std::exception);
+	EXPECT_THROW(Common::NURBS<float>({1.0f, 2.0f, 3.0f}, {0, 0, 0, 1, 1}, 2), std::exception);
+	EXPECT_NO_THROW(Common::NURBS<float>({1.0f, 2.0f, 3.0f}, {0, 0, 0, 1, 1, 1}, 2));
+}
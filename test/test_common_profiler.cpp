@@ -0,0 +1,146 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "src/common/profiler.h"
+
+class TraceProfiler : public testing::Test {
+protected:
+	void SetUp() override {
+		_filename = std::tmpnam(nullptr);
+	}
+
+	void TearDown() override {
+		Common::TraceProfiler::instance().stop();
+		std::filesystem::remove(_filename);
+	}
+
+	std::string readTrace() const {
+		std::ifstream in(_filename);
+		std::stringstream trace;
+		trace << in.rdbuf();
+		return trace.str();
+	}
+
+	static size_t count(const std::string &str, const std::string &pattern) {
+		size_t occurrences = 0;
+		for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+			occurrences++;
+		return occurrences;
+	}
+
+	std::string _filename;
+};
+
+TEST_F(TraceProfiler, recordEvents) {
+	auto &profiler = Common::TraceProfiler::instance();
+
+	// Zones outside of a recording are ignored
+	{
+		const Common::TraceZone zone("Ignored zone");
+	}
+	EXPECT_FALSE(profiler.isRecording());
+
+	profiler.start(_filename);
+	EXPECT_TRUE(profiler.isRecording());
+
+	profiler.setThreadName("Test \"Main\" Thread");
+	{
+		const Common::TraceZone zone("Outer zone");
+		{
+			const Common::TraceZone inner("Inner zone");
+		}
+		profiler.addCounter("Test counter", 42.0);
+	}
+	profiler.addFrame();
+
+	std::thread thread([&]() {
+		profiler.setThreadName("Test Worker");
+		for (int i = 0; i < 10000; ++i) {
+			const Common::TraceZone zone("Worker zone");
+		}
+	});
+	thread.join();
+
+	profiler.stop();
+	EXPECT_FALSE(profiler.isRecording());
+
+	const std::string trace = readTrace();
+
+	// The file has to be a complete json object
+	EXPECT_EQ(trace.rfind("{\"traceEvents\":[\n", 0), 0u);
+	EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+	EXPECT_EQ(count(trace, "\"name\":\"Ignored zone\""), 0u);
+	EXPECT_EQ(count(trace, "\"name\":\"Outer zone\",\"ph\":\"X\""), 1u);
+	EXPECT_EQ(count(trace, "\"name\":\"Inner zone\",\"ph\":\"X\""), 1u);
+	EXPECT_EQ(count(trace, "\"name\":\"Test counter\",\"ph\":\"C\""), 1u);
+	EXPECT_EQ(count(trace, "\"args\":{\"value\":42}"), 1u);
+	EXPECT_EQ(count(trace, "\"name\":\"Frame\",\"ph\":\"i\""), 1u);
+
+	// The worker records more events than fit into its buffer, none of them may get lost
+	EXPECT_EQ(count(trace, "\"name\":\"Worker zone\",\"ph\":\"X\""), 10000u);
+
+	// Thread names are escaped
+	EXPECT_EQ(count(trace, "\"args\":{\"name\":\"Test \\\"Main\\\" Thread\"}"), 1u);
+	EXPECT_EQ(count(trace, "\"args\":{\"name\":\"Test Worker\"}"), 1u);
+
+	// Every event is on its own line and separated by a comma
+	const size_t numEvents = 10000 + 4 + count(trace, "\"ph\":\"M\"");
+	EXPECT_EQ(count(trace, "},\n{"), numEvents - 1);
+}
+
+TEST_F(TraceProfiler, restart) {
+	auto &profiler = Common::TraceProfiler::instance();
+
+	const std::string otherFilename = std::tmpnam(nullptr);
+
+	profiler.start(otherFilename);
+	{
+		const Common::TraceZone zone("First recording");
+	}
+
+	// Starting a new recording finishes the previous one
+	profiler.start(_filename);
+	{
+		const Common::TraceZone zone("Second recording");
+	}
+	profiler.stop();
+
+	std::ifstream in(otherFilename);
+	std::stringstream first;
+	first << in.rdbuf();
+	in.close();
+	std::filesystem::remove(otherFilename);
+
+	const std::string second = readTrace();
+
+	EXPECT_EQ(count(first.str(), "First recording"), 1u);
+	EXPECT_EQ(count(first.str(), "Second recording"), 0u);
+	EXPECT_EQ(count(first.str(), "\n]}\n"), 1u);
+	EXPECT_EQ(count(second, "First recording"), 0u);
+	EXPECT_EQ(count(second, "Second recording"), 1u);
+}
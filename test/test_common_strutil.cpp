@@ -19,6 +19,8 @@
  */
 
 #include <string>
+#include <vector>
+#include <regex>
 
 #include <gtest/gtest.h>
 
@@ -59,6 +61,74 @@ TEST(StringUtil, split) {
 	EXPECT_STREQ(split[2].c_str(), "splitted");
 }
 
+TEST(StringUtil, splitCharacter) {
+	const std::vector<std::string> split = Common::split("multiple words  splitted ", ' ');
+
+	ASSERT_EQ(split.size(), 4);
+
+	EXPECT_STREQ(split[0].c_str(), "multiple");
+	EXPECT_STREQ(split[1].c_str(), "words");
+	EXPECT_STREQ(split[2].c_str(), "");
+	EXPECT_STREQ(split[3].c_str(), "splitted");
+}
+
+TEST(StringUtil, tokenizer) {
+	// The tokenizer has to behave exactly like the regex based split
+	const std::regex slash("/");
+	for (const std::string testString : {"", "a", "a/", "/a", "a//b", "/", "//", "path/to/file.txt", "/path/to//file/"}) {
+		std::vector<std::string> tokens;
+		for (const auto token : Common::Tokenizer(testString, '/'))
+			tokens.emplace_back(token);
+
+		EXPECT_EQ(tokens, Common::split(testString, slash)) << "for \"" << testString << "\"";
+		EXPECT_EQ(tokens, Common::split(testString, '/')) << "for \"" << testString << "\"";
+	}
+
+	// The tokens are views into the original string
+	const std::string testString = "data/textures/test.tex";
+	auto iter = Common::Tokenizer(testString, '/').begin();
+	EXPECT_EQ(*iter, "data");
+	EXPECT_EQ((*iter).data(), testString.data());
+	++iter;
+	EXPECT_EQ(*iter, "textures");
+	EXPECT_EQ((*iter).data(), testString.data() + 5);
+	++iter;
+	EXPECT_EQ(*iter, "test.tex");
+	++iter;
+	EXPECT_EQ(iter, Common::Tokenizer(testString, '/').end());
+}
+
+TEST(StringUtil, toLowerInPlace) {
+	std::string testString = "CooL TeSt!#$";
+	Common::toLowerInPlace(testString);
+	EXPECT_STREQ(testString.c_str(), "cool test!#$");
+}
+
+TEST(StringUtil, foldSlashes) {
+	std::string testString = "d:\\data\\textures/test.tex";
+	Common::foldSlashes(testString);
+	EXPECT_STREQ(testString.c_str(), "d:/data/textures/test.tex");
+}
+
+TEST(StringUtil, replaceInPlace) {
+	std::string testString = "data/objects/data/test.rfx";
+	Common::replaceInPlace(testString, "data/", "");
+	EXPECT_STREQ(testString.c_str(), "objects/test.rfx");
+
+	// Replacements are not searched again
+	testString = "dadata/ta/";
+	Common::replaceInPlace(testString, "data/", "");
+	EXPECT_STREQ(testString.c_str(), "data/");
+
+	testString = "aaa";
+	Common::replaceInPlace(testString, "a", "aa");
+	EXPECT_STREQ(testString.c_str(), "aaaaaa");
+
+	testString = "test";
+	Common::replaceInPlace(testString, "", "x");
+	EXPECT_STREQ(testString.c_str(), "test");
+}
+
 TEST(StringUtil, startsWith) {
 	const std::string testString = "This is a cool and awesome sentence.";
 
@@ -19,6 +19,13 @@
  */
 
 #include <string>
+#include <vector>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <future>
+#include <mutex>
 
 #include <gtest/gtest.h>
 
@@ -43,3 +50,296 @@ TEST(ThreadPool, multipleJobs) {
 TEST(ThreadPool, numThreads) {
 	EXPECT_EQ(Threads.getNumWorkerThreads(), std::max<size_t>(std::thread::hardware_concurrency() - 1, 1));
 }
+
+TEST(ThreadPool, parallelFor) {
+	std::vector<std::atomic_int> calls(1000);
+	Threads.parallelFor(calls.size(), [&](size_t index) {
+		calls[index]++;
+	});
+
+	for (const auto &call : calls)
+		EXPECT_EQ(call.load(), 1);
+
+	// Nested calls from inside of workers have to finish, even if all workers are busy
+	std::atomic_int nestedCalls(0);
+	Threads.parallelFor(Threads.getNumWorkerThreads() * 2, [&](size_t) {
+		Threads.parallelFor(16, [&](size_t) {
+			nestedCalls++;
+		});
+	});
+	EXPECT_EQ(nestedCalls.load(), Threads.getNumWorkerThreads() * 2 * 16);
+
+	EXPECT_THROW(
+		Threads.parallelFor(100, [](size_t index) {
+			if (index == 42)
+				throw std::runtime_error("Test");
+		}),
+		std::runtime_error
+	);
+}
+
+TEST(ThreadPool, parallelForRange) {
+	std::vector<std::atomic_int> calls(1003);
+	std::atomic_size_t maxChunkSize(0);
+	Threads.parallelFor(3, calls.size(), 10, [&](size_t begin, size_t end) {
+		size_t chunkSize = end - begin;
+		size_t previous = maxChunkSize.load();
+		while (chunkSize > previous && !maxChunkSize.compare_exchange_weak(previous, chunkSize)) {}
+
+		for (size_t i = begin; i < end; ++i)
+			calls[i]++;
+	});
+
+	for (size_t i = 0; i < calls.size(); ++i)
+		EXPECT_EQ(calls[i].load(), i < 3 ? 0 : 1);
+	EXPECT_EQ(maxChunkSize.load(), 10);
+
+	// Empty ranges don't call the function at all
+	Threads.parallelFor(5, 5, 10, [](size_t, size_t) { FAIL(); });
+}
+
+TEST(ThreadPool, submit) {
+	auto value = Threads.submit([]() { return 42; });
+	auto text = Threads.submit([]() { return std::string("Test"); });
+	auto error = Threads.submit([]() -> int { throw std::runtime_error("Test"); });
+
+	EXPECT_EQ(value.get(), 42);
+	EXPECT_EQ(text.get(), "Test");
+	EXPECT_THROW(error.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, taskGroup) {
+	std::atomic_int counter(0);
+	Common::TaskGroup group;
+	for (int i = 0; i < 1000; ++i)
+		group.run([&]() { counter++; });
+	group.wait();
+	EXPECT_EQ(counter.load(), 1000);
+
+	// Groups can be waited on from inside of tasks, even if all workers are waiting
+	std::atomic_int nestedCounter(0);
+	Common::TaskGroup outerGroup;
+	for (size_t i = 0; i < Threads.getNumWorkerThreads() * 2; ++i) {
+		outerGroup.run([&]() {
+			Common::TaskGroup innerGroup;
+			for (int j = 0; j < 16; ++j)
+				innerGroup.run([&]() { nestedCounter++; });
+			innerGroup.wait();
+		});
+	}
+	outerGroup.wait();
+	EXPECT_EQ(nestedCounter.load(), Threads.getNumWorkerThreads() * 2 * 16);
+
+	Common::TaskGroup errorGroup;
+	for (int i = 0; i < 100; ++i) {
+		errorGroup.run([i]() {
+			if (i == 42)
+				throw std::runtime_error("Test");
+		});
+	}
+	EXPECT_THROW(errorGroup.wait(), std::runtime_error);
+
+	// The error is only reported once
+	EXPECT_NO_THROW(errorGroup.wait());
+}
+
+TEST(ThreadPool, contention) {
+	static const int kProducers = 8;
+	static const int kTasksPerProducer = 5000;
+
+	// Many threads outside of the pool add tasks at the same time
+	std::atomic_int counter(0);
+	Common::TaskGroup group;
+	std::vector<std::thread> producers;
+	for (int i = 0; i < kProducers; ++i) {
+		producers.emplace_back([&]() {
+			for (int j = 0; j < kTasksPerProducer; ++j)
+				group.run([&]() { counter++; });
+		});
+	}
+	for (auto &producer : producers)
+		producer.join();
+	group.wait();
+	EXPECT_EQ(counter.load(), kProducers * kTasksPerProducer);
+
+	// Tasks adding further tasks push them to their own deque, from where the other workers have to steal them
+	std::atomic_int spawned(0);
+	Common::TaskGroup spawningGroup;
+	for (int i = 0; i < 4; ++i) {
+		spawningGroup.run([&]() {
+			for (int j = 0; j < 2000; ++j)
+				spawningGroup.run([&]() { spawned++; });
+		});
+	}
+	spawningGroup.wait();
+	EXPECT_EQ(spawned.load(), 4 * 2000);
+
+	while (!Threads.empty())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	EXPECT_EQ(Threads.getQueuedTasks(), 0);
+}
+
+TEST(ThreadPool, addAfter) {
+	const auto start = std::chrono::steady_clock::now();
+	std::promise<std::chrono::steady_clock::time_point> ran;
+	auto future = ran.get_future();
+	Threads.addAfter(std::chrono::milliseconds(20), [&]() { ran.set_value(std::chrono::steady_clock::now()); });
+
+	ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_GE(future.get() - start, std::chrono::milliseconds(20));
+
+	// Timers fire in the order they are due, not in the order they were added
+	std::mutex access;
+	std::vector<int> order;
+	std::atomic_int remaining(3);
+	for (const int i : {3, 1, 2}) {
+		Threads.addAfter(std::chrono::milliseconds(10 * i), [&, i]() {
+			std::lock_guard<std::mutex> l(access);
+			order.push_back(i);
+			remaining--;
+		});
+	}
+	while (remaining > 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+
+	// Cancelled timers never run
+	std::atomic_bool cancelledRan(false);
+	const auto id = Threads.addAfter(std::chrono::milliseconds(20), [&]() { cancelledRan = true; });
+	EXPECT_TRUE(Threads.cancel(id));
+	EXPECT_FALSE(Threads.cancel(id));
+	std::this_thread::sleep_for(std::chrono::milliseconds(40));
+	EXPECT_FALSE(cancelledRan);
+
+	EXPECT_THROW(Threads.addAfter(std::chrono::milliseconds(1), nullptr), std::exception);
+}
+
+TEST(ThreadPool, addPeriodic) {
+	std::atomic_int counter(0);
+	std::atomic_bool running(false);
+	std::atomic_bool overlapped(false);
+	const auto id = Threads.addPeriodic(std::chrono::milliseconds(1), [&]() {
+		if (running.exchange(true))
+			overlapped = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		counter++;
+		running = false;
+	});
+
+	while (counter < 5)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	// After cancelling, the task is neither running nor called again
+	EXPECT_TRUE(Threads.cancel(id));
+	EXPECT_FALSE(running);
+	const int count = counter;
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_EQ(counter.load(), count);
+	EXPECT_FALSE(overlapped);
+
+	// A periodic task can cancel itself from within
+	std::atomic_int selfCounter(0);
+	std::atomic<Common::TimerId> selfId(0);
+	std::mutex access;
+	std::unique_lock<std::mutex> lock(access);
+	selfId = Threads.addPeriodic(std::chrono::milliseconds(1), [&]() {
+		std::lock_guard<std::mutex> l(access);
+		if (++selfCounter == 3)
+			Threads.cancel(selfId);
+	});
+	lock.unlock();
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(selfCounter.load(), 3);
+	EXPECT_FALSE(Threads.cancel(selfId));
+
+	EXPECT_THROW(Threads.addPeriodic(std::chrono::milliseconds(0), []() {}), std::exception);
+}
+
+TEST(ThreadPool, cancelDoesNotRunOtherTasks) {
+	// Block all normal workers, so that a queued background task can only be run by the cancelling thread
+	std::atomic_size_t blocked(0);
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	for (size_t i = 0; i < Threads.getNumWorkerThreads(); ++i) {
+		Threads.add([&blocked, released]() {
+			blocked++;
+			released.wait();
+		}, Common::TaskPriority::kBackground);
+	}
+	while (blocked < Threads.getNumWorkerThreads())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	std::atomic_bool backgroundRan(false);
+	Threads.add([&]() { backgroundRan = true; }, Common::TaskPriority::kBackground);
+
+	// Realtime timers still run on the reserved workers and are cancelled while they are running
+	for (int i = 0; i < 10; ++i) {
+		std::atomic_bool started(false);
+		const auto id = Threads.addPeriodic(std::chrono::milliseconds(1), [&]() {
+			started = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}, Common::TaskPriority::kRealtime);
+
+		while (!started)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		EXPECT_TRUE(Threads.cancel(id));
+	}
+
+	EXPECT_FALSE(backgroundRan);
+	release.set_value();
+
+	while (!backgroundRan)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+TEST(ThreadPool, priorities) {
+	EXPECT_GE(Threads.getNumRealtimeWorkerThreads(), 1);
+
+	// Block all normal workers with background tasks
+	std::atomic_size_t blocked(0);
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	for (size_t i = 0; i < Threads.getNumWorkerThreads(); ++i) {
+		Threads.add([&blocked, released]() {
+			blocked++;
+			released.wait();
+		}, Common::TaskPriority::kBackground);
+	}
+	while (blocked < Threads.getNumWorkerThreads())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	const size_t startedBackground = Threads.getStartedTasks(Common::TaskPriority::kBackground);
+	std::atomic_int backgroundCounter(0);
+	for (int i = 0; i < 10; ++i)
+		Threads.add([&]() { backgroundCounter++; }, Common::TaskPriority::kBackground);
+	EXPECT_EQ(Threads.getQueuedTasks(Common::TaskPriority::kBackground), 10);
+
+	// Realtime tasks still run on the reserved workers
+	std::promise<void> realtimeRan;
+	Threads.add([&]() { realtimeRan.set_value(); }, Common::TaskPriority::kRealtime);
+	EXPECT_EQ(realtimeRan.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_EQ(backgroundCounter.load(), 0);
+	release.set_value();
+
+	while (backgroundCounter < 10)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	EXPECT_EQ(Threads.getQueuedTasks(Common::TaskPriority::kBackground), 0);
+	EXPECT_GE(Threads.getStartedTasks(Common::TaskPriority::kBackground), startedBackground + 10);
+	EXPECT_GE(Threads.getMaxWaitTime(Common::TaskPriority::kBackground), std::chrono::milliseconds(10));
+	EXPECT_GE(Threads.getWaitTime(Common::TaskPriority::kBackground), Threads.getMaxWaitTime(Common::TaskPriority::kBackground));
+
+	// Tasks inherit the priority of the task adding them
+	std::promise<size_t> inherited;
+	Threads.add([&]() {
+		const size_t before = Threads.getStartedTasks(Common::TaskPriority::kBackground);
+		Common::TaskGroup group;
+		group.run([]() {});
+		group.wait();
+		inherited.set_value(Threads.getStartedTasks(Common::TaskPriority::kBackground) - before);
+	}, Common::TaskPriority::kBackground);
+	EXPECT_GE(inherited.get_future().get(), 1);
+}
@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "src/common/zlib.h"
@@ -141,3 +143,62 @@ TEST(ZLIB, decompressInvalid) {
 	EXPECT_ANY_THROW(Common::decompressZLIB(nullptr, -1, 3));
 	EXPECT_ANY_THROW(Common::decompressZLIB(kInvalidLipsumCompressed, sizeof(kInvalidLipsumCompressed), strlen(kLipsum)));
 }
+
+TEST(ZLIB, inflateIncrementally) {
+	const size_t lipsumLength = strlen(kLipsum);
+	std::vector<byte> output(lipsumLength);
+
+	Common::ZLIBInflater inflater(kLipsumCompressed, sizeof(kLipsumCompressed), output.data(), output.size());
+	EXPECT_EQ(inflater.getInflatedSize(), 0);
+
+	EXPECT_EQ(inflater.inflateUntil(12), 12);
+	EXPECT_EQ(std::string(reinterpret_cast<char *>(output.data()), 12), std::string(kLipsum, 12));
+
+	EXPECT_EQ(inflater.inflateUntil(100), 100);
+	EXPECT_EQ(inflater.inflateUntil(50), 100);
+	EXPECT_EQ(inflater.inflateUntil(lipsumLength + 100), lipsumLength);
+	EXPECT_EQ(inflater.getInflatedSize(), lipsumLength);
+	EXPECT_EQ(std::string(reinterpret_cast<char *>(output.data()), lipsumLength), kLipsum);
+}
+
+TEST(ZLIB, inflateIncrementallyInvalid) {
+	const size_t lipsumLength = strlen(kLipsum);
+	std::vector<byte> output(lipsumLength);
+
+	Common::ZLIBInflater inflater(kInvalidLipsumCompressed, sizeof(kInvalidLipsumCompressed), output.data(), output.size());
+	EXPECT_ANY_THROW(inflater.inflateUntil(lipsumLength));
+}
+
+TEST(ZLIB, compressIntoBuffer) {
+	const std::span<const byte> lipsum(reinterpret_cast<const byte *>(kLipsum), strlen(kLipsum));
+
+	std::vector<byte> compressed(Common::getZLIBCompressBound(lipsum.size()));
+	const size_t compressedSize = Common::compressZLIB(lipsum, compressed);
+	EXPECT_GT(compressedSize, 0);
+	EXPECT_LT(compressedSize, lipsum.size());
+
+	std::vector<byte> decompressed(lipsum.size());
+	EXPECT_EQ(Common::decompressZLIB({compressed.data(), compressedSize}, decompressed), lipsum.size());
+	EXPECT_TRUE(std::equal(decompressed.begin(), decompressed.end(), lipsum.begin()));
+
+	std::vector<byte> tooSmall(16);
+	EXPECT_ANY_THROW(Common::compressZLIB(lipsum, tooSmall));
+}
+
+TEST(ZLIB, reuseInflater) {
+	const size_t lipsumLength = strlen(kLipsum);
+	std::vector<byte> output(lipsumLength);
+
+	Common::ZLIBInflater inflater;
+	EXPECT_ANY_THROW(inflater.inflate(kInvalidLipsumCompressed, output));
+
+	// The inflater is usable again after a failed stream
+	for (int i = 0; i < 3; ++i) {
+		std::fill(output.begin(), output.end(), 0);
+		EXPECT_EQ(inflater.inflate(kLipsumCompressed, output), lipsumLength);
+		EXPECT_EQ(std::string(reinterpret_cast<char *>(output.data()), lipsumLength), kLipsum);
+	}
+
+	inflater.reset(kLipsumCompressed, output);
+	EXPECT_EQ(inflater.inflateUntil(12), 12);
+}
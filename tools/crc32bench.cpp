@@ -0,0 +1,81 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "src/common/crc32.h"
+#include "src/common/exception.h"
+
+template<typename F>
+static double measure(const std::vector<byte> &data, unsigned int iterations, uint32_t &hash, F function) {
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < iterations; ++i)
+		hash = function(data);
+	const auto end = std::chrono::steady_clock::now();
+
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	return static_cast<double>(data.size()) * iterations / seconds / (1024.0 * 1024.0);
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Benchmark the crc32 table lookup against the runtime implementation", "crc32bench");
+
+	unsigned int size = 16;
+	unsigned int iterations = 10;
+
+	app.add_option("-s,--size", size, "The size of the hashed buffer in MiB")
+			->check(CLI::PositiveNumber);
+
+	app.add_option("-i,--iterations", iterations, "How often the buffer is hashed")
+			->check(CLI::PositiveNumber);
+
+	CLI11_PARSE(app, argc, argv);
+
+	std::vector<byte> data(static_cast<size_t>(size) * 1024 * 1024);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<byte>(i ^ (i >> 8));
+
+	uint32_t tableHash = 0, runtimeHash = 0;
+	const double tableSpeed = measure(data, iterations, tableHash, [](const std::vector<byte> &buffer) {
+		uint32_t hash = 0xFFFFFFFF;
+		for (const byte value : buffer)
+			hash = Common::kCRC32Table[(hash ^ value) & 0xFF] ^ (hash >> 8);
+		return hash ^ 0xFFFFFFFF;
+	});
+	const double runtimeSpeed = measure(data, iterations, runtimeHash, [](const std::vector<byte> &buffer) {
+		return Common::crc32Runtime(buffer.data(), buffer.size());
+	});
+
+	if (tableHash != runtimeHash)
+		throw Common::Exception("Hash mismatch between table lookup {:08x} and runtime {:08x}", tableHash, runtimeHash);
+
+	fmt::print("Hashed {} MiB {} times\n", size, iterations);
+	fmt::print("Table lookup: {:.0f} MiB/s\n", tableSpeed);
+	fmt::print("Runtime:      {:.0f} MiB/s\n", runtimeSpeed);
+	fmt::print("Speedup:      {:.1f}x\n", runtimeSpeed / tableSpeed);
+
+	return EXIT_SUCCESS;
+}
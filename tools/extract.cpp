@@ -0,0 +1,111 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "src/common/writefile.h"
+#include "src/common/exception.h"
+
+#include "tools/extract.h"
+
+namespace Tools {
+
+void extractArchive(const AWE::Archive &archive, unsigned int jobs, const ExtractPathMapping &mapPath) {
+	const size_t numResources = archive.getNumResources();
+
+	std::atomic_size_t nextIndex = 0, extractedFiles = 0, extractedBytes = 0;
+	std::mutex outputMutex;
+	std::exception_ptr error;
+
+	// Every worker takes the next file index until all files are extracted or one of them failed
+	const auto extract = [&]() {
+		try {
+			for (size_t i = nextIndex++; i < numResources; i = nextIndex++) {
+				const std::string path = archive.getResourcePath(i);
+				const std::string extractPath = mapPath ? mapPath(path) : path;
+
+				const auto resourceStream = std::unique_ptr<Common::ReadStream>(archive.getResourceByIndex(i));
+				if (!resourceStream)
+					throw Common::Exception("Resource not found in archive: {}", path);
+
+				{
+					std::lock_guard<std::mutex> l(outputMutex);
+					if (extractPath == path)
+						fmt::print("{}/{} {}\n", i + 1, numResources, path);
+					else
+						fmt::print("{}/{} {} --> {}\n", i + 1, numResources, path, extractPath);
+				}
+
+				std::filesystem::path p(extractPath);
+				if (!p.parent_path().empty()) {
+					// Other workers might create the same directory at the same time
+					std::error_code errorCode;
+					std::filesystem::create_directories(p.parent_path(), errorCode);
+				}
+
+				Common::WriteFile writeFile(p.string());
+				writeFile.writeStream(resourceStream.get());
+				writeFile.close();
+
+				extractedFiles++;
+				extractedBytes += resourceStream->size();
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> l(outputMutex);
+			if (!error)
+				error = std::current_exception();
+			nextIndex = numResources;
+		}
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < jobs; ++i)
+		workers.emplace_back(extract);
+	extract();
+	for (auto &worker : workers)
+		worker.join();
+
+	if (error)
+		std::rethrow_exception(error);
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	const double megabytes = static_cast<double>(extractedBytes) / (1024.0 * 1024.0);
+	fmt::print(
+		"Extracted {} files, {:.1f} MiB in {:.2f}s ({:.1f} MiB/s) using {} jobs\n",
+		extractedFiles.load(),
+		megabytes,
+		elapsed.count(),
+		elapsed.count() > 0.0 ? megabytes / elapsed.count() : 0.0,
+		jobs
+	);
+}
+
+} // End of namespace Tools
@@ -0,0 +1,49 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_TOOLS_EXTRACT_H
+#define OPENAWE_TOOLS_EXTRACT_H
+
+#include <functional>
+#include <string>
+
+#include "src/awe/archive.h"
+
+namespace Tools {
+
+/*!
+ * Function mapping the path of a resource in an archive to the path it is extracted to
+ */
+typedef std::function<std::string (const std::string &)> ExtractPathMapping;
+
+/*!
+ * Extract all resources of an archive into the current directory using multiple threads. Every thread takes the
+ * next resource index until all resources are extracted or one of them failed, in which case the first error is
+ * rethrown after all threads finished. A summary of the extracted files is printed at the end.
+ *
+ * \param archive The archive to extract
+ * \param jobs The number of resources to extract in parallel
+ * \param mapPath Maps the path of a resource to the path it is written to, the paths are used as they are if empty
+ */
+void extractArchive(const AWE::Archive &archive, unsigned int jobs, const ExtractPathMapping &mapPath = {});
+
+} // End of namespace Tools
+
+#endif //OPENAWE_TOOLS_EXTRACT_H
@@ -0,0 +1,154 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <bit>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/common/cpuinfo.h"
+#include "src/common/exception.h"
+#include "src/common/frustrum.h"
+
+/*!
+ * Measure the average time of an operation per object. The operation returns the number of visible objects, which
+ * is used as a checksum so that the compiler can't remove the operation and the results can be compared.
+ */
+template<typename F>
+static double measure(size_t numObjects, unsigned int iterations, size_t &checksum, F operation) {
+	checksum = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < iterations; ++i)
+		checksum += operation();
+	const auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(numObjects * iterations);
+}
+
+static void printResult(
+	const std::string &name,
+	double scalarTime,
+	double batchTime,
+	size_t scalarChecksum,
+	size_t batchChecksum
+) {
+	if (scalarChecksum != batchChecksum)
+		throw Common::Exception("{}: The results of both variants differ", name);
+
+	fmt::print("{}\n", name);
+	fmt::print("  Single tests: {:.2f} ns per object\n", scalarTime);
+	fmt::print("  Batch test:   {:.2f} ns per object\n", batchTime);
+	fmt::print("  Speedup:      {:.1f}x\n", scalarTime / batchTime);
+}
+
+static size_t countVisible(const std::vector<uint64_t> &visible) {
+	size_t count = 0;
+	for (const auto value : visible)
+		count += std::popcount(value);
+	return count;
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Benchmark the batched frustrum culling against testing every object on its own", "frustrumbench");
+
+	unsigned int numObjects = 50000;
+	unsigned int iterations = 200;
+
+	app.add_option("-n,--objects", numObjects, "How many random objects are culled")
+			->check(CLI::PositiveNumber);
+
+	app.add_option("-i,--iterations", iterations, "How often all objects are culled")
+			->check(CLI::PositiveNumber);
+
+	CLI11_PARSE(app, argc, argv);
+
+	fmt::print("Using {}\n", Common::hasAVX() ? "AVX" : Common::hasSSE() ? "SSE" : "no vector instructions");
+
+	const glm::mat4 view = glm::lookAt(
+		glm::vec3(0.0f, 2.0f, 0.0f),
+		glm::vec3(0.0f, 2.0f, -1.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f)
+	);
+	const glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+	const Common::Frustrum frustrum(view, projection);
+
+	// Scatter the objects around the camera, so that roughly a fifth of them is visible
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> size(0.5f, 10.0f);
+
+	std::vector<float> x(numObjects), y(numObjects), z(numObjects), radius(numObjects);
+	std::vector<float> xmax(numObjects), ymax(numObjects), zmax(numObjects);
+	std::vector<Common::BoundSphere> spheres(numObjects);
+	std::vector<Common::BoundBox> boxes(numObjects);
+	for (unsigned int i = 0; i < numObjects; ++i) {
+		x[i] = position(random);
+		y[i] = position(random) * 0.1f;
+		z[i] = position(random);
+		radius[i] = size(random);
+		xmax[i] = x[i] + radius[i];
+		ymax[i] = y[i] + radius[i];
+		zmax[i] = z[i] + radius[i];
+
+		spheres[i] = Common::BoundSphere{glm::vec3(x[i], y[i], z[i]), radius[i]};
+		boxes[i] = Common::BoundBox(glm::vec3(x[i], y[i], z[i]), glm::vec3(xmax[i], ymax[i], zmax[i]));
+	}
+
+	std::vector<uint64_t> visible(Common::Frustrum::getMaskSize(numObjects));
+
+	size_t sphereScalarChecksum, sphereBatchChecksum;
+	size_t boxScalarChecksum, boxBatchChecksum;
+
+	const double sphereScalar = measure(numObjects, iterations, sphereScalarChecksum, [&]() {
+		size_t count = 0;
+		for (const auto &sphere : spheres)
+			count += frustrum.test(sphere);
+		return count;
+	});
+	const double sphereBatch = measure(numObjects, iterations, sphereBatchChecksum, [&]() {
+		frustrum.test(x, y, z, radius, visible);
+		return countVisible(visible);
+	});
+	printResult("Bounding spheres", sphereScalar, sphereBatch, sphereScalarChecksum, sphereBatchChecksum);
+
+	const double boxScalar = measure(numObjects, iterations, boxScalarChecksum, [&]() {
+		size_t count = 0;
+		for (const auto &box : boxes)
+			count += frustrum.test(box);
+		return count;
+	});
+	const double boxBatch = measure(numObjects, iterations, boxBatchChecksum, [&]() {
+		frustrum.test(x, y, z, xmax, ymax, zmax, visible);
+		return countVisible(visible);
+	});
+	printResult("Bounding boxes", boxScalar, boxBatch, boxScalarChecksum, boxBatchChecksum);
+
+	fmt::print("{} of {} objects visible\n", sphereScalarChecksum / iterations, numObjects);
+
+	return EXIT_SUCCESS;
+}
@@ -40,7 +40,7 @@
 namespace AWE {
 
 GID parseGID(const std::string &val) {
-	const auto split = Common::split(val, std::regex(":"));
+	const auto split = Common::split(val, ':');
 	assert(split.size() == 2);
 
 	GID gid{
@@ -0,0 +1,170 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <vector>
+#include <string>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "src/common/readfile.h"
+#include "src/common/exception.h"
+
+#include "src/awe/collisionsfile.h"
+#include "src/awe/foliagedatafile.h"
+#include "src/awe/gidregistryfile.h"
+#include "src/awe/havokfile.h"
+#include "src/awe/packmetafile.h"
+#include "src/awe/stringtablefile.h"
+#include "src/awe/terraindatafile.h"
+
+/*!
+ * The previous iostream based implementation of Common::ReadFile, kept as a
+ * baseline for the measurements.
+ */
+class IFStreamReadFile : public Common::ReadStream {
+public:
+	IFStreamReadFile(const std::string &file) : _in(file.c_str(), std::ios::in | std::ios::binary) {
+		if (!_in)
+			throw Common::Exception("Failed to open {}", file);
+
+		_in.seekg(0, std::ios::end);
+		_fileSize = _in.tellg();
+		_in.seekg(0, std::ios::beg);
+	}
+
+	size_t read(void *data, size_t length) override {
+		_in.read(reinterpret_cast<char *>(data), length);
+		return _in.gcount();
+	}
+
+	void seek(ptrdiff_t length, SeekOrigin origin) override {
+		switch (origin) {
+			case BEGIN:
+				_in.seekg(length, std::ios::beg);
+				break;
+			case CURRENT:
+				_in.seekg(length, std::ios::cur);
+				break;
+			case END:
+				_in.seekg(length, std::ios::end);
+				break;
+		}
+	}
+
+	bool eos() const override {
+		return _in.peek() == EOF;
+	}
+
+	size_t pos() const override {
+		if (_in.fail())
+			throw Common::Exception("File stream failed");
+
+		const auto pos = _in.tellg();
+		if (pos == std::istream::pos_type(-1))
+			throw Common::Exception("Invalid file stream position");
+
+		return _in.tellg();
+	}
+
+	size_t size() const override {
+		return _fileSize;
+	}
+
+private:
+	size_t _fileSize;
+	mutable std::ifstream _in;
+};
+
+typedef std::function<void (Common::ReadStream &)> Parser;
+
+template<typename T>
+static Parser makeParser() {
+	return [](Common::ReadStream &stream) {
+		T file(stream);
+	};
+}
+
+template<typename Stream>
+static double measure(const std::vector<std::string> &files, unsigned int iterations, const Parser &parser) {
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < iterations; ++i) {
+		for (const auto &file : files) {
+			Stream stream(file);
+			parser(stream);
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(iterations);
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Benchmark parsing loose files through the iostream and the buffered file stream", "readfilebench");
+
+	const std::map<std::string, Parser> parsers = {
+		{"collisions", makeParser<AWE::COLLISIONSFile>()},
+		{"foliagedata", makeParser<AWE::FoliageDataFile>()},
+		{"gidregistry", makeParser<AWE::GIDRegistryFile>()},
+		{"havok", makeParser<AWE::HavokFile>()},
+		{"packmeta", makeParser<AWE::PACKMETAFile>()},
+		{"stringtable", makeParser<AWE::StringTableFile>()},
+		{"terraindata", makeParser<AWE::TerrainDataFile>()},
+	};
+
+	std::vector<std::string> formats;
+	for (const auto &[format, parser] : parsers)
+		formats.emplace_back(format);
+
+	std::string format;
+	std::vector<std::string> files;
+	unsigned int iterations = 10;
+
+	app.add_option("format", format, "The format of the given files")
+			->check(CLI::IsMember(formats))
+			->required();
+
+	app.add_option("files", files, "The files to parse")
+			->check(CLI::ExistingFile)
+			->required();
+
+	app.add_option("-i,--iterations", iterations, "How often all files are parsed")
+			->check(CLI::PositiveNumber);
+
+	CLI11_PARSE(app, argc, argv);
+
+	const auto &parser = parsers.at(format);
+
+	const double ifstreamTime = measure<IFStreamReadFile>(files, iterations, parser);
+	const double readFileTime = measure<Common::ReadFile>(files, iterations, parser);
+
+	fmt::print("Parsed {} {} files\n", files.size(), format);
+	fmt::print("std::ifstream:    {:.2f} ms per pass\n", ifstreamTime);
+	fmt::print("Common::ReadFile: {:.2f} ms per pass\n", readFileTime);
+	fmt::print("Speedup:          {:.1f}x\n", ifstreamTime / readFileTime);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "src/common/readfile.h"
+#include "src/common/mappedfile.h"
+#include "src/common/exception.h"
+#include "src/common/strutil.h"
+
+#include "src/awe/awepackwriter.h"
+#include "src/awe/path.h"
+#include "src/awe/rmdblobarchive.h"
+#include "src/awe/rmdparchive.h"
+
+struct Resource {
+	const AWE::Archive *archive;
+	size_t index;
+	std::string path;
+};
+
+/*!
+ * Open an archive given by its bin or rmdtoc file. The rmdp file of a bin
+ * file is expected next to it, the blob files of a rmdtoc file in the same
+ * directory.
+ */
+static std::unique_ptr<AWE::Archive> openArchive(const std::filesystem::path &file) {
+	const std::string extension = Common::toLower(file.extension().string());
+
+	if (extension == ".bin") {
+		auto rmdpFile = file;
+		rmdpFile.replace_extension(".rmdp");
+		return std::make_unique<AWE::RMDPArchive>(
+			new Common::MappedFile(file.string()),
+			new Common::MappedFile(rmdpFile.string())
+		);
+	}
+
+	if (extension == ".rmdtoc") {
+		Common::ReadFile rmdtoc(file.string());
+		return std::make_unique<AWE::RMDBlobArchive>(rmdtoc, file.parent_path().string());
+	}
+
+	throw Common::Exception("Unsupported archive {}, expected a .bin or .rmdtoc file", file.string());
+}
+
+/*!
+ * Read the paths of a resource trace written by the resource manager, in the
+ * order they were loaded
+ */
+static std::vector<std::string> readTrace(const std::string &traceFile) {
+	std::ifstream in(traceFile);
+	if (!in)
+		throw Common::Exception("Failed to open resource trace {}", traceFile);
+
+	std::vector<std::string> paths;
+	std::string line;
+	while (std::getline(in, line)) {
+		std::istringstream entryStream(line);
+		size_t offset, size;
+		std::string path;
+		entryStream >> offset >> size >> std::ws;
+		std::getline(entryStream, path);
+		if (entryStream && !path.empty())
+			paths.emplace_back(path);
+	}
+
+	return paths;
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Repack bin/rmdp and rmdtoc/rmdblob archives into an OpenAWE pack", "repack");
+
+	std::string outputFile;
+	std::vector<std::string> archiveFiles, traceFiles;
+	std::string pathPrefix;
+	uint32_t pageSize = 4096;
+	bool compress = false;
+
+	app.add_option("output", outputFile, "The pack file to create")
+			->required();
+
+	app.add_option("archives", archiveFiles, "The .bin or .rmdtoc files of the archives to repack, earlier archives take precedence")
+			->check(CLI::ExistingFile)
+			->required();
+
+	app.add_option("-t,--trace", traceFiles, "Resource traces recorded by the game, which define the load order")
+			->check(CLI::ExistingFile);
+
+	app.add_option("-p,--path-prefix", pathPrefix, "The path prefix the game used when recording the traces, like d:/data/");
+	app.add_option("-s,--page-size", pageSize, "The alignment of every resource in the pack")
+			->check(CLI::PositiveNumber);
+	app.add_flag("-c,--compress", compress, "Compress resources with lz4 if that makes them smaller");
+
+	CLI11_PARSE(app, argc, argv);
+
+	std::vector<std::unique_ptr<AWE::Archive>> archives;
+	for (const auto &archiveFile : archiveFiles) {
+		fmt::print("Indexing {}\n", archiveFile);
+		archives.emplace_back(openArchive(archiveFile));
+	}
+
+	// Collect all resources, resources of earlier archives take precedence like in the resource manager
+	std::vector<Resource> resources;
+	std::unordered_map<std::string, size_t> resourceIndices;
+	for (const auto &archive : archives) {
+		std::vector<size_t> indices(archive->getNumResources());
+		for (size_t i = 0; i < indices.size(); ++i)
+			indices[i] = i;
+
+		// Keep the original storage order for resources, which are not part of any trace
+		std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+			const auto rangeA = archive->getResourceRange(a);
+			const auto rangeB = archive->getResourceRange(b);
+			return rangeA && rangeB && rangeA->offset < rangeB->offset;
+		});
+
+		for (const auto index : indices) {
+			std::string path = Common::toLower(archive->getResourcePath(index));
+			if (resourceIndices.emplace(path, resources.size()).second)
+				resources.emplace_back(Resource{archive.get(), index, std::move(path)});
+		}
+	}
+
+	// Resources are written in the order of the traces first, then in their original order
+	std::vector<size_t> order;
+	std::vector<bool> ordered(resources.size(), false);
+	size_t missingTraceEntries = 0;
+	for (const auto &traceFile : traceFiles) {
+		for (const auto &path : readTrace(traceFile)) {
+			const auto resource = resourceIndices.find(pathPrefix + AWE::getNormalizedPath(path));
+			if (resource == resourceIndices.end()) {
+				missingTraceEntries++;
+				continue;
+			}
+
+			if (!ordered[resource->second]) {
+				ordered[resource->second] = true;
+				order.emplace_back(resource->second);
+			}
+		}
+	}
+
+	const size_t tracedResources = order.size();
+	for (size_t i = 0; i < resources.size(); ++i) {
+		if (!ordered[i])
+			order.emplace_back(i);
+	}
+
+	if (missingTraceEntries > 0)
+		fmt::print("Skipping {} trace entries not contained in the archives\n", missingTraceEntries);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	AWE::AWEPackWriter writer(outputFile, pageSize);
+	std::vector<byte> buffer;
+	size_t inputSize = 0;
+	for (size_t i = 0; i < order.size(); ++i) {
+		const auto &resource = resources[order[i]];
+
+		fmt::print("{}/{} {}\n", i + 1, order.size(), resource.path);
+
+		std::unique_ptr<Common::ReadStream> stream(resource.archive->getResourceByIndex(resource.index));
+		if (!stream)
+			throw Common::Exception("Failed to read resource {}", resource.path);
+
+		std::span<const byte> data = stream->getView(0, stream->size());
+		if (data.empty() && stream->size() > 0) {
+			buffer.resize(stream->size());
+			if (stream->readAt(0, buffer.data(), buffer.size()) != buffer.size())
+				throw Common::Exception("Failed to read resource {}", resource.path);
+			data = buffer;
+		}
+
+		writer.add(resource.path, data, compress);
+		inputSize += data.size();
+	}
+	writer.finish();
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	fmt::print(
+		"Packed {} resources ({} from traces), {:.1f} MiB into {:.1f} MiB in {:.1f}s\n",
+		order.size(),
+		tracedResources,
+		static_cast<double>(inputSize) / (1024.0 * 1024.0),
+		static_cast<double>(writer.getSize()) / (1024.0 * 1024.0),
+		elapsed.count()
+	);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "src/common/mappedfile.h"
+#include "src/common/readfile.h"
+#include "src/common/crc32.h"
+#include "src/common/exception.h"
+#include "src/common/strutil.h"
+
+#include "src/awe/rmdparchive.h"
+
+template<typename F>
+static double measure(const std::vector<std::string> &paths, unsigned int iterations, F lookup) {
+	size_t found = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < iterations; ++i) {
+		for (const auto &path : paths) {
+			if (lookup(path))
+				found++;
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	if (found != paths.size() * iterations)
+		throw Common::Exception("Only {} of {} lookups succeeded", found, paths.size() * iterations);
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(found);
+}
+
+/*!
+ * Read the resources of the archive concurrently from a doubling number of
+ * threads, verify them against the checksums of a sequential read and print
+ * the throughput for every number of threads
+ */
+static void measureReads(const AWE::RMDPArchive &rmdp, const std::vector<std::string> &paths, unsigned int maxThreads, unsigned int iterations) {
+	std::vector<uint32_t> checksums;
+	for (const auto &path : paths) {
+		std::unique_ptr<Common::ReadStream> stream(rmdp.getResource(path));
+		if (!stream)
+			throw Common::Exception("Failed to read {}", path);
+
+		std::vector<byte> data(stream->size());
+		stream->read(data.data(), data.size());
+		checksums.emplace_back(Common::crc32(data.data(), data.size()));
+	}
+
+	for (unsigned int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+		std::atomic_uint failures(0);
+		std::atomic_size_t bytesRead(0);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < numThreads; ++t) {
+			threads.emplace_back([&, t]() {
+				for (unsigned int i = 0; i < iterations; ++i) {
+					const size_t index = (i + t) % paths.size();
+					std::unique_ptr<Common::ReadStream> stream(rmdp.getResource(paths[index]));
+					if (!stream) {
+						failures++;
+						continue;
+					}
+
+					std::vector<byte> data(stream->size());
+					stream->read(data.data(), data.size());
+					if (Common::crc32(data.data(), data.size()) != checksums[index])
+						failures++;
+
+					bytesRead += data.size();
+				}
+			});
+		}
+
+		for (auto &thread : threads)
+			thread.join();
+
+		const auto end = std::chrono::steady_clock::now();
+		const auto seconds = std::chrono::duration<double>(end - start).count();
+
+		if (failures > 0)
+			throw Common::Exception("{} of {} concurrent reads failed", failures.load(), numThreads * iterations);
+
+		fmt::print(
+			"{} threads: {:.0f} resources/s, {:.2f} MiB/s\n",
+			numThreads,
+			numThreads * iterations / seconds,
+			bytesRead.load() / seconds / (1024.0 * 1024.0)
+		);
+	}
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Benchmark path lookups in bin/rmdp archive structures", "rmdpbench");
+
+	std::string binFile, rmdpFile;
+	unsigned int iterations = 10;
+	unsigned int reads = 0;
+	unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+	app.add_option("binfile", binFile, "The bin file containing the archives metadata")
+			->check(CLI::ExistingFile)
+			->required();
+
+	app.add_option("rmdpfile", rmdpFile, "The rmdp file containing the archives raw data")
+			->check(CLI::ExistingFile)
+			->required();
+
+	app.add_option("-i,--iterations", iterations, "How often the whole file list is looked up")
+			->check(CLI::PositiveNumber);
+
+	app.add_option("-r,--reads", reads, "How many resources every thread reads in the concurrent read benchmark, 0 to skip it");
+
+	app.add_option("-t,--threads", maxThreads, "The maximum number of threads for the concurrent read benchmark")
+			->check(CLI::PositiveNumber);
+
+	CLI11_PARSE(app, argc, argv);
+
+	const auto indexStart = std::chrono::steady_clock::now();
+	AWE::RMDPArchive rmdp(
+		new Common::MappedFile(binFile),
+		new Common::MappedFile(rmdpFile)
+	);
+	const auto indexEnd = std::chrono::steady_clock::now();
+
+	std::vector<std::string> paths(rmdp.getNumResources());
+	for (size_t i = 0; i < rmdp.getNumResources(); ++i) {
+		paths[i] = Common::toLower(rmdp.getResourcePath(i));
+
+		if (rmdp.findResource(paths[i]) != rmdp.findResourceInTree(paths[i]))
+			throw Common::Exception("Path index and folder tree disagree on {}", paths[i]);
+	}
+
+	fmt::print(
+		"Loaded {} resources in {} ms\n",
+		paths.size(),
+		std::chrono::duration_cast<std::chrono::milliseconds>(indexEnd - indexStart).count()
+	);
+
+	const double treeTime = measure(paths, iterations, [&](const std::string &path) {
+		return rmdp.findResourceInTree(path).has_value();
+	});
+	const double indexTime = measure(paths, iterations, [&](const std::string &path) {
+		return rmdp.findResource(path).has_value();
+	});
+
+	fmt::print("Folder tree: {:.1f} ns per lookup\n", treeTime);
+	fmt::print("Path index:  {:.1f} ns per lookup\n", indexTime);
+	fmt::print("Speedup:     {:.1f}x\n", treeTime / indexTime);
+
+	if (reads > 0 && !paths.empty()) {
+		// Read through a file instead of the mapping to measure concurrent positional reads
+		AWE::RMDPArchive rmdpFromFile(
+			new Common::MappedFile(binFile),
+			new Common::ReadFile(rmdpFile)
+		);
+		measureReads(rmdpFromFile, paths, maxThreads, reads);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <chrono>
+#include <charconv>
+#include <regex>
+#include <vector>
+#include <string>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "src/common/crc32.h"
+#include "src/common/exception.h"
+#include "src/common/strutil.h"
+
+/*!
+ * Measure the average time of an operation over all inputs. The results of
+ * the operation are summed up into a checksum, so that the compiler can't
+ * remove the operation and the results of both variants can be compared.
+ */
+template<typename F>
+static double measure(const std::vector<std::string> &inputs, unsigned int iterations, uint64_t &checksum, F operation) {
+	checksum = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < iterations; ++i) {
+		for (const auto &input : inputs)
+			checksum += operation(input);
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(inputs.size() * iterations);
+}
+
+static void printResult(
+	const std::string &name,
+	double regexTime,
+	double tokenizerTime,
+	uint64_t regexChecksum,
+	uint64_t tokenizerChecksum
+) {
+	if (regexChecksum != tokenizerChecksum)
+		throw Common::Exception("{}: The results of both variants differ", name);
+
+	fmt::print("{}\n", name);
+	fmt::print("  std::regex:        {:.1f} ns per call\n", regexTime);
+	fmt::print("  Common::Tokenizer: {:.1f} ns per call\n", tokenizerTime);
+	fmt::print("  Speedup:           {:.1f}x\n", regexTime / tokenizerTime);
+}
+
+int main(int argc, char** argv) {
+	CLI::App app("Benchmark the regex free string utilities against their regex based predecessors", "tokenizerbench");
+
+	unsigned int numInputs = 10000;
+	unsigned int iterations = 10;
+
+	app.add_option("-n,--inputs", numInputs, "How many synthetic inputs are generated")
+			->check(CLI::PositiveNumber);
+
+	app.add_option("-i,--iterations", iterations, "How often all inputs are processed")
+			->check(CLI::PositiveNumber);
+
+	CLI11_PARSE(app, argc, argv);
+
+	// Generate paths and gid registry lines similar to the ones found in the game data
+	std::vector<std::string> paths, rawPaths, gidLines;
+	for (unsigned int i = 0; i < numInputs; ++i) {
+		const std::string path = fmt::format(
+			"data/environment/episode{}/objects/object_{:05}/lod{}/mesh_{:x}.binfbx",
+			i % 6,
+			i,
+			i % 3,
+			i * 2654435761u
+		);
+		paths.emplace_back(path);
+		rawPaths.emplace_back(Common::replace(path, "/", "\\"));
+		gidLines.emplace_back(fmt::format("{},{:08x},object_{}", i % 16, i * 2654435761u, i));
+	}
+
+	uint64_t splitRegexChecksum, splitTokenizerChecksum;
+	uint64_t normalizeRegexChecksum, normalizeTokenizerChecksum;
+	uint64_t gidRegexChecksum, gidTokenizerChecksum;
+
+	// Splitting a path into hashed parts like RMDPArchive::getPathHashes
+	const double splitRegex = measure(paths, iterations, splitRegexChecksum, [](const std::string &path) {
+		uint64_t hashes = 0;
+		for (const auto &part : Common::split(path, std::regex("/")))
+			hashes += Common::crc32(part);
+		return hashes;
+	});
+	const double splitTokenizer = measure(paths, iterations, splitTokenizerChecksum, [](const std::string &path) {
+		uint64_t hashes = 0;
+		for (const auto part : Common::Tokenizer(path, '/'))
+			hashes += Common::crc32(part);
+		return hashes;
+	});
+	printResult("Path hashing", splitRegex, splitTokenizer, splitRegexChecksum, splitTokenizerChecksum);
+
+	// Normalizing a path like StreamedResourceFile
+	const double normalizeRegex = measure(rawPaths, iterations, normalizeRegexChecksum, [](const std::string &rawPath) {
+		std::string path = std::regex_replace(rawPath, std::regex("\\\\"), "/");
+		path = std::regex_replace(path, std::regex("data/"), "");
+		return path.size();
+	});
+	const double normalizeTokenizer = measure(rawPaths, iterations, normalizeTokenizerChecksum, [](const std::string &rawPath) {
+		std::string path = rawPath;
+		Common::foldSlashes(path);
+		Common::replaceInPlace(path, "data/", "");
+		return path.size();
+	});
+	printResult(
+		"Path normalization",
+		normalizeRegex,
+		normalizeTokenizer,
+		normalizeRegexChecksum,
+		normalizeTokenizerChecksum
+	);
+
+	// Parsing a line like GIDRegistryFile
+	const double gidRegex = measure(gidLines, iterations, gidRegexChecksum, [](const std::string &line) {
+		const std::vector<std::string> split = Common::split(line, std::regex(","));
+		const uint32_t type = std::stoi(split[0]);
+		const uint32_t id = std::stoul(Common::toLower(split[1]), nullptr, 16);
+		return type + id + split[2].size();
+	});
+	const double gidTokenizer = measure(gidLines, iterations, gidTokenizerChecksum, [](const std::string &line) {
+		std::string_view fields[3];
+		size_t numFields = 0;
+		for (const auto field : Common::Tokenizer(line, ',')) {
+			if (numFields == 3)
+				break;
+			fields[numFields++] = field;
+		}
+
+		uint32_t type = 0, id = 0;
+		std::from_chars(fields[0].data(), fields[0].data() + fields[0].size(), type);
+		std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), id, 16);
+		return type + id + fields[2].size();
+	});
+	printResult("GID registry line parsing", gidRegex, gidTokenizer, gidRegexChecksum, gidTokenizerChecksum);
+
+	return EXIT_SUCCESS;
+}
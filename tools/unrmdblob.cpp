@@ -4,46 +4,36 @@
 
 #include <cstdlib>
 
-#include <filesystem>
-
 #include <fmt/format.h>
 #include <CLI/CLI.hpp>
 
-#include "src/common/readfile.h"
-#include "src/common/writefile.h"
+#include "src/common/exception.h"
 
 #include "src/awe/rmdblobarchive.h"
 
+#include "tools/extract.h"
+
 int main(int argc, char** argv) {
 	CLI::App app("Unpack rmdblob/rmdtoc archive structure", "unrmdblob");
 
 	std::string rmdtocFile;
+	std::string tocCacheFile;
+	bool verifyTocCache = false;
+	unsigned int jobs = 1;
 
 	app.add_option("rmdtoc", rmdtocFile, "The rmdtoc file containing the archives metadata")
 			->check(CLI::ExistingFile)
 			->required();
+	app.add_option("-c,--toc-cache", tocCacheFile, "Cache the parsed table of contents in this file to speed up repeated runs");
+	app.add_flag("--verify-toc-cache", verifyTocCache, "Also check the hash of the rmdtoc file before using the toc cache");
+	app.add_option("-j,--jobs", jobs, "The number of files to extract in parallel")
+			->check(CLI::PositiveNumber);
 
 	CLI11_PARSE(app, argc, argv);
 
-	Common::ReadFile rmdtoc(rmdtocFile);
-
-	AWE::RMDBlobArchive rmdblob(rmdtoc, std::filesystem::path(rmdtocFile).parent_path().string());
-
-	for (size_t i = 0; i < rmdblob.getNumResources(); ++i) {
-		const std::string path = rmdblob.getResourcePath(i);
-
-		fmt::print("{}/{} {}\n", i + 1, rmdblob.getNumResources(), path);
-
-		const auto resourceStream = std::unique_ptr<Common::ReadStream>(rmdblob.getResource(path));
-
-		std::filesystem::path p(path);
-		if (!p.parent_path().empty())
-			std::filesystem::create_directories(p.parent_path());
+	AWE::RMDBlobArchive rmdblob(rmdtocFile, tocCacheFile, verifyTocCache);
 
-		Common::WriteFile writeFile(p.string());
-		writeFile.writeStream(resourceStream.get());
-		writeFile.close();
-	}
+	Tools::extractArchive(rmdblob, jobs);
 
 	return EXIT_SUCCESS;
 }
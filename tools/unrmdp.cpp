@@ -26,18 +26,21 @@
 #include <CLI/CLI.hpp>
 
 #include "src/common/readfile.h"
-#include "src/common/writefile.h"
 #include "src/common/exception.h"
 #include "src/common/strutil.h"
 
 #include "src/awe/rmdparchive.h"
 #include "src/awe/path.h"
 
+#include "tools/extract.h"
+
 int main(int argc, char** argv) {
 	CLI::App app("Unpack bin/rmdp archive structure", "unrmdp");
 
 	std::string binFile, rmdpFile;
 	bool onlyListFiles = false;
+	bool verify = false;
+	unsigned int jobs = 1;
 
 	app.add_option("binfile", binFile, "The bin file containing the archives metadata")
 			->check(CLI::ExistingFile)
@@ -48,6 +51,9 @@ int main(int argc, char** argv) {
 			->required();
 
 	app.add_flag("-l, --list", onlyListFiles, "List files in an archive without actually extracting them");
+	app.add_flag("-v, --verify", verify, "Verify the checksums of the extracted files");
+	app.add_option("-j, --jobs", jobs, "The number of files to extract in parallel")
+			->check(CLI::PositiveNumber);
 
 	CLI11_PARSE(app, argc, argv);
 
@@ -57,27 +63,20 @@ int main(int argc, char** argv) {
 		new Common::ReadFile(binFile),
 		new Common::ReadFile(rmdpFile)
 	);
+	rmdp.setVerifyData(verify);
 
-	for (size_t i = 0; i < rmdp.getNumResources(); ++i) {
-		const std::string path = rmdp.getResourcePath(i);
-		const std::string extractPath = AWE::removeDrivePrefix(path);
-
-		fmt::print("{}/{} {} --> {}\n", i + 1, rmdp.getNumResources(), path, extractPath);
-
-		if (!onlyListFiles) {
-			const auto resourceStream = std::unique_ptr<Common::ReadStream>(rmdp.getResource(Common::toLower(path)));
-			if (!resourceStream)
-				throw Common::Exception("Resource not found in archive: {}", path);
+	const size_t numResources = rmdp.getNumResources();
 
-			std::filesystem::path p(extractPath);
-			if (!p.parent_path().empty())
-				std::filesystem::create_directories(p.parent_path());
-
-			Common::WriteFile writeFile(p.string());
-			writeFile.writeStream(resourceStream.get());
-			writeFile.close();
+	if (onlyListFiles) {
+		for (size_t i = 0; i < numResources; ++i) {
+			const std::string path = rmdp.getResourcePath(i);
+			fmt::print("{}/{} {} --> {}\n", i + 1, numResources, path, AWE::removeDrivePrefix(path));
 		}
+
+		return EXIT_SUCCESS;
 	}
 
+	Tools::extractArchive(rmdp, jobs, AWE::removeDrivePrefix);
+
 	return EXIT_SUCCESS;
 }